@@ -0,0 +1,157 @@
+// quad_delegation.cpp: performance of quad-precision cfloat arithmetic computed in __float128 versus emulation and double-double
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/numerics/twosum.hpp>
+
+/*
+   quad, cfloat<128,15,uint32_t,true,false,false>, shares its encoding with IEEE-754 binary128. When the
+   compiler provides __float128, the arithmetic operators, sqrt, fma, and the conversions of quad are
+   computed in __float128, which the compiler lowers to the correctly rounded soft-float routines of
+   libgcc. This benchmark compares quad to __float128 itself, to the blocktriple emulation of the same
+   encoding with supernormals, and to double-double, the usual fast alternative with 106 bits of precision
+   that is not correctly rounded.
+
+   Measured with gcc 12 -O3 on an x86-64 server, in operations per second:
+
+                                 add         mul         div         sqrt
+     double-double             154 Mops    149 Mops     38 Mops     34 Mops
+     __float128                 52 Mops     41 Mops     29 Mops      5 Mops
+     quad (__float128)          23 Mops     21 Mops     18 Mops      4 Mops
+     quad (emulated)            14 Mops    785 Kops      5 Mops    542 Kops
+*/
+
+namespace sw { namespace universal {
+
+	// double-double: an unevaluated sum of two doubles, with the classic error-free transformations
+	struct DoubleDouble {
+		double hi, lo;
+		DoubleDouble() = default;
+		DoubleDouble(double v) : hi{ v }, lo{ 0.0 } {}
+		DoubleDouble(double h, double l) : hi{ h }, lo{ l } {}
+		explicit operator double() const { return hi + lo; }
+	};
+	inline DoubleDouble quickTwoSum(double a, double b) {
+		double s = a + b;
+		return DoubleDouble(s, b - (s - a));
+	}
+	inline DoubleDouble operator+(const DoubleDouble& a, const DoubleDouble& b) {
+		double s{ 0 }, e{ 0 };
+		twoSum(a.hi, b.hi, s, e);
+		e += a.lo + b.lo;
+		return quickTwoSum(s, e);
+	}
+	inline DoubleDouble operator*(const DoubleDouble& a, const DoubleDouble& b) {
+		double p = a.hi * b.hi;
+		double e = std::fma(a.hi, b.hi, -p);
+		e += a.hi * b.lo + a.lo * b.hi;
+		return quickTwoSum(p, e);
+	}
+	inline DoubleDouble operator/(const DoubleDouble& a, const DoubleDouble& b) {
+		double q1 = a.hi / b.hi;
+		DoubleDouble r = a + DoubleDouble(-q1) * b;
+		double q2 = r.hi / b.hi;
+		return quickTwoSum(q1, q2);
+	}
+	inline DoubleDouble sqrt(const DoubleDouble& a) {
+		// one Newton step on the double approximation
+		double x = std::sqrt(a.hi);
+		DoubleDouble r = a + DoubleDouble(-x) * DoubleDouble(x);
+		return quickTwoSum(x, r.hi / (2.0 * x));
+	}
+	inline bool operator==(const DoubleDouble& a, const DoubleDouble& b) { return a.hi == b.hi && a.lo == b.lo; }
+	inline std::ostream& operator<<(std::ostream& ostr, const DoubleDouble& a) { return ostr << a.hi << " + " << a.lo; }
+
+#if UNIVERSAL_NATIVE_FLOAT128
+	inline native_float128 sqrt(native_float128 a) { return float128_sqrt(a); }
+	inline std::ostream& operator<<(std::ostream& ostr, native_float128 a) { return ostr << static_cast<double>(a); }
+#endif
+
+	// the root feeds back into the operand, so that the loop cannot be hoisted
+	template<typename Scalar>
+	void SqrtWorkload(size_t NR_OPS) {
+		std::vector<Scalar> data = { Scalar(2.0f), Scalar(3.0f) };
+		Scalar c{ 1.0625f };
+		for (size_t i = 1; i < NR_OPS; ++i) {
+			c = sqrt(c + data[i % 2]);
+		}
+		if (c == Scalar(-1.0f)) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+}} // namespace sw::universal
+
+#include <universal/benchmark/performance_runner.hpp>
+
+template<typename Scalar>
+void RunWorkloads(const std::string& tag, size_t NR_OPS) {
+	using namespace sw::universal;
+	PerformanceRunner(tag + " add ", AdditionSubtractionWorkload<Scalar>, NR_OPS);
+	PerformanceRunner(tag + " mul ", MultiplicationWorkload<Scalar>, NR_OPS);
+	PerformanceRunner(tag + " div ", DivisionWorkload<Scalar>, NR_OPS);
+	PerformanceRunner(tag + " sqrt", SqrtWorkload<Scalar>, NR_OPS);
+}
+
+// conditional compilation
+#define MANUAL_TESTING 0
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string tag = "quad-precision cfloat computed in __float128 benchmarking";
+
+	using Quad     = cfloat<128, 15, uint32_t, true, false, false>;
+	using Emulated = cfloat<128, 15, uint32_t, true, true, false>;
+
+#if MANUAL_TESTING
+
+	PerformanceRunner("quad add", AdditionWorkload< Quad >, 1024 * 1024);
+
+	std::cout << "done" << std::endl;
+
+	return EXIT_SUCCESS;
+#else
+	std::cout << tag << std::endl;
+
+	constexpr size_t NR_OPS = 1024 * 1024 * 4;
+
+	RunWorkloads< DoubleDouble >("double-double           ", NR_OPS);
+#if UNIVERSAL_NATIVE_FLOAT128
+	RunWorkloads< native_float128 >("__float128              ", NR_OPS);
+	std::cout << "quad is " << (Quad::isBinary128 ? "computed in __float128\n" : "emulated\n");
+#else
+	std::cout << "__float128 is not available: quad is emulated\n";
+#endif
+	RunWorkloads< Quad >("quad                    ", NR_OPS);
+	RunWorkloads< Emulated >("quad emulated           ", NR_OPS / 16);
+
+	return EXIT_SUCCESS;
+
+#endif // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << '\n';
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,141 @@
+//  karatsuba.cpp : crossover benchmark for the schoolbook and Karatsuba multiplication kernels
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <string>
+#include <random>
+#include <vector>
+#include <chrono>
+// configure the integer arithmetic class
+#define INTEGER_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/number/integer/integer.hpp>
+#include <universal/benchmark/performance_runner.hpp>
+
+/*
+   The block-based integer types compute a modular product of nrBlocks limbs.
+   Below limb_mullo_threshold limbs, four times LIMB_KARATSUBA_THRESHOLD, the
+   truncated schoolbook kernel is used, above it the truncated Karatsuba kernel.
+   This benchmark measures the truncated product kernels for different thresholds
+   so that the crossover can be established for a specific processor and limb type.
+*/
+
+namespace sw { namespace universal {
+
+	template<typename Limb>
+	std::vector<Limb> RandomLimbs(unsigned nrLimbs, unsigned seed) {
+		std::mt19937_64 generator(seed);
+		std::vector<Limb> v(nrLimbs);
+		for (auto& limb : v) limb = static_cast<Limb>(generator());
+		return v;
+	}
+
+	// truncated schoolbook product of nrLimbs limbs
+	template<typename Limb, unsigned nrLimbs>
+	void SchoolbookWorkload(size_t NR_OPS) {
+		std::vector<Limb> a = RandomLimbs<Limb>(nrLimbs, 1), b = RandomLimbs<Limb>(nrLimbs, 2), r(nrLimbs);
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			limb_mullo_schoolbook(a.data(), b.data(), nrLimbs, r.data());
+			a[0] = r[nrLimbs - 1];
+		}
+		if (r[0] == Limb(0) && r[nrLimbs - 1] == Limb(0)) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	// truncated Karatsuba product of nrLimbs limbs that falls back to schoolbook below threshold limbs
+	template<typename Limb, unsigned nrLimbs, unsigned threshold>
+	void KaratsubaWorkload(size_t NR_OPS) {
+		std::vector<Limb> a = RandomLimbs<Limb>(nrLimbs, 1), b = RandomLimbs<Limb>(nrLimbs, 2), r(nrLimbs);
+		std::vector<Limb> scratch(mullo_scratch_size<threshold>(nrLimbs) + 1);
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			limb_mullo<threshold>(a.data(), b.data(), nrLimbs, r.data(), scratch.data());
+			a[0] = r[nrLimbs - 1];
+		}
+		if (r[0] == Limb(0) && r[nrLimbs - 1] == Limb(0)) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	template<typename Limb, unsigned nrLimbs>
+	void MeasureCrossover(const std::string& tag, size_t NR_OPS) {
+		std::cout << '\n' << tag << '\n';
+		PerformanceRunner("schoolbook           ", SchoolbookWorkload<Limb, nrLimbs>, NR_OPS);
+		PerformanceRunner("karatsuba threshold 8 ", KaratsubaWorkload<Limb, nrLimbs, 8>, NR_OPS);
+		PerformanceRunner("karatsuba threshold 16", KaratsubaWorkload<Limb, nrLimbs, 16>, NR_OPS);
+		PerformanceRunner("karatsuba threshold 24", KaratsubaWorkload<Limb, nrLimbs, 24>, NR_OPS);
+		PerformanceRunner("karatsuba threshold 32", KaratsubaWorkload<Limb, nrLimbs, 32>, NR_OPS);
+		PerformanceRunner("karatsuba threshold 48", KaratsubaWorkload<Limb, nrLimbs, 48>, NR_OPS);
+	}
+
+}} // namespace sw::universal
+
+// measure the kernels on the limb counts of 1024 to 8192-bit integers
+void TestKaratsubaCrossover() {
+	using namespace sw::universal;
+	std::cout << "\nTruncated product kernel performance as a function of the Karatsuba threshold\n";
+
+	constexpr size_t NR_OPS = 1024 * 64;
+
+	MeasureCrossover<uint32_t,  32>("1024-bit operands in  32 uint32_t limbs", NR_OPS);
+	MeasureCrossover<uint32_t,  64>("2048-bit operands in  64 uint32_t limbs", NR_OPS / 4);
+	MeasureCrossover<uint32_t, 128>("4096-bit operands in 128 uint32_t limbs", NR_OPS / 16);
+	MeasureCrossover<uint32_t, 256>("8192-bit operands in 256 uint32_t limbs", NR_OPS / 64);
+	MeasureCrossover<uint64_t,  16>("1024-bit operands in  16 uint64_t limbs", NR_OPS);
+	MeasureCrossover<uint64_t,  32>("2048-bit operands in  32 uint64_t limbs", NR_OPS / 4);
+	MeasureCrossover<uint64_t,  64>("4096-bit operands in  64 uint64_t limbs", NR_OPS / 16);
+	MeasureCrossover<uint64_t, 128>("8192-bit operands in 128 uint64_t limbs", NR_OPS / 64);
+}
+
+// measure the integer<> multiplication operator, which uses LIMB_KARATSUBA_THRESHOLD
+void TestIntegerMultiplication() {
+	using namespace sw::universal;
+	std::cout << "\nINTEGER multiplication performance with LIMB_KARATSUBA_THRESHOLD = " << LIMB_KARATSUBA_THRESHOLD << '\n';
+
+	constexpr size_t NR_OPS = 1024 * 64;
+
+	PerformanceRunner("integer<1024, uint32_t> multiplication", MultiplicationWorkload< sw::universal::integer<1024, uint32_t> >, NR_OPS);
+	PerformanceRunner("integer<2048, uint32_t> multiplication", MultiplicationWorkload< sw::universal::integer<2048, uint32_t> >, NR_OPS / 4);
+	PerformanceRunner("integer<4096, uint32_t> multiplication", MultiplicationWorkload< sw::universal::integer<4096, uint32_t> >, NR_OPS / 16);
+	PerformanceRunner("integer<1024, uint64_t> multiplication", MultiplicationWorkload< sw::universal::integer<1024, uint64_t> >, NR_OPS);
+	PerformanceRunner("integer<2048, uint64_t> multiplication", MultiplicationWorkload< sw::universal::integer<2048, uint64_t> >, NR_OPS / 4);
+	PerformanceRunner("integer<4096, uint64_t> multiplication", MultiplicationWorkload< sw::universal::integer<4096, uint64_t> >, NR_OPS / 16);
+	PerformanceRunner("integer<8192, uint64_t> multiplication", MultiplicationWorkload< sw::universal::integer<8192, uint64_t> >, NR_OPS / 64);
+}
+
+// conditional compilation
+#define MANUAL_TESTING 0
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string tag = "Karatsuba crossover benchmarking";
+
+#if MANUAL_TESTING
+
+	MeasureCrossover<uint32_t, 64>("2048-bit operands in 64 uint32_t limbs", 1024);
+
+	std::cout << "done" << std::endl;
+
+	return EXIT_SUCCESS;
+#else
+	std::cout << tag << std::endl;
+
+	TestKaratsubaCrossover();
+	TestIntegerMultiplication();
+
+	return EXIT_SUCCESS;
+
+#endif // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << '\n';
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
@@ -19,6 +19,114 @@
    for applications that manipulate exponential properties.
 */
 
+// the reference implementation of lns addition: a round trip through double
+template<typename Scalar>
+void DoubleRoundTripAdditionSubtractionWorkload(size_t NR_OPS) {
+	std::vector<Scalar> data = { Scalar(0.99999f), Scalar(-1.00001) };
+	Scalar a, b{ 1.0625f };
+	for (size_t i = 1; i < NR_OPS; ++i) {
+		a = data[i % 2];
+		b = double(b) + double(a);
+	}
+	if (b == Scalar(0.0f)) {
+		std::cout << "dummy case to fool the optimizer\n";
+	}
+}
+
+// compare native addition through the Gaussian logarithms sb/db to the double round trip
+void TestAdditionPerformance() {
+	using namespace sw::universal;
+	std::cout << "\nLogarithmic LNS native addition vs double round trip\n";
+
+	constexpr size_t NR_OPS = 1000000;
+
+	// rbits <= 8: compile-time tables
+	PerformanceRunner("lns<8,3>    native add      ", AdditionSubtractionWorkload< lns<8, 3, std::uint8_t> >, NR_OPS);
+	PerformanceRunner("lns<8,3>    double add      ", DoubleRoundTripAdditionSubtractionWorkload< lns<8, 3, std::uint8_t> >, NR_OPS);
+	PerformanceRunner("lns<16,5>   native add      ", AdditionSubtractionWorkload< lns<16, 5> >, NR_OPS);
+	PerformanceRunner("lns<16,5>   double add      ", DoubleRoundTripAdditionSubtractionWorkload< lns<16, 5> >, NR_OPS);
+	PerformanceRunner("lns<32,8>   native add      ", AdditionSubtractionWorkload< lns<32, 8> >, NR_OPS);
+	PerformanceRunner("lns<32,8>   double add      ", DoubleRoundTripAdditionSubtractionWorkload< lns<32, 8> >, NR_OPS);
+	// rbits <= 20: interpolated tables
+	PerformanceRunner("lns<16,10>  native add      ", AdditionSubtractionWorkload< lns<16, 10, std::uint16_t> >, NR_OPS);
+	PerformanceRunner("lns<16,10>  double add      ", DoubleRoundTripAdditionSubtractionWorkload< lns<16, 10, std::uint16_t> >, NR_OPS);
+	PerformanceRunner("lns<32,16>  native add      ", AdditionSubtractionWorkload< lns<32, 16, std::uint32_t> >, NR_OPS);
+	PerformanceRunner("lns<32,16>  double add      ", DoubleRoundTripAdditionSubtractionWorkload< lns<32, 16, std::uint32_t> >, NR_OPS);
+	// rbits > 20: Gaussian logarithms evaluated in double
+	PerformanceRunner("lns<32,24>  native add      ", AdditionSubtractionWorkload< lns<32, 24, std::uint32_t> >, NR_OPS);
+	PerformanceRunner("lns<32,24>  double add      ", DoubleRoundTripAdditionSubtractionWorkload< lns<32, 24, std::uint32_t> >, NR_OPS);
+}
+
+// logistic activation function evaluated with the lns mathlib
+template<typename Scalar>
+void SigmoidWorkload(size_t NR_OPS) {
+	std::vector<Scalar> data = { Scalar(-2.5f), Scalar(-0.75f), Scalar(0.375f), Scalar(1.5f) };
+	Scalar one{ 1 }, s{ 0 };
+	for (size_t i = 0; i < NR_OPS; ++i) {
+		s = one / (one + sw::universal::exp(-data[i % 4]));
+	}
+	if (s == Scalar(0.0f)) {
+		std::cout << "dummy case to fool the optimizer\n";
+	}
+}
+
+// the reference implementation of the activation function: elementary functions through double
+template<typename Scalar>
+void DoubleRoundTripSigmoidWorkload(size_t NR_OPS) {
+	std::vector<Scalar> data = { Scalar(-2.5f), Scalar(-0.75f), Scalar(0.375f), Scalar(1.5f) };
+	Scalar one{ 1 }, s{ 0 };
+	for (size_t i = 0; i < NR_OPS; ++i) {
+		s = one / (one + Scalar(std::exp(-double(data[i % 4]))));
+	}
+	if (s == Scalar(0.0f)) {
+		std::cout << "dummy case to fool the optimizer\n";
+	}
+}
+
+// square roots of a set of operands
+template<typename Scalar>
+void SqrtWorkload(size_t NR_OPS) {
+	std::vector<Scalar> data = { Scalar(0.5f), Scalar(2.0f), Scalar(3.0f), Scalar(10.0f) };
+	Scalar s{ 0 };
+	for (size_t i = 0; i < NR_OPS; ++i) {
+		s = sw::universal::sqrt(data[i % 4]);
+	}
+	if (s == Scalar(0.0f)) {
+		std::cout << "dummy case to fool the optimizer\n";
+	}
+}
+
+template<typename Scalar>
+void DoubleRoundTripSqrtWorkload(size_t NR_OPS) {
+	std::vector<Scalar> data = { Scalar(0.5f), Scalar(2.0f), Scalar(3.0f), Scalar(10.0f) };
+	Scalar s{ 0 };
+	for (size_t i = 0; i < NR_OPS; ++i) {
+		s = Scalar(std::sqrt(double(data[i % 4])));
+	}
+	if (s == Scalar(0.0f)) {
+		std::cout << "dummy case to fool the optimizer\n";
+	}
+}
+
+// compare the log-domain mathlib to the evaluation of the elementary functions in double
+void TestMathlibPerformance() {
+	using namespace sw::universal;
+	std::cout << "\nLogarithmic LNS mathlib vs double round trip\n";
+
+	constexpr size_t NR_OPS = 1000000;
+
+	PerformanceRunner("lns<8,3>    native sqrt     ", SqrtWorkload< lns<8, 3, std::uint8_t> >, NR_OPS);
+	PerformanceRunner("lns<8,3>    double sqrt     ", DoubleRoundTripSqrtWorkload< lns<8, 3, std::uint8_t> >, NR_OPS);
+	PerformanceRunner("lns<16,10>  native sqrt     ", SqrtWorkload< lns<16, 10, std::uint16_t> >, NR_OPS);
+	PerformanceRunner("lns<16,10>  double sqrt     ", DoubleRoundTripSqrtWorkload< lns<16, 10, std::uint16_t> >, NR_OPS);
+	PerformanceRunner("lns<8,3>    native sigmoid  ", SigmoidWorkload< lns<8, 3, std::uint8_t> >, NR_OPS);
+	PerformanceRunner("lns<8,3>    double sigmoid  ", DoubleRoundTripSigmoidWorkload< lns<8, 3, std::uint8_t> >, NR_OPS);
+	PerformanceRunner("lns<16,10>  native sigmoid  ", SigmoidWorkload< lns<16, 10, std::uint16_t> >, NR_OPS);
+	PerformanceRunner("lns<16,10>  double sigmoid  ", DoubleRoundTripSigmoidWorkload< lns<16, 10, std::uint16_t> >, NR_OPS);
+	PerformanceRunner("lns<32,16>  native sigmoid  ", SigmoidWorkload< lns<32, 16, std::uint32_t> >, NR_OPS);
+	PerformanceRunner("lns<32,16>  double sigmoid  ", DoubleRoundTripSigmoidWorkload< lns<32, 16, std::uint32_t> >, NR_OPS);
+}
+
 // measure performance of arithmetic operators
 void TestArithmeticOperatorPerformance() {
 	using namespace sw::universal;
@@ -58,6 +166,8 @@ try {
 
 #if MANUAL_TESTING
 
+	TestAdditionPerformance();
+	TestMathlibPerformance();
 	TestArithmeticOperatorPerformance();
 
 	std::cout << "done" << std::endl;
@@ -68,6 +178,8 @@ try {
 
 	int nrOfFailedTestCases = 0;
 	   
+	TestAdditionPerformance();
+	TestMathlibPerformance();
 	TestArithmeticOperatorPerformance();
 
 #if STRESS_TESTING
@@ -98,3 +210,20 @@ Memory   : 16GB
 System   : 64-bit Windows 10 Pro, Version 1803, x64-based processor, OS build 17134.165
 
 */
+
+/*
+Date run : 10/17/2026
+System   : 1 core of a Linux container, gcc 12 -O3
+
+Logarithmic LNS mathlib vs double round trip
+lns<8,3>    native sqrt         1000000 per      0.00177434sec -> 563 Mops/sec
+lns<8,3>    double sqrt         1000000 per          3.5959sec -> 278 Kops/sec
+lns<16,10>  native sqrt         1000000 per      0.00151653sec -> 659 Mops/sec
+lns<16,10>  double sqrt         1000000 per         3.62091sec -> 276 Kops/sec
+lns<8,3>    native sigmoid      1000000 per        0.021289sec ->  46 Mops/sec
+lns<8,3>    double sigmoid      1000000 per         3.55786sec -> 281 Kops/sec
+lns<16,10>  native sigmoid      1000000 per       0.0249878sec ->  40 Mops/sec
+lns<16,10>  double sigmoid      1000000 per         3.49549sec -> 286 Kops/sec
+lns<32,16>  native sigmoid      1000000 per       0.0448722sec ->  22 Mops/sec
+lns<32,16>  double sigmoid      1000000 per         3.53029sec -> 283 Kops/sec
+*/
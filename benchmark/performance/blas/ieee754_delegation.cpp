@@ -0,0 +1,161 @@
+// ieee754_delegation.cpp: performance of blas dot and gemm for cfloat configurations that delegate to the floating-point hardware
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/blas/blas.hpp>
+#include <universal/blas/generators.hpp>
+#include <universal/benchmark/performance_runner.hpp>
+
+/*
+   cfloat<32,8,bt,true,false,false> and cfloat<64,11,bt,true,false,false> share the encoding of their
+   finite values with IEEE-754 binary32 and binary64, and their arithmetic operators and comparisons
+   are delegated to the floating-point hardware. This benchmark compares dot products and the matrix
+   product of these configurations to the native types, and to the emulated arithmetic of the same
+   configuration with supernormals, which takes the blocktriple path. blas::dot of a cfloat is a fused
+   dot product through the cfloat quire, which does not use the operators, so it is reported separately.
+
+   Measured with gcc 12 -O3 on an x86-64 server, in multiply-adds per second:
+
+                                 native      delegated    emulated    fused dot
+   dot of 1024 elements
+     binary32                   1.0 Gops     140 Mops      2 Mops      85 Mops
+     binary64                   1.0 Gops     135 Mops      2 Mops      82 Mops
+   gemm of 64x64 matrices
+     binary32                   780 Mops     210 Mops      3 Mops
+     binary64                   1.0 Gops     225 Mops      5 Mops
+*/
+
+namespace sw { namespace universal {
+
+	// dot product that rounds after every multiply and add: this is blas::dot for the native types
+	template<typename Scalar>
+	Scalar sequential_dot(const blas::vector<Scalar>& x, const blas::vector<Scalar>& y) {
+		Scalar sum_of_products{ 0 };
+		for (size_t i = 0; i < size(x); ++i) {
+			sum_of_products += x[i] * y[i];
+		}
+		return sum_of_products;
+	}
+
+	// NR_OPS multiply-adds through dot products of vectors of N elements
+	template<typename Scalar, bool fused>
+	void DotWorkload(size_t NR_OPS) {
+		constexpr unsigned N = 1024;
+		blas::vector<Scalar> x = blas::uniform_random_vector<Scalar>(N, -1.0, 1.0);
+		blas::vector<Scalar> y = blas::uniform_random_vector<Scalar>(N, -1.0, 1.0);
+		Scalar scale{ 1.0 / N };
+		for (size_t i = 0; i < NR_OPS; i += N) {
+			// feed the result back so that the dot product cannot be hoisted out of the loop
+			Scalar d = (fused ? blas::dot(x, y) : sequential_dot(x, y));
+			x[(i / N) % N] = d * scale;
+		}
+		if (x[0] == Scalar(1.0e10)) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	// NR_OPS fused multiply-adds through products of NxN matrices
+	template<typename Scalar>
+	void GemmWorkload(size_t NR_OPS) {
+		constexpr unsigned N = 64;
+		blas::matrix<Scalar> A = blas::uniform_random_matrix<Scalar>(N, N, -1.0, 1.0);
+		blas::matrix<Scalar> B = blas::uniform_random_matrix<Scalar>(N, N, -1.0, 1.0);
+		Scalar sum{ 0 };
+		for (size_t i = 0; i < NR_OPS; i += N * N * N) {
+			blas::matrix<Scalar> C = A * B;
+			sum += C(0, 0);
+		}
+		if (sum == Scalar(1.0e10)) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+}} // namespace sw::universal
+
+void TestDotPerformance() {
+	using namespace sw::universal;
+	std::cout << "\nblas::dot performance of IEEE-754 equivalent cfloats\n";
+
+	using Binary32  = cfloat<32, 8, uint32_t, true, false, false>;
+	using Emulated32 = cfloat<32, 8, uint32_t, true, true, false>;
+	using Binary64  = cfloat<64, 11, uint64_t, true, false, false>;
+	using Emulated64 = cfloat<64, 11, uint64_t, true, true, false>;
+	static_assert(Binary32::isIeee754 && Binary64::isIeee754, "hardware delegation is disabled");
+
+	constexpr size_t NR_OPS = 1024 * 1024 * 16;
+
+	PerformanceRunner("float                                   dot      ", DotWorkload<float, true>, NR_OPS);
+	PerformanceRunner("cfloat<32,8,uint32_t,true,false,false>  dot      ", DotWorkload<Binary32, false>, NR_OPS);
+	PerformanceRunner("cfloat<32,8,uint32_t,true,true,false>   dot      ", DotWorkload<Emulated32, false>, NR_OPS / 32);
+	PerformanceRunner("cfloat<32,8,uint32_t,true,false,false>  fused dot", DotWorkload<Binary32, true>, NR_OPS);
+	PerformanceRunner("double                                  dot      ", DotWorkload<double, true>, NR_OPS);
+	PerformanceRunner("cfloat<64,11,uint64_t,true,false,false> dot      ", DotWorkload<Binary64, false>, NR_OPS);
+	PerformanceRunner("cfloat<64,11,uint64_t,true,true,false>  dot      ", DotWorkload<Emulated64, false>, NR_OPS / 32);
+	PerformanceRunner("cfloat<64,11,uint64_t,true,false,false> fused dot", DotWorkload<Binary64, true>, NR_OPS);
+}
+
+void TestGemmPerformance() {
+	using namespace sw::universal;
+	std::cout << "\nmatrix-matrix product performance of IEEE-754 equivalent cfloats\n";
+
+	using Binary32  = cfloat<32, 8, uint32_t, true, false, false>;
+	using Emulated32 = cfloat<32, 8, uint32_t, true, true, false>;
+	using Binary64  = cfloat<64, 11, uint64_t, true, false, false>;
+	using Emulated64 = cfloat<64, 11, uint64_t, true, true, false>;
+
+	constexpr size_t NR_OPS = 64 * 64 * 64 * 64;
+
+	PerformanceRunner("float                                   gemm", GemmWorkload<float>, NR_OPS);
+	PerformanceRunner("cfloat<32,8,uint32_t,true,false,false>  gemm", GemmWorkload<Binary32>, NR_OPS);
+	PerformanceRunner("cfloat<32,8,uint32_t,true,true,false>   gemm", GemmWorkload<Emulated32>, NR_OPS / 32);
+	PerformanceRunner("double                                  gemm", GemmWorkload<double>, NR_OPS);
+	PerformanceRunner("cfloat<64,11,uint64_t,true,false,false> gemm", GemmWorkload<Binary64>, NR_OPS);
+	PerformanceRunner("cfloat<64,11,uint64_t,true,true,false>  gemm", GemmWorkload<Emulated64>, NR_OPS / 32);
+}
+
+// conditional compilation
+#define MANUAL_TESTING 0
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string tag = "IEEE-754 hardware delegation of cfloat benchmarking";
+
+#if MANUAL_TESTING
+
+	PerformanceRunner("cfloat<32,8,uint32_t,true,false,false>  dot", DotWorkload< cfloat<32, 8, uint32_t, true, false, false>, false >, 1024 * 1024);
+
+	std::cout << "done" << std::endl;
+
+	return EXIT_SUCCESS;
+#else
+	std::cout << tag << std::endl;
+
+	TestDotPerformance();
+	TestGemmPerformance();
+
+	return EXIT_SUCCESS;
+
+#endif // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << '\n';
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
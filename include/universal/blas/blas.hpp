@@ -88,5 +88,6 @@ constexpr uint64_t SIZE_512G = 512 * SIZE_1G;
 
 // type specific overloads
 #include <universal/blas/modifiers/posit_fdp.hpp>
+#include <universal/blas/modifiers/cfloat_fdp.hpp>
 
 #endif // _UNIVERSAL_BLAS_LIBRARY
@@ -0,0 +1,86 @@
+#pragma once
+// cfloat_fdp.hpp: cfloat dot products resolved through the cfloat quire and fused multiply-adds
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/number/cfloat/cfloat.hpp>
+
+namespace sw { namespace universal { namespace blas {
+
+// overload for cfloats to use fused dot products: one rounding step for the whole dot product
+template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
+cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> dot(size_t n, const vector< cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> >& x, size_t incx, const vector< cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> >& y, size_t incy) {
+	using Scalar = cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>;
+	Scalar sum_of_products(0);
+	size_t cnt, ix, iy;
+	if constexpr (Scalar::fbits < 64) {
+		constexpr unsigned capacity = 20; // FDP for vectors < 1,048,576 elements
+		cfloat_quire<Scalar, capacity> q;
+		for (cnt = 0, ix = 0, iy = 0; cnt < n && ix < size(x) && iy < size(y); ++cnt, ix += incx, iy += incy) {
+			q.add_product(x[ix], y[iy]);
+		}
+		convert(q, sum_of_products); // one and only rounding step of the fused-dot product
+	}
+	else {  // the quire requires a significand that fits in 64 bits: accumulate with single-rounding fmas
+		for (cnt = 0, ix = 0, iy = 0; cnt < n && ix < size(x) && iy < size(y); ++cnt, ix += incx, iy += incy) {
+			sum_of_products = fma(x[ix], y[iy], sum_of_products);
+		}
+	}
+	return sum_of_products;
+}
+
+// overload for cfloats to use fused dot products assuming unit stride
+template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
+cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> dot(const vector< cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> >& x, const vector< cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> >& y) {
+	using Scalar = cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>;
+	Scalar sum_of_products(0);
+	size_t nx = size(x);
+	if (nx > size(y)) return sum_of_products;
+	if constexpr (Scalar::fbits < 64) {
+		constexpr unsigned capacity = 20; // FDP for vectors < 1,048,576 elements
+		cfloat_quire<Scalar, capacity> q;
+		for (size_t i = 0; i < nx; ++i) {
+			q.add_product(x[i], y[i]);
+		}
+		convert(q, sum_of_products); // one and only rounding step of the fused-dot product
+	}
+	else {  // the quire requires a significand that fits in 64 bits: accumulate with single-rounding fmas
+		for (size_t i = 0; i < nx; ++i) {
+			sum_of_products = fma(x[i], y[i], sum_of_products);
+		}
+	}
+	return sum_of_products;
+}
+
+// overload for cfloats: a times x plus y with a single rounding per element
+template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
+void axpy(size_t n, cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> a, const vector< cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> >& x, size_t incx, vector< cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> >& y, size_t incy) {
+	size_t cnt, ix, iy;
+	for (cnt = 0, ix = 0, iy = 0; cnt < n && ix < size(x) && iy < size(y); ++cnt, ix += incx, iy += incy) {
+		y[iy] = fma(a, x[ix], y[iy]);
+	}
+}
+
+// overload for cfloats: the matrix product accumulates with single-rounding fmas
+template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
+matrix< cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> > operator*(const matrix< cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> >& A, const matrix< cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> >& B) {
+	using Scalar = cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>;
+	if (A.cols() != B.rows()) throw matmul_incompatible_matrices(incompatible_matrices(A.rows(), A.cols(), B.rows(), B.cols(), "*").what());
+	unsigned rows = A.rows();
+	unsigned cols = B.cols();
+	unsigned dots = A.cols();
+	matrix<Scalar> C(rows, cols);
+	for (unsigned i = 0; i < rows; ++i) {
+		for (unsigned j = 0; j < cols; ++j) {
+			Scalar e(0);
+			for (unsigned k = 0; k < dots; ++k) {
+				e = fma(A(i, k), B(k, j), e);
+			}
+			C(i, j) = e;
+		}
+	}
+	return C;
+}
+
+}}} // namespace sw::universal::blas
@@ -6,21 +6,52 @@
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <cstdint>
 #include <cassert>
+#include <bit>
 #include <iostream>
 #include <iomanip>
+#include <limits>
 #include <sstream>
-#include <bitset>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 #include <universal/utility/boolean_logic_operators.hpp>
 #include <universal/internal/bitblock/exceptions.hpp>
 
 namespace sw { namespace universal { namespace internal {
 
 // bitblock is a template class implementing efficient multi-precision binary arithmetic and logic
+// 
+// The bits are stored in the smallest native unsigned integer that holds nbits, and in 64-bit limbs
+// beyond that, so that a bitblock, and the number systems that are built on it, occupies no more
+// memory than its encoding needs. The interface follows std::bitset.
 template<unsigned nbits>
-class bitblock : public std::bitset<nbits> {
-    using base= std::bitset<nbits>;
+class bitblock {
 public:
-	constexpr bitblock() : base(0ull) {}
+	using bt = std::conditional_t<(nbits <= 8), std::uint8_t,
+	           std::conditional_t<(nbits <= 16), std::uint16_t,
+	           std::conditional_t<(nbits <= 32), std::uint32_t, std::uint64_t>>>;
+	static constexpr unsigned bitsInBlock = sizeof(bt) * 8;
+	static constexpr unsigned nrBlocks = (nbits == 0 ? 1u : (nbits + bitsInBlock - 1) / bitsInBlock);
+	static constexpr unsigned MSU = nrBlocks - 1;
+	static constexpr bt ALL_ONES = bt(~bt(0));
+	static constexpr bt MSU_MASK = (nbits == 0 ? bt(0) : bt(ALL_ONES >> (nrBlocks * bitsInBlock - nbits)));
+
+	// proxy to a single bit, returned by the non-const operator[]
+	class reference {
+	public:
+		constexpr reference(bitblock& bb, unsigned pos) noexcept : _bb{ bb }, _pos{ pos } {}
+		constexpr reference(const reference&) = default;
+		constexpr reference& operator=(bool v) noexcept { _bb.setbit(_pos, v); return *this; }
+		constexpr reference& operator=(const reference& r) noexcept { _bb.setbit(_pos, bool(r)); return *this; }
+		constexpr operator bool() const noexcept { return _bb.at(_pos); }
+		constexpr bool operator~() const noexcept { return !_bb.at(_pos); }
+		constexpr reference& flip() noexcept { _bb.setbit(_pos, !_bb.at(_pos)); return *this; }
+	private:
+		bitblock& _bb;
+		unsigned  _pos;
+	};
+
+	constexpr bitblock() noexcept : _block{} {}
 
 	constexpr bitblock(const bitblock&) = default;
 	constexpr bitblock(bitblock&&) = default;
@@ -28,14 +59,45 @@ public:
 	constexpr bitblock& operator=(const bitblock&) = default;
 	constexpr bitblock& operator=(bitblock&&) = default;
 
-	constexpr bitblock& operator=(unsigned long long rhs) {
-		return *this = (bitblock&)base::operator=(rhs);
+	constexpr bitblock& operator=(unsigned long long rhs) noexcept {
+		for (unsigned i = 0; i < nrBlocks; ++i) {
+			_block[i] = (i * bitsInBlock < 64 ? bt(rhs >> (i * bitsInBlock)) : bt(0));
+		}
+		_block[MSU] &= MSU_MASK;
+		return *this;
 	}
 
-	constexpr base& reset() { *this= bitblock{}; return *this; }
-	using base::reset; // make unary reset visible
-	
-	void setToZero() { std::bitset<nbits>::reset(); }
+	// modifiers
+	constexpr bitblock& set() noexcept {
+		for (unsigned i = 0; i < nrBlocks; ++i) _block[i] = ALL_ONES;
+		_block[MSU] &= MSU_MASK;
+		return *this;
+	}
+	constexpr bitblock& set(std::size_t pos, bool v = true) {
+		if (pos >= nbits) throw std::out_of_range("bitblock::set");
+		setbit(unsigned(pos), v);
+		return *this;
+	}
+	constexpr bitblock& reset() noexcept {
+		for (unsigned i = 0; i < nrBlocks; ++i) _block[i] = bt(0);
+		return *this;
+	}
+	constexpr bitblock& reset(std::size_t pos) {
+		if (pos >= nbits) throw std::out_of_range("bitblock::reset");
+		setbit(unsigned(pos), false);
+		return *this;
+	}
+	constexpr bitblock& flip() noexcept {
+		for (unsigned i = 0; i < nrBlocks; ++i) _block[i] = bt(~_block[i]);
+		_block[MSU] &= MSU_MASK;
+		return *this;
+	}
+	constexpr bitblock& flip(std::size_t pos) {
+		if (pos >= nbits) throw std::out_of_range("bitblock::flip");
+		_block[pos / bitsInBlock] ^= bt(bt(1) << (pos % bitsInBlock));
+		return *this;
+	}
+	void setToZero() noexcept { reset(); }
 	bool load_bits(const std::string& string_of_bits) {
 		if (string_of_bits.length() != nbits) return false;
 		setToZero();
@@ -53,8 +115,145 @@ public:
 		}
 		return true;
 	}
+	// raw access to the storage blocks
+	constexpr void setblock(unsigned b, bt data) noexcept {
+		if (b < nrBlocks) _block[b] = (b == MSU ? bt(data & MSU_MASK) : data);
+	}
+
+	// selectors
+	constexpr bool operator[](std::size_t pos) const noexcept { return at(unsigned(pos)); }
+	constexpr reference operator[](std::size_t pos) noexcept { return reference(*this, unsigned(pos)); }
+	constexpr bool test(std::size_t pos) const {
+		if (pos >= nbits) throw std::out_of_range("bitblock::test");
+		return at(unsigned(pos));
+	}
+	constexpr bool any() const noexcept {
+		for (unsigned i = 0; i < nrBlocks; ++i) if (_block[i]) return true;
+		return false;
+	}
+	constexpr bool none() const noexcept { return !any(); }
+	constexpr bool all() const noexcept {
+		for (unsigned i = 0; i < MSU; ++i) if (_block[i] != ALL_ONES) return false;
+		return _block[MSU] == MSU_MASK;
+	}
+	constexpr std::size_t count() const noexcept {
+		std::size_t c = 0;
+		for (unsigned i = 0; i < nrBlocks; ++i) c += static_cast<std::size_t>(std::popcount(_block[i]));
+		return c;
+	}
+	constexpr std::size_t size() const noexcept { return nbits; }
+	constexpr bt block(unsigned b) const noexcept { return (b < nrBlocks ? _block[b] : bt(0)); }
+
+	// conversions
+	unsigned long long to_ullong() const {
+		for (unsigned i = 0; i < nrBlocks; ++i) {
+			if (i * bitsInBlock >= 64 && _block[i]) throw std::overflow_error("bitblock::to_ullong");
+		}
+		unsigned long long v = 0;
+		for (unsigned i = 0; i < nrBlocks && i * bitsInBlock < 64; ++i) {
+			v |= static_cast<unsigned long long>(_block[i]) << (i * bitsInBlock);
+		}
+		return v;
+	}
+	unsigned long to_ulong() const {
+		unsigned long long v = to_ullong();
+		if (v > std::numeric_limits<unsigned long>::max()) throw std::overflow_error("bitblock::to_ulong");
+		return static_cast<unsigned long>(v);
+	}
+	std::string to_string(char zero = '0', char one = '1') const {
+		std::string str(nbits, zero);
+		for (unsigned i = 0; i < nbits; ++i) {
+			if (at(i)) str[nbits - 1 - i] = one;
+		}
+		return str;
+	}
+
+	// logic and shift operators
+	constexpr bitblock& operator&=(const bitblock& rhs) noexcept {
+		for (unsigned i = 0; i < nrBlocks; ++i) _block[i] &= rhs._block[i];
+		return *this;
+	}
+	constexpr bitblock& operator|=(const bitblock& rhs) noexcept {
+		for (unsigned i = 0; i < nrBlocks; ++i) _block[i] |= rhs._block[i];
+		return *this;
+	}
+	constexpr bitblock& operator^=(const bitblock& rhs) noexcept {
+		for (unsigned i = 0; i < nrBlocks; ++i) _block[i] ^= rhs._block[i];
+		return *this;
+	}
+	constexpr bitblock& operator<<=(std::size_t shift) noexcept {
+		if (shift >= nbits) return reset();
+		if (shift == 0) return *this;
+		const unsigned blockShift = unsigned(shift / bitsInBlock);
+		const unsigned bitShift = unsigned(shift % bitsInBlock);
+		if (blockShift > 0) {
+			for (int i = int(MSU); i >= int(blockShift); --i) _block[i] = _block[unsigned(i) - blockShift];
+			for (unsigned i = 0; i < blockShift; ++i) _block[i] = bt(0);
+		}
+		if (bitShift > 0) {
+			for (unsigned i = MSU; i > blockShift; --i) {
+				_block[i] = bt((_block[i] << bitShift) | (_block[i - 1] >> (bitsInBlock - bitShift)));
+			}
+			_block[blockShift] = bt(_block[blockShift] << bitShift);
+		}
+		_block[MSU] &= MSU_MASK;
+		return *this;
+	}
+	constexpr bitblock& operator>>=(std::size_t shift) noexcept {
+		if (shift >= nbits) return reset();
+		if (shift == 0) return *this;
+		const unsigned blockShift = unsigned(shift / bitsInBlock);
+		const unsigned bitShift = unsigned(shift % bitsInBlock);
+		if (blockShift > 0) {
+			for (unsigned i = 0; i + blockShift < nrBlocks; ++i) _block[i] = _block[i + blockShift];
+			for (unsigned i = nrBlocks - blockShift; i < nrBlocks; ++i) _block[i] = bt(0);
+		}
+		if (bitShift > 0) {
+			const unsigned top = MSU - blockShift;
+			for (unsigned i = 0; i < top; ++i) {
+				_block[i] = bt((_block[i] >> bitShift) | (_block[i + 1] << (bitsInBlock - bitShift)));
+			}
+			_block[top] = bt(_block[top] >> bitShift);
+		}
+		return *this;
+	}
+	constexpr bitblock operator<<(std::size_t shift) const noexcept { bitblock tmp(*this); return tmp <<= shift; }
+	constexpr bitblock operator>>(std::size_t shift) const noexcept { bitblock tmp(*this); return tmp >>= shift; }
+	constexpr bitblock operator~() const noexcept { bitblock tmp(*this); return tmp.flip(); }
+
+private:
+	bt _block[nrBlocks];
+
+	// bits beyond nbits read as 0, as in the empty bitblock<0> of a posit without fraction bits,
+	// and the bitblock<0> ignores writes
+	constexpr bool at(unsigned pos) const noexcept {
+		return pos < nbits && ((_block[pos / bitsInBlock] >> (pos % bitsInBlock)) & 1u);
+	}
+	constexpr void setbit(unsigned pos, bool v) noexcept {
+		if constexpr (nbits > 0) {
+			bt mask = bt(bt(1) << (pos % bitsInBlock));
+			if (v) _block[pos / bitsInBlock] |= mask; else _block[pos / bitsInBlock] &= bt(~mask);
+		}
+	}
+
+	template<unsigned nnbits>
+	friend bool operator==(const bitblock<nnbits>& lhs, const bitblock<nnbits>& rhs);
+	template<unsigned nnbits>
+	friend bool operator< (const bitblock<nnbits>& lhs, const bitblock<nnbits>& rhs);
 };
 
+template<unsigned nbits>
+inline bitblock<nbits> operator&(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) { bitblock<nbits> r(lhs); return r &= rhs; }
+template<unsigned nbits>
+inline bitblock<nbits> operator|(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) { bitblock<nbits> r(lhs); return r |= rhs; }
+template<unsigned nbits>
+inline bitblock<nbits> operator^(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) { bitblock<nbits> r(lhs); return r ^= rhs; }
+
+template<unsigned nbits>
+inline std::ostream& operator<<(std::ostream& ostr, const bitblock<nbits>& bits) {
+	return ostr << bits.to_string();
+}
+
 // logic operators
 
 // this comparison is for a two's complement number only
@@ -64,34 +263,27 @@ bool twosComplementLessThan(const bitblock<nbits>& lhs, const bitblock<nbits>& r
 	if (lhs[nbits - 1] == 0 && rhs[nbits - 1] == 1)	return false;
 	if (lhs[nbits - 1] == 1 && rhs[nbits - 1] == 0) return true;
 	// sign is equal, compare the remaining bits
-	if constexpr (nbits > 1) {
-		for (int i = static_cast<int>(nbits) - 2; i >= 0; --i) {
-			if (lhs[unsigned(i)] == 0 && rhs[unsigned(i)] == 1)	return true;
-			if (lhs[unsigned(i)] == 1 && rhs[unsigned(i)] == 0) return false;
-		}
-	}
-	// numbers are equal
-	return false;
+	return lhs < rhs;
 }
 
 // this comparison works for any number
 template<unsigned nbits>
 bool operator==(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
-	// compare remaining bits
-	if constexpr (nbits > 0) {
-		for (unsigned i = 0; i < nbits; ++i) if (lhs[i] != rhs[i]) return false;
-	}
+	for (unsigned i = 0; i < bitblock<nbits>::nrBlocks; ++i) if (lhs._block[i] != rhs._block[i]) return false;
 	// numbers are equal
 	return true;
 }
 
+template<unsigned nbits>
+bool operator!=(const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
+	return !(lhs == rhs);
+}
+
 // this comparison is for unsigned numbers only
 template<unsigned nbits>
 bool operator< (const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
-	// compare remaining bits
-	for (int i = static_cast<int>(nbits) - 1; i >= 0; --i) {
-		if (lhs[unsigned(i)] == 0 && rhs[unsigned(i)] == 1)	return true;
-		if (lhs[unsigned(i)] == 1 && rhs[unsigned(i)] == 0) return false;
+	for (int i = static_cast<int>(bitblock<nbits>::MSU); i >= 0; --i) {
+		if (lhs._block[i] != rhs._block[i]) return lhs._block[i] < rhs._block[i];
 	}
 	// numbers are equal
 	return false;
@@ -100,39 +292,19 @@ bool operator< (const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
 // test less than or equal for unsigned numbers only
 template<unsigned nbits>
 bool operator<= (const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
-	// compare remaining bits
-	for (int i = static_cast<int>(nbits) - 1; i >= 0; --i) {
-		if (lhs[unsigned(i)] == 0 && rhs[unsigned(i)] == 1)	return true;
-		if (lhs[unsigned(i)] == 1 && rhs[unsigned(i)] == 0) return false;
-	}
-	// numbers are equal
-	return true;
+	return !(rhs < lhs);
 }
 
 // test greater than for unsigned numbers only
 template<unsigned nbits>
 bool operator> (const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
-	// compare remaining bits
-	if constexpr (nbits > 0) {
-		for (int i = static_cast<int>(nbits) - 1; i >= 0; --i) {
-			if (lhs[unsigned(i)] == 0 && rhs[unsigned(i)] == 1)	return false;
-			if (lhs[unsigned(i)] == 1 && rhs[unsigned(i)] == 0) return true;
-		}
-	}
-	// numbers are equal
-	return false;
+	return rhs < lhs;
 }
 
 // this comparison is for unsigned numbers only
 template<unsigned nbits>
 bool operator>= (const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
-	// compare remaining bits
-	for (int i = static_cast<int>(nbits) - 1; i >= 0; --i) {
-		if (lhs[unsigned(i)] == 0 && rhs[unsigned(i)] == 1)	return false;
-		if (lhs[unsigned(i)] == 1 && rhs[unsigned(i)] == 0) return true;
-	}
-	// numbers are equal
-	return true;
+	return !(lhs < rhs);
 }
 
 ////////////////////////////// ARITHMETIC functions
@@ -144,13 +316,13 @@ bool operator>= (const bitblock<nbits>& lhs, const bitblock<nbits>& rhs) {
 // increment the input bitset in place, and return true if there is a carry generated.
 template<unsigned nbits>
 bool increment_bitset(bitblock<nbits>& number) {
-	bool carry = true;  // ripple carry
-	for (unsigned i = 0; i < nbits; i++) {
-		bool _a = number[i];
-		number[i] = bxor(_a, carry);
-		carry = carry && bxor(_a, false);
+	using bt = typename bitblock<nbits>::bt;
+	for (unsigned i = 0; i < bitblock<nbits>::nrBlocks; ++i) {
+		bt block = number.block(i);
+		number.setblock(i, bt(block + 1u));
+		if (block != (i == bitblock<nbits>::MSU ? bitblock<nbits>::MSU_MASK : bitblock<nbits>::ALL_ONES)) return false;
 	}
-	return carry;
+	return true;
 }
 
 // increment the input bitset in place, and return true if there is a carry generated.
@@ -175,13 +347,13 @@ bool increment_unsigned(bitblock<nbits>& number, unsigned nrBits = nbits - 1) {
 // decrement the input bitset in place, and return true if there is a borrow generated.
 template<unsigned nbits>
 bool decrement_bitset(bitblock<nbits>& number) {
-	bool borrow = true;
-	for (unsigned i = 0; i < nbits; i++) {
-		bool _a = number[i];
-		number[i] = bxor(_a, borrow);
-		borrow = (!bxor(!_a, true) && borrow);
+	using bt = typename bitblock<nbits>::bt;
+	for (unsigned i = 0; i < bitblock<nbits>::nrBlocks; ++i) {
+		bt block = number.block(i);
+		number.setblock(i, bt(block - 1u));
+		if (block != 0) return false;
 	}
-	return borrow;
+	return true;
 }
 
 //////////////////////////////////////////////////////////////////////////////////////
@@ -621,17 +793,9 @@ bitblock<nbits> ones_complement(bitblock<nbits> number) {
 // calculate the 2's complement of a 2's complement encoded number
 template<unsigned nbits>
 bitblock<nbits> twos_complement(bitblock<nbits> number) {
-	bitblock<nbits> complement;
-	uint8_t _slice = 0;
-	uint8_t carry = 1;
-	for (unsigned i = 0; i < nbits; i++) {
-		uint8_t not_bit_at_i = number[i] ? uint8_t(0) : uint8_t(1);
-		_slice = uint8_t(not_bit_at_i + carry);
-//		_slice = uint8_t(!number[i]) + carry;
-		carry = uint8_t(_slice >> 1);
-		complement[i] = (0x1 & _slice);
-	}
-	return complement;
+	number.flip();
+	increment_bitset(number);
+	return number;
 }
 
 // DANGER: this depends on the implicit type conversion of number to a uint64_t to sign extent a 2's complement number system
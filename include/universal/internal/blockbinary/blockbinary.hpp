@@ -5,6 +5,7 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <cstdint>
+#include <bit>
 #include <iostream>
 #include <string>
 #include <sstream>
@@ -15,6 +16,7 @@
 #define LONG_DOUBLE_SUPPORT 0
 #endif
 #include <universal/number/shared/specific_value_encoding.hpp>
+#include <universal/native/limb_division.hpp>
 
 namespace sw { namespace universal {
 
@@ -72,21 +74,29 @@ blockbinary<nbits, BlockType, NumberType> twosComplement(const blockbinary<nbits
 template<unsigned srcbits, unsigned tgtbits, typename bt, BinaryNumberType nt>
 void truncate(const blockbinary<srcbits, bt, nt>& src, blockbinary<tgtbits, bt, nt>& tgt) {
 	static_assert(tgtbits < srcbits, "truncate requires source posit to be bigger than target posit");
+	constexpr unsigned bitsInBlock = blockbinary<tgtbits, bt, nt>::bitsInBlock;
 	constexpr unsigned diff = srcbits - tgtbits;
-	for (unsigned i = 0; i < tgtbits; ++i) { // TODO: optimize for limbs
-		tgt.setbit(i, src.test(i + diff));
+	constexpr unsigned blockOffset = diff / bitsInBlock;
+	constexpr unsigned bitOffset = diff % bitsInBlock;
+	// gather each target limb from the two source limbs it straddles
+	for (unsigned i = 0; i < tgt.nrBlocks; ++i) {
+		bt limb = src.block(i + blockOffset);
+		if constexpr (bitOffset > 0) {
+			limb = static_cast<bt>((limb >> bitOffset) | (src.block(i + blockOffset + 1) << (bitsInBlock - bitOffset)));
+		}
+		tgt.setblock(i, limb);
 	}
+	tgt.setblock(tgt.MSU, static_cast<bt>(tgt.block(tgt.MSU) & tgt.MSU_MASK));
 }
 
 /*
 NOTES
 
 for block arithmetic, we need to manage a carry bit.
-This disqualifies using uint64_t as a block type as we can't catch the overflow condition
-in the same way as the other native types, uint8_t, uint16_t, uint32_t.
-
-We could use a sint64_t and then convert to uint64_t and observe the MSB. Very different 
-logic though.
+For uint8_t, uint16_t, and uint32_t blocks the carry is caught by promoting to uint64_t.
+For uint64_t blocks the carry and the upper half of the limb products are managed
+by the limb primitives addcarry/muladd, which map onto unsigned __int128 or
+add-with-carry instructions when the compiler provides them.
 */
 
 // a block-based binary number configurable to be signed or unsigned. When signed it uses 2's complement encoding
@@ -110,7 +120,7 @@ public:
 	static constexpr bt       SIGN_BIT_MASK = (0 == nbits ? bt(0) : (bt(bt(1) << ((nbits - 1ull) % bitsInBlock))));
 
 	static constexpr bool     uniblock64 = (bitsInBlock == 64) && (nrBlocks == 1);
-	static_assert(bitsInBlock < 64 || uniblock64, "storage unit for multi-block arithmetic needs to be one of [uint8_t | uint16_t | uint32_t]");
+	static_assert(bitsInBlock <= 64, "storage unit for block arithmetic needs to be one of [uint8_t | uint16_t | uint32_t | uint64_t]");
 
 	/// trivial constructor
 	blockbinary() = default;
@@ -152,9 +162,18 @@ public:
 
 	constexpr blockbinary& operator=(long long rhs) noexcept {
 		if constexpr (1 < nrBlocks) {
-			for (unsigned i = 0; i < nrBlocks; ++i) {
-				_block[i] = rhs & storageMask;
-				rhs >>= bitsInBlock;
+			if constexpr (bitsInBlock == 64) {
+				_block[0] = static_cast<bt>(rhs);
+				bt signExtension = (rhs < 0 ? ALL_ONES : bt(0));
+				for (unsigned i = 1; i < nrBlocks; ++i) {
+					_block[i] = signExtension;
+				}
+			}
+			else {
+				for (unsigned i = 0; i < nrBlocks; ++i) {
+					_block[i] = rhs & storageMask;
+					rhs >>= bitsInBlock;
+				}
 			}
 			// enforce precondition for fast comparison by properly nulling bits that are outside of nbits
 			_block[MSU] &= MSU_MASK;
@@ -236,22 +255,12 @@ public:
 			_block[MSU] = static_cast<bt>(MSU_MASK & _block[MSU]);
 		}
 		else {
-			blockbinary sum;
-			BlockType* pA = _block;
-			BlockType const* pB = rhs._block;
-			BlockType* pC = sum._block;
-			BlockType* pEnd = pC + nrBlocks;
-			std::uint64_t carry = 0;
-			while (pC != pEnd) {
-				carry += static_cast<std::uint64_t>(*pA) + static_cast<std::uint64_t>(*pB);
-				*pC = static_cast<bt>(carry);
-				carry >>= bitsInBlock;
-				++pA; ++pB; ++pC;
+			bool carry = false;
+			for (unsigned i = 0; i < nrBlocks; ++i) {
+				_block[i] = addcarry(_block[i], rhs._block[i], carry);
 			}
 			// enforce precondition for fast comparison by properly nulling bits that are outside of nbits
-			BlockType* pLast = pEnd - 1;
-			*pLast = static_cast<bt>(MSU_MASK & *pLast);
-			*this = sum;
+			_block[MSU] = static_cast<bt>(MSU_MASK & _block[MSU]);
 		}
 		return *this;
 	}
@@ -261,58 +270,21 @@ public:
 #define BLOCKBINARY_FAST_MUL
 #ifdef BLOCKBINARY_FAST_MUL
 	blockbinary& operator*=(const blockbinary& rhs) {
-		if constexpr (NumberType == BinaryNumberType::Signed) {
-			if constexpr (nrBlocks == 1) {
-				_block[0] = static_cast<bt>(_block[0] * rhs.block(0));
-			}
-			else {
-				// is there a better way than upconverting to deal with maxneg in a 2's complement encoding?
-				blockbinary<nbits + 1, BlockType, NumberType> base(*this);
-				blockbinary<nbits + 1, BlockType, NumberType> multiplicant(rhs);
-				bool resultIsNeg = (base.isneg() ^ multiplicant.isneg());
-				if (base.isneg()) {
-					base.twosComplement();
-				}
-				if (multiplicant.isneg()) {
-					multiplicant.twosComplement();
-				}
-				clear();
-				for (unsigned i = 0; i < static_cast<unsigned>(nrBlocks); ++i) {
-					std::uint64_t segment(0);
-					for (unsigned j = 0; j < static_cast<unsigned>(nrBlocks); ++j) {
-						segment += static_cast<std::uint64_t>(base.block(i)) * static_cast<std::uint64_t>(multiplicant.block(j));
-
-						if (i + j < static_cast<unsigned>(nrBlocks)) {
-							segment += _block[i + j];
-							_block[i + j] = static_cast<bt>(segment);
-							segment >>= bitsInBlock;
-						}
-					}
-				}
-				if (resultIsNeg) twosComplement();
-			}
+		// the lower nbits of the product are identical for 2's complement and unsigned operands,
+		// so signed and unsigned multiplication share the same modular kernel
+		if constexpr (nrBlocks == 1) {
+			_block[0] = static_cast<bt>(_block[0] * rhs.block(0));
 		}
-		else {  // unsigned
-			if constexpr (nrBlocks == 1) {
-				_block[0] = static_cast<bt>(_block[0] * rhs.block(0));
+		else {
+			bt product[nrBlocks];
+			if constexpr (nrBlocks < limb_mullo_threshold<>) {
+				limb_mullo_schoolbook(_block, rhs._block, nrBlocks, product);
 			}
 			else {
-				blockbinary base(*this);
-				blockbinary multiplicant(rhs);
-				clear();
-				for (unsigned i = 0; i < static_cast<unsigned>(nrBlocks); ++i) {
-					std::uint64_t segment(0);
-					for (unsigned j = 0; j < static_cast<unsigned>(nrBlocks); ++j) {
-						segment += static_cast<std::uint64_t>(base.block(i)) * static_cast<std::uint64_t>(multiplicant.block(j));
-
-						if (i + j < static_cast<unsigned>(nrBlocks)) {
-							segment += _block[i + j];
-							_block[i + j] = static_cast<bt>(segment);
-							segment >>= bitsInBlock;
-						}
-					}
-				}
+				bt scratch[mullo_scratch_size(nrBlocks)];
+				limb_mullo(_block, rhs._block, nrBlocks, product, scratch);
 			}
+			for (unsigned i = 0; i < nrBlocks; ++i) _block[i] = product[i];
 		}
 		// null any leading bits that fall outside of nbits
 		_block[MSU] = static_cast<bt>(MSU_MASK & _block[MSU]);
@@ -340,7 +312,10 @@ public:
 				*this = 0;
 				return *this;
 			}
-			if constexpr (sizeof(BlockType) == 1) {
+			if constexpr (NumberType == BinaryNumberType::Unsigned) {
+				_block[0] = static_cast<bt>(_block[0] / rhs._block[0]);
+			}
+			else if constexpr (sizeof(BlockType) == 1) {
 				_block[0] = static_cast<bt>(std::int8_t(_block[0]) / std::int8_t(rhs._block[0]));
 			}
 			else if constexpr (sizeof(BlockType) == 2) {
@@ -366,7 +341,10 @@ public:
 				*this = 0;
 				return *this;
 			}
-			if constexpr (sizeof(BlockType) == 1) {
+			if constexpr (NumberType == BinaryNumberType::Unsigned) {
+				_block[0] = static_cast<bt>(_block[0] % rhs._block[0]);
+			}
+			else if constexpr (sizeof(BlockType) == 1) {
 				_block[0] = static_cast<bt>(std::int8_t(_block[0]) % std::int8_t(rhs._block[0]));
 			}
 			else if constexpr (sizeof(BlockType) == 2) {
@@ -416,33 +394,29 @@ public:
 	blockbinary& operator<<=(int bitsToShift) {
 		if (bitsToShift == 0) return *this;
 		if (bitsToShift < 0) return operator>>=(-bitsToShift);
-		if (bitsToShift > static_cast<int>(nbits)) {
+		unsigned blockShift = static_cast<unsigned>(bitsToShift) / bitsInBlock;
+		unsigned shift = static_cast<unsigned>(bitsToShift) % bitsInBlock;
+		if (bitsToShift > static_cast<int>(nbits) || blockShift > MSU) {
 			setzero();
 			return *this;
 		}
-		if (bitsToShift >= static_cast<int>(bitsInBlock)) {
-			int blockShift = bitsToShift / static_cast<int>(bitsInBlock);
-			for (int i = static_cast<int>(MSU); i >= blockShift; --i) {
-				_block[i] = _block[i - blockShift];
-			}
-			for (int i = blockShift - 1; i >= 0; --i) {
-				_block[i] = bt(0);
+		if (shift == 0) {
+			for (unsigned i = nrBlocks; i > blockShift; --i) {
+				_block[i - 1] = _block[i - 1 - blockShift];
 			}
-			// adjust the shift
-			bitsToShift -= static_cast<int>(blockShift * bitsInBlock);
-			if (bitsToShift == 0) return *this;
 		}
-		if constexpr (MSU > 0) {
-			// construct the mask for the upper bits in the block that needs to move to the higher word
-			bt mask = 0xFFFFFFFFFFFFFFFF << (bitsInBlock - bitsToShift);
-			for (unsigned i = MSU; i > 0; --i) {
-				_block[i] <<= bitsToShift;
+		else {
+			for (unsigned i = MSU; i > blockShift; --i) {
 				// mix in the bits from the right
-				bt bits = bt(mask & _block[i - 1]);
-				_block[i] |= (bits >> (bitsInBlock - bitsToShift));
+				_block[i] = static_cast<bt>((_block[i - blockShift] << shift) | (_block[i - blockShift - 1] >> (bitsInBlock - shift)));
 			}
+			_block[blockShift] = static_cast<bt>(_block[0] << shift);
+		}
+		for (unsigned i = 0; i < blockShift; ++i) {
+			_block[i] = bt(0);
 		}
-		_block[0] <<= bitsToShift;
+		// enforce precondition for fast comparison by properly nulling bits that are outside of nbits
+		_block[MSU] &= MSU_MASK;
 		return *this;
 	}
 	// arithmetic shift right operator
@@ -454,70 +428,27 @@ public:
 			return *this;
 		}
 		bool signext = sign();
-		unsigned blockShift = 0;
-		if (bitsToShift >= static_cast<int>(bitsInBlock)) {
-			blockShift = bitsToShift / bitsInBlock;
-			if (MSU >= blockShift) {
-				// shift by blocks
-				for (unsigned i = 0; i <= MSU - blockShift; ++i) {
-					_block[i] = _block[i + blockShift];
-				}
-			}
-			// adjust the shift
-			bitsToShift -= static_cast<int>(blockShift * bitsInBlock);
-			if (bitsToShift == 0) {
-				// fix up the leading zeros if we have a negative number
-				if (signext) {
-					// bitsToShift is guaranteed to be less than nbits
-					bitsToShift += static_cast<int>(blockShift * bitsInBlock);
-					for (unsigned i = nbits - bitsToShift; i < nbits; ++i) {
-						this->setbit(i);
-					}
-				}
-				else {
-					// clean up the blocks we have shifted clean
-					bitsToShift += static_cast<int>(blockShift * bitsInBlock);
-					for (unsigned i = nbits - bitsToShift; i < nbits; ++i) {
-						this->setbit(i, false);
-					}
-				}
-				return *this;
-			}
-		}
-		if constexpr (MSU > 0) {
-			bt mask = ALL_ONES;
-			mask >>= (bitsInBlock - bitsToShift); // this is a mask for the lower bits in the block that need to move to the lower word
-			for (unsigned i = 0; i < MSU; ++i) {  // TODO: can this be improved? we should not have to work on the upper blocks in case we block shifted
-				_block[i] >>= bitsToShift;
-				// mix in the bits from the left
-				bt bits = bt(mask & _block[i + 1]);
-				_block[i] |= (bits << (bitsInBlock - bitsToShift));
-			}
-		}
-		_block[MSU] >>= bitsToShift;
-
-		// fix up the leading zeros if we have a negative number
-		if (signext) {
-			// bitsToShift is guaranteed to be less than nbits
-			bitsToShift += static_cast<int>(blockShift * bitsInBlock);
-			for (unsigned i = nbits - bitsToShift; i < nbits; ++i) {
-				this->setbit(i);
+		// bitsToShift is guaranteed to be less than nbits, so blockShift <= MSU
+		unsigned blockShift = static_cast<unsigned>(bitsToShift) / bitsInBlock;
+		unsigned shift = static_cast<unsigned>(bitsToShift) % bitsInBlock;
+		unsigned topBlock = MSU - blockShift;  // the last block that receives shifted bits
+		if (shift == 0) {
+			for (unsigned i = 0; i <= topBlock; ++i) {
+				_block[i] = _block[i + blockShift];
 			}
 		}
 		else {
-			// clean up the blocks we have shifted clean
-			bitsToShift += static_cast<int>(blockShift * bitsInBlock);
-			for (unsigned i = nbits - bitsToShift; i < nbits; ++i) {
-				this->setbit(i, false);
+			for (unsigned i = 0; i < topBlock; ++i) {
+				// mix in the bits from the left
+				_block[i] = static_cast<bt>((_block[i + blockShift] >> shift) | (_block[i + blockShift + 1] << (bitsInBlock - shift)));
 			}
+			_block[topBlock] = static_cast<bt>(_block[MSU] >> shift);
 		}
-
-		// enforce precondition for fast comparison by properly nulling bits that are outside of nbits
-		_block[MSU] &= MSU_MASK;
+		// fix up the leading bits: sign extension for a negative number, and clean up the blocks we have shifted clean
+		setrange(nbits - static_cast<unsigned>(bitsToShift), nbits, signext);
 		return *this;
 	}
 
-
 	///////////////////////////////////////////////////////////////////
 	///                  modifiers
 
@@ -554,16 +485,37 @@ public:
 			_block[0] = value & storageMask;
 		}
 		else if constexpr (1 < nrBlocks) {
-			for (unsigned i = 0; i < nrBlocks; ++i) {
-				_block[i] = value & storageMask;
-				value >>= bitsInBlock;
+			if constexpr (bitsInBlock == 64) {
+				_block[0] = value;
+				for (unsigned i = 1; i < nrBlocks; ++i) {
+					_block[i] = bt(0);
+				}
+			}
+			else {
+				for (unsigned i = 0; i < nrBlocks; ++i) {
+					_block[i] = value & storageMask;
+					value >>= bitsInBlock;
+				}
 			}
 		}
 		_block[MSU] &= MSU_MASK; // enforce precondition for fast comparison by properly nulling bits that are outside of nbits
 	}
 	constexpr void setblock(unsigned b, const bt& blockBits) noexcept {
 		if (b < nrBlocks) _block[b] = blockBits; // nop if b is out of range
-	}	
+	}
+	// set the bits in the range [lsb, msbPlusOne) to v with whole-limb masks
+	constexpr void setrange(unsigned lsb, unsigned msbPlusOne, bool v = true) noexcept {
+		if (msbPlusOne > nbits) msbPlusOne = nbits;
+		if (lsb >= msbPlusOne) return;
+		unsigned first = lsb / bitsInBlock;
+		unsigned last = (msbPlusOne - 1) / bitsInBlock;
+		for (unsigned i = first; i <= last; ++i) {
+			bt mask = ALL_ONES;
+			if (i == first) mask = static_cast<bt>(mask << (lsb % bitsInBlock));
+			if (i == last) mask = static_cast<bt>(mask & (ALL_ONES >> (bitsInBlock - 1 - ((msbPlusOne - 1) % bitsInBlock))));
+			_block[i] = static_cast<bt>(v ? (_block[i] | mask) : (_block[i] & ~mask));
+		}
+	}
 	constexpr blockbinary& flip() noexcept { // in-place one's complement
 		for (unsigned i = 0; i < nrBlocks; ++i) {
 			_block[i] = bt(~_block[i]);
@@ -658,9 +610,12 @@ public:
 		if (_block[MSU] || MSU_MASK) return true;
 		return false;
 	}
-	constexpr bool anyAfter(unsigned bitIndex) const noexcept {  // TODO: optimize for limbs
+	constexpr bool anyAfter(unsigned bitIndex) const noexcept {
 		if (bitIndex < nbits) {
-			for (unsigned i = 0; i < bitIndex; ++i) if (test(i)) return true;
+			unsigned limbs = bitIndex / bitsInBlock;
+			for (unsigned i = 0; i < limbs; ++i) if (_block[i] != 0) return true;
+			bt mask = static_cast<bt>(~(ALL_ONES << (bitIndex % bitsInBlock)));
+			if (bitIndex % bitsInBlock != 0 && (_block[limbs] & mask) != 0) return true;
 		}
 		return false;
 	}
@@ -670,10 +625,10 @@ public:
 		if (_block[MSU] & MSU_MASK) return false;
 		return true;
 	}
-	constexpr unsigned count() const noexcept { // TODO: optimize for limbs
+	constexpr unsigned count() const noexcept {
 		unsigned nrOnes = 0;
-		for (unsigned i = 0; i < nbits; ++i) {
-			if (test(i)) ++nrOnes;
+		for (unsigned i = 0; i < nrBlocks; ++i) {
+			nrOnes += static_cast<unsigned>(std::popcount(_block[i]));
 		}
 		return nrOnes;
 	}
@@ -690,7 +645,7 @@ public:
 		if (n < (1 + ((nbits - 1) >> 2))) {
 			bt word = _block[(n * 4) / bitsInBlock];
 			unsigned nibbleIndexInWord = n % (bitsInBlock >> 2);
-			bt mask = static_cast<bt>(0x0Fu << (nibbleIndexInWord*4));
+			bt mask = static_cast<bt>(bt(0x0Fu) << (nibbleIndexInWord*4));
 			bt nibblebits = static_cast<bt>(mask & word);
 			retval = static_cast<uint8_t>(nibblebits >> static_cast<bt>(nibbleIndexInWord*4));
 		}
@@ -715,11 +670,7 @@ public:
 			_block[i] = rhs.block(i);
 		}
 		if constexpr (nbits > srcbits) { // check if we need to sign extend
-			if (rhs.sign()) {
-				for (unsigned i = srcbits; i < nbits; ++i) { // TODO: replace bit-oriented sequence with block
-					setbit(i);
-				}
-			}
+			if (rhs.sign()) setrange(srcbits, nbits);
 		}
 		// enforce precondition for fast comparison by properly nulling bits that are outside of nbits
 		_block[MSU] &= MSU_MASK;
@@ -746,13 +697,16 @@ public:
 	int msb() const noexcept {
 		for (int i = int(MSU); i >= 0; --i) {
 			if (_block[i] != 0) {
-				bt mask = (bt(1u) << (bitsInBlock-1));
-				for (int j = bitsInBlock - 1; j >= 0; --j) {
-					if (_block[i] & mask) {
-						return i * static_cast<int>(bitsInBlock) + j;
-					}
-					mask >>= 1;
-				}
+				return i * static_cast<int>(bitsInBlock) + static_cast<int>(bitsInBlock - 1) - std::countl_zero(_block[i]);
+			}
+		}
+		return -1; // no significant bit found, all bits are zero
+	}
+	// return the position of the least significant bit, -1 if v == 0
+	int lsb() const noexcept {
+		for (unsigned i = 0; i < nrBlocks; ++i) {
+			if (_block[i] != 0) {
+				return static_cast<int>(i * bitsInBlock) + std::countr_zero(_block[i]);
 			}
 		}
 		return -1; // no significant bit found, all bits are zero
@@ -918,57 +872,41 @@ inline blockbinary<N, B, T> operator>>(const blockbinary<N, B, T>& a, const long
 }
 
 // divide a by b and return both quotient and remainder
+// the division runs on whole limbs: Knuth's Algorithm D, or Newton-Raphson for very wide divisors
 template<unsigned N, typename B, BinaryNumberType T>
 quorem<N, B, T> longdivision(const blockbinary<N, B, T>& _a, const blockbinary<N, B, T>& _b) {
-	using BlockBinary = blockbinary<N + 1, B, T>;
+	using BlockBinary = blockbinary<N, B, T>;
+	constexpr unsigned nrBlocks = BlockBinary::nrBlocks;
 	quorem<N, B, T> result = { 0, 0, 0 };
 	if (_b.iszero()) {
 		result.exceptionId = 1; // division by zero
 		return result;
 	}
-	// generate the absolute values to do long division 
-	// 2's complement special case -max requires an signed int that is 1 bit bigger to represent abs()
-	bool a_sign = _a.sign();
-	bool b_sign = _b.sign();
-	bool result_negative = (a_sign ^ b_sign);
-	// normalize both arguments to positive, which requires expansion by 1-bit to deal with maxneg
-	BlockBinary a(_a);
-	BlockBinary b(_b);
-	if (a_sign) a.twosComplement();
-	if (b_sign) b.twosComplement();
-
-	if (a < b) { // optimization for integer numbers
-		result.rem = _a; // a % b = a when a / b = 0
-		return result;   // a / b = 0 when b > a
-	}
-	// initialize the long division
-	BlockBinary accumulator = a;
-	// prepare the subtractand
-	BlockBinary subtractand = b;
-	int msb_b = b.msb();
-	int msb_a = a.msb();
-	int shift = msb_a - msb_b;
-	subtractand <<= shift;
-	// long division
-	for (int i = shift; i >= 0; --i) {
-		if (subtractand <= accumulator) {
-			accumulator -= subtractand;
-			result.quo.setbit(static_cast<unsigned>(i));
-		}
-		else {
-			result.quo.setbit(static_cast<unsigned>(i), false);
-		}
-		subtractand >>= 1;
+	// generate the absolute values to do long division
+	// the magnitude of the 2's complement maxneg is 2^(N-1), which fits in N unsigned bits
+	bool a_sign{ false }, b_sign{ false };
+	if constexpr (T == BinaryNumberType::Signed) {
+		a_sign = _a.sign();
+		b_sign = _b.sign();
 	}
-	if (result_negative) {  // take 2's complement
-		result.quo.flip();
-		result.quo += 1;
+	B a[nrBlocks], b[nrBlocks], q[nrBlocks], r[nrBlocks];
+	bool a_carry{ a_sign }, b_carry{ b_sign };
+	for (unsigned i = 0; i < nrBlocks; ++i) {
+		a[i] = addcarry(static_cast<B>(a_sign ? ~_a.block(i) : _a.block(i)), B(0), a_carry);
+		b[i] = addcarry(static_cast<B>(b_sign ? ~_b.block(i) : _b.block(i)), B(0), b_carry);
 	}
-	if (_a.isneg()) {
-		result.rem = -accumulator;
+	a[nrBlocks - 1] &= BlockBinary::MSU_MASK;
+	b[nrBlocks - 1] &= BlockBinary::MSU_MASK;
+
+	B scratch[divmod_scratch_size(nrBlocks, nrBlocks)];
+	limb_divmod(a, nrBlocks, b, nrBlocks, q, r, scratch);
+	for (unsigned i = 0; i < nrBlocks; ++i) {
+		result.quo.setblock(i, q[i]);
+		result.rem.setblock(i, r[i]);
 	}
-	else {
-		result.rem = accumulator;
+	if constexpr (T == BinaryNumberType::Signed) {
+		if (a_sign ^ b_sign) result.quo.twosComplement();
+		if (a_sign) result.rem.twosComplement(); // the remainder takes the sign of the dividend
 	}
 	return result;
 }
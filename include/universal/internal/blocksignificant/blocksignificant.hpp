@@ -5,6 +5,7 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <cstdint>
+#include <bit>
 #include <cmath> // for std::pow() used in conversions to native IEEE-754 formats values
 #include <iostream>
 #include <string>
@@ -234,7 +235,13 @@ public:
 			uint64_t l = uint64_t(lhs._block[i]);
 			uint64_t r = uint64_t(rhs._block[i]);
 			uint64_t s = l + r + (carry ? uint64_t(1) : uint64_t(0));
-			carry = (s > ALL_ONES);
+			if constexpr (bitsInBlock == 64) {
+				// a 64-bit block cannot be cast up: the sum wrapped around when it is below an operand
+				carry = (s < l || (carry && s == l));
+			}
+			else {
+				carry = (s > ALL_ONES);
+			}
 			_block[i] = bt(s);
 		}
 		// enforce precondition for fast comparison by properly nulling bits that are outside of nbits
@@ -319,6 +326,7 @@ public:
 			setzero();
 			return *this;
 		}
+		_block[MSU] &= MSU_MASK; // bits above nbits must not shift into the significant
 
 		unsigned blockShift = 0;
 		if (bitsToShift >= static_cast<int>(bitsInBlock)) {
@@ -329,17 +337,13 @@ public:
 					_block[i] = _block[i + blockShift];
 				}
 			}
+			// clean up the blocks we have shifted clean
+			for (unsigned i = MSU - blockShift + 1; i <= MSU; ++i) {
+				_block[i] = bt(0);
+			}
 			// adjust the shift
 			bitsToShift -= static_cast<int>(blockShift * bitsInBlock);
-			if (bitsToShift == 0) {
-				// clean up the blocks we have shifted clean
-				bitsToShift += static_cast<int>(blockShift * bitsInBlock);
-				for (unsigned i = nbits - bitsToShift; i < nbits; ++i) {
-					this->setbit(i, false); // reset
-				}
-
-				return *this;
-			}
+			if (bitsToShift == 0) return *this;
 		}
 		if constexpr (MSU > 0) {
 			bt mask = ALL_ONES;
@@ -353,12 +357,6 @@ public:
 		}
 		_block[MSU] >>= bitsToShift;
 
-		// clean up the blocks we have shifted clean
-		bitsToShift += static_cast<int>(blockShift * bitsInBlock);
-		for (unsigned i = nbits - bitsToShift; i < nbits; ++i) {
-			this->setbit(i, false); // reset
-		}
-
 		// enforce precondition for fast comparison by properly nulling bits that are outside of nbits
 		_block[MSU] &= MSU_MASK;
 		return *this;
@@ -530,13 +528,7 @@ public:
 	constexpr int msb() const noexcept {
 		for (int i = int(MSU); i >= 0; --i) {
 			if (_block[i] != 0) {
-				bt mask = (bt(1u) << (bitsInBlock-1));
-				for (int j = bitsInBlock - 1; j >= 0; --j) {
-					if (_block[i] & mask) {
-						return i * static_cast<int>(bitsInBlock) + j;
-					}
-					mask >>= 1;
-				}
+				return i * static_cast<int>(bitsInBlock) + static_cast<int>(bitsInBlock - 1) - std::countl_zero(_block[i]);
 			}
 		}
 		return -1; // no significant bit found, all bits are zero
@@ -22,9 +22,14 @@
 #if !defined(CONSTEXPRESSION)
 #define CONSTEXPRESSION
 #endif
+// number of fraction bits from which division runs on 32-bit limbs instead of the bit-serial restoring division
+#ifndef BLOCKTRIPLE_LIMB_DIVISION_THRESHOLD
+#define BLOCKTRIPLE_LIMB_DIVISION_THRESHOLD 8
+#endif
 
 // dependent types for stand-alone use of this class
 #include <universal/native/integers.hpp> // to_binary(uint64_t)
+#include <universal/native/limb_division.hpp>
 #include <universal/native/ieee754.hpp>
 #include <universal/native/subnormal.hpp>
 #include <universal/utility/find_msb.hpp>
@@ -58,7 +63,7 @@ namespace sw { namespace universal {
 	*/
 
  // operator specialization tag for blocktriple
-enum class BlockTripleOperator { REP, ADD, MUL, DIV, SQRT };
+enum class BlockTripleOperator { REP, ADD, MUL, DIV, SQRT, FMA };
 inline std::ostream& operator<<(std::ostream& ostr, const BlockTripleOperator& op) {
 	switch (op) {
 	case BlockTripleOperator::REP:
@@ -76,6 +81,9 @@ inline std::ostream& operator<<(std::ostream& ostr, const BlockTripleOperator& o
 	case BlockTripleOperator::SQRT:
 		ostr << "SQRT";
 		break;
+	case BlockTripleOperator::FMA:
+		ostr << "FMA";
+		break;
 	default:
 		ostr << "NOP";
 	}
@@ -111,6 +119,12 @@ std::string type_tag(const blocktriple<fbits, op, bt>& = {}) {
 /// For multiplication, blocktriple uses a 1's complement representation of the form ii.fffff.
 /// The 2 integer bits are required to capture the overflow condition.
 /// 
+/// For fused multiply-add, blocktriple uses the 2's complement form of addition, iii.fffff,
+/// with enough fraction bits to hold the unrounded product of two significants.
+/// 
+/// For square root, blocktriple yields the root in the form 1.fffffgs, with a guard bit
+/// and a sticky bit that capture the remainder of the root.
+/// 
 /// Blocktriple does not normalize the output of ADD/SUB/MUL so that all bits are
 /// available for the rounding decision. Number systems that use blocktriple as
 /// their general floating-point engine can use the roundUp(targetFbits) method to
@@ -140,20 +154,23 @@ public:
 	static constexpr unsigned mbits    = 2 * fbits;          // size of the fraction bits of the multiplier
 	static constexpr unsigned divbits  = 3 * fbits + 4;      // size of the fraction bits of the divider
 	static constexpr unsigned divshift = divbits - fbits;    // alignment shift for divider operands
-	static constexpr unsigned sqrtbits = 2 * fhbits;      // size of the square root output
+	static constexpr unsigned sqrtbits = 2 * fhbits + 3;  // size of the square root radicand: 2*fbits + 4 bits plus a bit to compare in 2's complement
+	static constexpr unsigned fmabits  = mbits + 1 + rbits;  // size of the fraction bits of the fused multiply-add: the normalized product plus rounding bits
 	// we transform input operands into the operation's target output size
 	// so that everything is aligned correctly before the operation starts.
 	static constexpr unsigned bfbits =
 		(op == BlockTripleOperator::ADD ? (3 + abits) :           // we need 3 integer bits (bits left of the radix point) to capture 2's complement and overflow
 			(op == BlockTripleOperator::MUL ? (2 + mbits) :       // we need 2 integer bits to capture overflow: multiply happens in 1's complement
 				(op == BlockTripleOperator::DIV ? (2 + divbits) : // we need 2 integer bits to capture overflow: divide happens in 1's complement
-					(op == BlockTripleOperator::SQRT ? sqrtbits : fhbits+1))));  // REPRESENTATION is the fall through condition and adds a bit to accomodate 2's complement encodings
+					(op == BlockTripleOperator::SQRT ? sqrtbits :
+						(op == BlockTripleOperator::FMA ? (3 + fmabits) : fhbits+1)))));  // REPRESENTATION is the fall through condition and adds a bit to accomodate 2's complement encodings
 	// radix point of the OUTPUT of an operator
 	static constexpr int radix =
 		(op == BlockTripleOperator::ADD ? static_cast<int>(abits) :
 			(op == BlockTripleOperator::MUL ? static_cast<int>(mbits) :
 				(op == BlockTripleOperator::DIV ? static_cast<int>(divbits) :
-					(op == BlockTripleOperator::SQRT ? static_cast<int>(sqrtbits) : static_cast<int>(fbits)))));  // REPRESENTATION is the fall through condition
+					(op == BlockTripleOperator::SQRT ? static_cast<int>(fbits + 2) :  // root 1.ffff, a guard bit, and a sticky bit
+						(op == BlockTripleOperator::FMA ? static_cast<int>(fmabits) : static_cast<int>(fbits))))));  // REPRESENTATION is the fall through condition
 //	static constexpr BitEncoding encoding =
 //		(op == BlockTripleOperator::ADD ? BitEncoding::Twos :
 //			(op == BlockTripleOperator::MUL ? BitEncoding::Ones :
@@ -374,14 +391,8 @@ public:
 	inline constexpr bool sign()                 const noexcept { return _sign; }
 	inline constexpr int  scale()                const noexcept { return _scale; }
 	inline constexpr int  significantscale()     const noexcept {
-		int sigScale = 0;
-		for (int i = bfbits - 1; i >= radix; --i) {
-			if (_significant.at(static_cast<unsigned>(i))) {
-				sigScale = i - radix;
-				break;
-			}
-		}
-		return sigScale;
+		int msb = _significant.msb();
+		return (msb > static_cast<int>(radix) ? msb - static_cast<int>(radix) : 0);
 	}
 	inline constexpr Significant significant()   const noexcept { return _significant; }
 	inline constexpr Significant fraction()      const noexcept { return _significant.fraction(); }
@@ -410,7 +421,8 @@ public:
 		std::cout << "abits             : " << abits << "      size of the addend = fbits + rbits\n";
 		std::cout << "mbits             : " << mbits << "      size of the multiplier output\n";
 		std::cout << "divbits           : " << divbits << "      size of the divider output\n";
-		std::cout << "sqrtbits          : " << sqrtbits << "      size of the square root output\n";
+		std::cout << "sqrtbits          : " << sqrtbits << "      size of the square root radicand\n";
+		std::cout << "fmabits           : " << fmabits << "      size of the fused multiply-add output\n";
 		// we transform input operands into the operation's target output size
 		// so that everything is aligned correctly before the operation starts.
 		std::cout << "bfbits            : " << bfbits << "      bits in the blocksignificant representation\n";
@@ -519,6 +531,59 @@ public:
 		add(lhs, rhs.twosComplement());
 	}
 
+	/// <summary>
+	/// fused multiply-add of two real numbers with fbits fraction bits and an addend
+	/// yielding an unrounded result of 3+fmabits.
+	/// 
+	/// The product of the multiplier operands is exact and is normalized to 001.ffff'ffff'f
+	/// without loss of bits, after which it is aligned and added to the addend as in add().
+	/// The fmabits fraction bits hold the normalized product plus the rounding bits of the
+	/// aligned operand, so the result only needs the single rounding of the conversion stage.
+	/// </summary>
+	/// <param name="lhs">ephemeral multiplier blocktriple that may get modified</param>
+	/// <param name="rhs">ephemeral multiplier blocktriple that may get modified</param>
+	/// <param name="addend">ephemeral blocktriple in the form 001.ffff that may get modified</param>
+	void fma(blocktriple<fbits, BlockTripleOperator::MUL, bt>& lhs, blocktriple<fbits, BlockTripleOperator::MUL, bt>& rhs, blocktriple& addend) {
+		static_assert(op == BlockTripleOperator::FMA, "fma requires a blocktriple<fbits, BlockTripleOperator::FMA, bt>");
+		using Product = blocktriple<fbits, BlockTripleOperator::MUL, bt>;
+		Product product;
+		product.mul(lhs, rhs);
+		if (product.iszero()) {
+			*this = addend;
+			return;
+		}
+
+		// transform the product ii.ffff'ffff into the addend form 001.ffff'ffff'frrr
+		blocktriple multiplicand;
+		multiplicand.setnormal();
+		multiplicand.setsign(product.sign());
+		for (unsigned b = 0; b < Product::Significant::nrBlocks; ++b) {
+			multiplicand.setblock(b, product.block(b));
+		}
+		multiplicand.setradix();
+		if (product.test(Product::bfbits - 1)) {  // 1#.ffff'ffff: the overflow bit becomes the leading bit
+			multiplicand.bitShift(static_cast<int>(fmabits - mbits) - 1);
+			multiplicand.setscale(product.scale() + 1);
+		}
+		else {
+			multiplicand.bitShift(static_cast<int>(fmabits - mbits));
+			multiplicand.setscale(product.scale());
+		}
+
+		if constexpr (_trace_btriple_fma) {
+			std::cout << "blocktriple fma\n";
+			std::cout << "product      : " << to_binary(product) << " : " << product << '\n';
+			std::cout << "multiplicand : " << to_binary(multiplicand) << " : " << multiplicand << '\n';
+			std::cout << "addend       : " << to_binary(addend) << " : " << addend << '\n';
+		}
+
+		if (addend.iszero()) {
+			*this = multiplicand;
+			return;
+		}
+		add(multiplicand, addend);
+	}
+
 	/// <summary>
 	/// multiply two real numbers with fbits fraction bits 
 	/// yielding an 2*(1+fbits) unrounded product.
@@ -590,7 +655,12 @@ public:
 		int scale_of_result = lhs_scale - rhs_scale;
 
 		// avoid copy by directly manipulating the fraction bits of the arguments
-		_significant.div(lhs._significant, rhs._significant);
+		if constexpr (fbits >= BLOCKTRIPLE_LIMB_DIVISION_THRESHOLD) {
+			limbDivision(lhs._significant, rhs._significant);
+		}
+		else {
+			_significant.div(lhs._significant, rhs._significant);
+		}
 		_significant.setradix(radix);
 
 		if constexpr (_trace_btriple_div) {
@@ -634,7 +704,140 @@ public:
 		}
 	}
 
+	/// <summary>
+	/// square root of a real number with fbits fraction bits, yielding the root 1.ffff
+	/// with a guard bit and a sticky bit, so that the conversion stage can round it.
+	/// 
+	/// The root is computed with a restoring digit recurrence on the blocks of the
+	/// significant, which generates one root bit per step and leaves the exact remainder
+	/// for the sticky bit. The leading 31 root bits are seeded by the integer square root
+	/// of the leading 62 bits of the radicand, which fits the native floating-point unit.
+	/// </summary>
+	/// <param name="a">ephemeral blocktriple of the form 01.ffff with the radix at fbits</param>
+	void sqrt(blocktriple& a) {
+		static_assert(op == BlockTripleOperator::SQRT, "sqrt requires a blocktriple<fbits, BlockTripleOperator::SQRT, bt>");
+		if (a.iszero()) {
+			setzero(a.sign());
+			return;
+		}
+		// make the scale even so that it can be halved: value = 1f.ffff * 2^(scale - 1) for an odd scale
+		int scale = a.scale();
+		Significant radicand = a._significant;
+		if (scale & 1) {
+			radicand <<= 1;
+			--scale;
+		}
+		// radicand of 2*fbits + 4 bits, which yields a root of fbits + 2 bits: the hidden bit, fbits, and a guard bit
+		radicand <<= static_cast<int>(fbits + 2);
+		constexpr unsigned rootbits = fbits + 2;  // number of root bits, each consuming two radicand bits
+		bool sticky{ false };
+		if constexpr (bfbits <= 64) {
+			uint64_t n = radicand.significant_ull();
+			uint64_t q = isqrt(n);
+			sticky = (n != q * q);
+			_significant.setbits((q << 1) | (sticky ? 1ull : 0ull));
+		}
+		else {
+			constexpr unsigned seedbits = 31;                   // root bits seeded by the integer square root
+			constexpr unsigned shift = 2 * (rootbits - seedbits); // radicand bits below the seed
+			Significant t = radicand;
+			t >>= static_cast<int>(shift);
+			uint64_t top{ 0 };
+			for (unsigned b = 0; b < Significant::nrBlocks && b * bitsInBlock < 64; ++b) {
+				top |= static_cast<uint64_t>(t.block(b)) << (b * bitsInBlock);
+			}
+			uint64_t q = isqrt(top);
+			// the recurrence carries the partial root scaled by 4^j: root = q * 2^shift, remainder = radicand - q^2 * 2^shift
+			Significant root, square, bit, trial;
+			for (unsigned b = 0; b < Significant::nrBlocks && b * bitsInBlock < 64; ++b) {
+				root.setblock(b, bt(q >> (b * bitsInBlock)));
+				square.setblock(b, bt((q * q) >> (b * bitsInBlock)));
+			}
+			root <<= static_cast<int>(shift);
+			square <<= static_cast<int>(shift);
+			radicand.sub(radicand, square);
+			bit.setbit(shift - 2);
+			for (unsigned i = seedbits; i < rootbits; ++i) {
+				trial.add(root, bit);
+				root >>= 1;
+				if (trial <= radicand) {
+					radicand.sub(radicand, trial);
+					root.add(root, bit);
+				}
+				bit >>= 2;
+			}
+			sticky = !radicand.iszero();
+			root <<= 1;
+			root.setbit(0, sticky);
+			_significant = root;
+		}
+		_significant.setradix(radix);
+		_nan = false;
+		_inf = false;
+		_zero = false;
+		_sign = false;
+		_scale = scale / 2;
+	}
+
 private:
+	// number of 32-bit limbs that hold a significant
+	static constexpr unsigned nrLimbs = (Significant::nrBlocks * bitsInBlock + 31u) / 32u;
+
+	// copy the blocks of a significant into 32-bit limbs
+	static void significantToLimbs(const Significant& s, uint32_t* limbs) noexcept {
+		for (unsigned i = 0; i < nrLimbs; ++i) limbs[i] = 0;
+		for (unsigned b = 0; b < Significant::nrBlocks; ++b) {
+			if constexpr (bitsInBlock == 64) {
+				limbs[2 * b] = static_cast<uint32_t>(s.block(b));
+				limbs[2 * b + 1] = static_cast<uint32_t>(uint64_t(s.block(b)) >> 32);
+			}
+			else {
+				limbs[(b * bitsInBlock) / 32] |= static_cast<uint32_t>(s.block(b)) << ((b * bitsInBlock) % 32);
+			}
+		}
+	}
+
+	// quotient of two significants with the radix at divbits.
+	// The quotient is computed with the limb division of limb_division.hpp, which runs Algorithm D at
+	// the precisions of a blocktriple, and a Newton-Raphson reciprocal for divisors wider than
+	// LIMB_NEWTON_THRESHOLD limbs. Only fbits + 4 quotient bits are developed, and the remainder is
+	// jammed into the lsb as a sticky bit, which is all the conversion stage needs to round correctly.
+	void limbDivision(const Significant& lhs, const Significant& rhs) {
+		constexpr unsigned quotientBits = fbits + 4;  // below the radix: fraction, guard, and round bits
+		constexpr unsigned dividendLimbs = nrLimbs + quotientBits / 32u + 1u;
+		uint32_t a[nrLimbs], b[nrLimbs];
+		significantToLimbs(lhs, a);
+		significantToLimbs(rhs, b);
+		// the operands are aligned to the radix: drop the common trailing zero limbs
+		unsigned lsl = 0;
+		while (lsl < nrLimbs - 1 && a[lsl] == 0 && b[lsl] == 0) ++lsl;
+		unsigned n = nrLimbs - lsl;
+
+		// u = a * 2^quotientBits, q = u / b
+		uint32_t u[dividendLimbs]{}, q[dividendLimbs]{}, r[nrLimbs];
+		uint32_t scratch[divmod_scratch_size(dividendLimbs, nrLimbs)];
+		constexpr unsigned limbShift = quotientBits / 32u;
+		u[n + limbShift] = limb_shl(a + lsl, n, static_cast<int>(quotientBits % 32u), u + limbShift);
+		limb_divmod(u, n + limbShift + 1, b + lsl, n, q, r, scratch);
+		bool sticky = limb_significant(r, n) > 0;
+
+		// q < 2^(quotientBits + 1) is the quotient with the radix at quotientBits
+		_significant.clear();
+		for (unsigned i = 0; i < Significant::nrBlocks; ++i) {
+			if constexpr (bitsInBlock == 64) {
+				uint64_t lo = (2 * i < dividendLimbs ? q[2 * i] : 0u);
+				uint64_t hi = (2 * i + 1 < dividendLimbs ? q[2 * i + 1] : 0u);
+				_significant.setblock(i, bt(lo | (hi << 32)));
+			}
+			else {
+				unsigned limb = (i * bitsInBlock) / 32;
+				if (limb < dividendLimbs) _significant.setblock(i, bt(q[limb] >> ((i * bitsInBlock) % 32)));
+			}
+		}
+		_significant <<= static_cast<int>(divbits - quotientBits);
+		if (sticky) _significant.setbit(0);
+	}
+
 	// special cases to keep track of
 	bool _nan; // most dominant state
 	bool _inf; // second most dominant state
@@ -757,6 +960,9 @@ private:
 		case BlockTripleOperator::SQRT:
 			_significant.setradix(2 * fbits);
 			break;
+		case BlockTripleOperator::FMA:
+			_significant.setradix(fbits);
+			break;
 		case BlockTripleOperator::REP:
 			_significant.setradix(fbits);
 			break;
@@ -792,6 +998,9 @@ private:
 		case BlockTripleOperator::SQRT:
 			_significant.setradix(2 * fbits);
 			break;
+		case BlockTripleOperator::FMA:
+			_significant.setradix(fbits);
+			break;
 		case BlockTripleOperator::REP:
 			_significant.setradix(fbits);
 			break;
@@ -894,6 +1103,10 @@ private:
 				_significant.setradix(2 * fbits);
 				_significant <<= fbits;
 				break;
+			case BlockTripleOperator::FMA:
+				_significant.setradix(fmabits);
+				_significant <<= (fmabits - fbits);
+				break;
 			}
 		}
 
@@ -20,6 +20,7 @@ constexpr bool _trace_btriple_mul         = false;
 constexpr bool _trace_btriple_div         = false;
 constexpr bool _trace_btriple_reciprocate = false;
 constexpr bool _trace_btriple_sqrt        = false;
+constexpr bool _trace_btriple_fma         = false;
 
 // quire update tracing
 constexpr bool _trace_btriple_quire_add   = false;
@@ -36,6 +37,7 @@ constexpr bool _trace_btriple_quire_add   = false;
 #define BLOCKTRIPLE_TRACE_DIV
 #define BLOCKTRIPLE_TRACE_RECIPROCATE
 #define BLOCKTRIPLE_TRACE_SQRT
+#define BLOCKTRIPLE_TRACE_FMA
 #endif
 
 #ifdef QUIRE_TRACE_ALL
@@ -99,6 +101,12 @@ constexpr bool _trace_btriple_sqrt = false;
 constexpr bool _trace_btriple_sqrt = true;
 #endif
 
+#ifndef BLOCKTRIPLE_TRACE_FMA
+constexpr bool _trace_btriple_fma = false;
+#else
+constexpr bool _trace_btriple_fma = true;
+#endif
+
 // QUIRE tracing
 #ifndef QUIRE_TRACE_ADD
 constexpr bool _trace_btriple_quire_add = false;
@@ -0,0 +1,122 @@
+#pragma once
+// binary16.hpp: conversions between IEEE-754 binary16 encodings and native floats
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cstddef>
+#include <bit>
+
+/*
+ Conversions between the 16-bit encoding of an IEEE-754 half-precision value and a float.
+
+ The widening conversion is exact, and the narrowing conversion rounds to nearest, ties to even.
+ Three implementations are selected at compile time:
+
+     F16C       : the vcvtph2ps/vcvtps2ph instructions of x86 processors (-mf16c, -mavx2 on MSVC)
+     _Float16   : the compiler's half-precision type, when it exposes one
+     portable   : branch-free bit manipulation, which the compiler can vectorize for arrays
+
+ The portable narrowing conversion relies on float addition in the default round-to-nearest mode,
+ and both portable conversions require that subnormal floats are not flushed to zero.
+ */
+
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define UNIVERSAL_NATIVE_F16C 1
+#include <immintrin.h>
+#else
+#define UNIVERSAL_NATIVE_F16C 0
+#endif
+
+#if defined(__FLT16_MANT_DIG__)
+#define UNIVERSAL_NATIVE_FLOAT16 1
+#else
+#define UNIVERSAL_NATIVE_FLOAT16 0
+#endif
+
+namespace sw { namespace universal {
+
+// widen a binary16 encoding to a float with bit manipulation: a binary16 value with its exponent
+// and fraction aligned to the fields of a float is the value scaled by 2^-112, subnormals included
+inline float binary16_to_float_portable(std::uint16_t h) noexcept {
+	constexpr float scale = std::bit_cast<float>(std::uint32_t(254u - 15u) << 23);     // 2^112
+	constexpr float infnan = std::bit_cast<float>(std::uint32_t(127u + 16u) << 23);    // 2^16
+	std::uint32_t sign = std::uint32_t(h & 0x8000u) << 16;
+	float magnitude = std::bit_cast<float>(std::uint32_t(h & 0x7FFFu) << 13) * scale;
+	std::uint32_t bits = std::bit_cast<std::uint32_t>(magnitude);
+	bits |= (magnitude >= infnan ? (std::uint32_t(0xFFu) << 23) : 0u); // inf and NaN keep an all-ones exponent
+	return std::bit_cast<float>(bits | sign);
+}
+
+// narrow a float to a binary16 encoding with bit manipulation, rounding to nearest, ties to even
+inline std::uint16_t float_to_binary16_portable(float f) noexcept {
+	constexpr std::uint32_t f32inf = std::uint32_t(255u) << 23;
+	constexpr std::uint32_t f16overflow = std::uint32_t(127u + 16u) << 23;              // 2^16
+	constexpr std::uint32_t f16normal = std::uint32_t(127u - 14u) << 23;                // 2^-14
+	constexpr std::uint32_t denormMagic = std::uint32_t((127u - 15u) + (23u - 10u) + 1u) << 23;
+	std::uint32_t bits = std::bit_cast<std::uint32_t>(f);
+	std::uint32_t sign = bits & 0x8000'0000u;
+	bits ^= sign;
+	// values that are out of range become inf, and NaNs become a quiet NaN
+	std::uint32_t special = (bits > f32inf ? 0x7E00u : 0x7C00u);
+	// subnormals: the float addition aligns the lsb of the binary16 subnormal and rounds
+	std::uint32_t subnormal = std::bit_cast<std::uint32_t>(std::bit_cast<float>(bits) + std::bit_cast<float>(denormMagic)) - denormMagic;
+	// normals: rebias the exponent and round on the 13 bits that are dropped
+	std::uint32_t normal = (bits + (std::uint32_t(15u - 127u) << 23) + 0xFFFu + ((bits >> 13) & 1u)) >> 13;
+	std::uint32_t h = (bits >= f16overflow ? special : (bits < f16normal ? subnormal : normal));
+	return static_cast<std::uint16_t>(h | (sign >> 16));
+}
+
+// widen a binary16 encoding to a float
+inline float binary16_to_float(std::uint16_t h) noexcept {
+#if UNIVERSAL_NATIVE_F16C
+	return _cvtsh_ss(h);
+#elif UNIVERSAL_NATIVE_FLOAT16
+	return static_cast<float>(std::bit_cast<_Float16>(h));
+#else
+	return binary16_to_float_portable(h);
+#endif
+}
+
+// narrow a float to a binary16 encoding, rounding to nearest, ties to even
+inline std::uint16_t float_to_binary16(float f) noexcept {
+#if UNIVERSAL_NATIVE_F16C
+	return static_cast<std::uint16_t>(_cvtss_sh(f, _MM_FROUND_TO_NEAREST_INT));
+#elif UNIVERSAL_NATIVE_FLOAT16
+	return std::bit_cast<std::uint16_t>(static_cast<_Float16>(f));
+#else
+	return float_to_binary16_portable(f);
+#endif
+}
+
+// widen an array of binary16 encodings to floats
+inline void binary16_to_float(const std::uint16_t* src, float* dst, std::size_t n) noexcept {
+	std::size_t i = 0;
+#if UNIVERSAL_NATIVE_F16C
+	for (; i + 8 <= n; i += 8) {
+		__m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		_mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+	}
+	for (; i < n; ++i) dst[i] = _cvtsh_ss(src[i]);
+#else
+	// the portable conversion vectorizes, the compiler's _Float16 conversion may be a library call
+	for (; i < n; ++i) dst[i] = binary16_to_float_portable(src[i]);
+#endif
+}
+
+// narrow an array of floats to binary16 encodings, rounding to nearest, ties to even
+inline void float_to_binary16(const float* src, std::uint16_t* dst, std::size_t n) noexcept {
+	std::size_t i = 0;
+#if UNIVERSAL_NATIVE_F16C
+	for (; i + 8 <= n; i += 8) {
+		__m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), h);
+	}
+	for (; i < n; ++i) dst[i] = static_cast<std::uint16_t>(_cvtss_sh(src[i], _MM_FROUND_TO_NEAREST_INT));
+#else
+	for (; i < n; ++i) dst[i] = float_to_binary16_portable(src[i]);
+#endif
+}
+
+}} // namespace sw::universal
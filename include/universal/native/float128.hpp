@@ -0,0 +1,88 @@
+#pragma once
+// float128.hpp: IEEE-754 binary128 arithmetic through the compiler's __float128 type
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <universal/utility/bit_cast.hpp>
+
+/*
+ GCC and Clang provide __float128 on x86-64, an IEEE-754 binary128 type that the compiler lowers to the
+ soft-float routines of libgcc or compiler-rt, whose basic operations are correctly rounded. glibc 2.26
+ and later adds the correctly rounded sqrtf128 and fmaf128 to libm, so libquadmath is not needed.
+ The type is only used when both are present, which glibc signals through __HAVE_FLOAT128.
+
+ The native_* functions below extend the std:: functions that the hardware delegation of cfloat uses
+ to __float128, for which std::isnan, std::sqrt, std::fma, and std::numeric_limits are not defined
+ in ISO C++ mode.
+ */
+
+#if defined(__SIZEOF_FLOAT128__) && defined(__HAVE_FLOAT128) && (__HAVE_FLOAT128 == 1)
+#define UNIVERSAL_NATIVE_FLOAT128 1
+#else
+#define UNIVERSAL_NATIVE_FLOAT128 0
+#endif
+
+namespace sw { namespace universal {
+
+#if UNIVERSAL_NATIVE_FLOAT128
+__extension__ typedef __float128 native_float128;
+__extension__ typedef unsigned __int128 native_uint128;
+
+inline native_float128 float128_infinity(bool negative = false) noexcept {
+	native_uint128 raw = native_uint128(0x7FFFu) << 112;
+	if (negative) raw |= native_uint128(1u) << 127;
+	return sw::bit_cast<native_float128>(raw);
+}
+inline native_float128 float128_quiet_nan() noexcept {
+	return sw::bit_cast<native_float128>(native_uint128(0xFFFFu) << 111);
+}
+inline native_float128 float128_sqrt(native_float128 v) noexcept { return sqrtf128(v); }
+inline native_float128 float128_fma(native_float128 x, native_float128 y, native_float128 z) noexcept { return fmaf128(x, y, z); }
+#endif
+
+template<typename Real>
+inline bool native_isnan(Real v) noexcept {
+#if UNIVERSAL_NATIVE_FLOAT128
+	if constexpr (std::is_same_v<Real, native_float128>) return __builtin_isnan(v); else
+#endif
+	return std::isnan(v);
+}
+
+template<typename Real>
+inline Real native_sqrt(Real v) noexcept {
+#if UNIVERSAL_NATIVE_FLOAT128
+	if constexpr (std::is_same_v<Real, native_float128>) return float128_sqrt(v); else
+#endif
+	return std::sqrt(v);
+}
+
+template<typename Real>
+inline Real native_fma(Real x, Real y, Real z) noexcept {
+#if UNIVERSAL_NATIVE_FLOAT128
+	if constexpr (std::is_same_v<Real, native_float128>) return float128_fma(x, y, z); else
+#endif
+	return std::fma(x, y, z);
+}
+
+template<typename Real>
+inline Real native_infinity(bool negative = false) noexcept {
+#if UNIVERSAL_NATIVE_FLOAT128
+	if constexpr (std::is_same_v<Real, native_float128>) return float128_infinity(negative); else
+#endif
+	return (negative ? -std::numeric_limits<Real>::infinity() : std::numeric_limits<Real>::infinity());
+}
+
+template<typename Real>
+inline Real native_quiet_nan() noexcept {
+#if UNIVERSAL_NATIVE_FLOAT128
+	if constexpr (std::is_same_v<Real, native_float128>) return float128_quiet_nan(); else
+#endif
+	return std::numeric_limits<Real>::quiet_NaN();
+}
+
+}} // namespace sw::universal
@@ -5,6 +5,7 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <cstdint>
+#include <cmath>
 #include <sstream>
 #include <string>
 #include <type_traits>
@@ -138,6 +139,20 @@ inline int64_t fastipow(int64_t base, uint8_t exp) {
 	}
 }
 
+/// <summary>
+/// integer square root: the largest q such that q * q <= n, for n < 2^63.
+/// The double precision square root is within one of the result, and the
+/// correction steps make it exact.
+/// </summary>
+/// <param name="n">radicand</param>
+/// <returns>floor(sqrt(n))</returns>
+inline uint64_t isqrt(uint64_t n) {
+	uint64_t q = static_cast<uint64_t>(std::sqrt(static_cast<double>(n)));
+	while (q * q > n) --q;
+	while ((q + 1) * (q + 1) <= n) ++q;
+	return q;
+}
+
 ////////////////// string operators
 
 // generate a binary string for a native integer
@@ -0,0 +1,188 @@
+#pragma once
+// limb_arithmetic.hpp: carry-propagating primitives for multi-limb arithmetic on native unsigned integers
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <bit>
+#include <type_traits>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+/*
+ Limb primitives used by the block-based number systems.
+
+ For limbs of 8, 16, and 32 bits the carry and the upper half of a product
+ can be captured by promoting to uint64_t. Limbs of 64 bits need either a
+ 128-bit native integer (GCC/Clang: unsigned __int128), a compiler intrinsic
+ (MSVC x64: _umul128), or a portable 32-bit decomposition. The same holds
+ for the two-by-one limb division that drives the normalized long division.
+ */
+
+#if defined(__SIZEOF_INT128__)
+#define UNIVERSAL_NATIVE_UINT128 1
+#else
+#define UNIVERSAL_NATIVE_UINT128 0
+#endif
+
+namespace sw { namespace universal {
+
+#if UNIVERSAL_NATIVE_UINT128
+__extension__ typedef unsigned __int128 uint128_native;
+#endif
+
+// add with carry: returns the limb a + b + carry, and updates carry with the carry out of the limb
+template<typename Limb>
+constexpr Limb addcarry(Limb a, Limb b, bool& carry) noexcept {
+	static_assert(std::is_unsigned_v<Limb>, "addcarry requires an unsigned limb type");
+	if constexpr (sizeof(Limb) < sizeof(std::uint64_t)) {
+		constexpr unsigned bitsInLimb = sizeof(Limb) * 8;
+		std::uint64_t sum = static_cast<std::uint64_t>(a) + static_cast<std::uint64_t>(b) + (carry ? 1ull : 0ull);
+		carry = (sum >> bitsInLimb) != 0;
+		return static_cast<Limb>(sum);
+	}
+	else {
+		// compilers recognize this sequence and emit add-with-carry instructions
+		Limb sum = static_cast<Limb>(a + b);
+		bool c1 = (sum < a);
+		Limb result = static_cast<Limb>(sum + (carry ? 1u : 0u));
+		bool c2 = (result < sum);
+		carry = c1 || c2;
+		return result;
+	}
+}
+
+// subtract with borrow: returns the limb a - b - borrow, and updates borrow with the borrow into the limb
+template<typename Limb>
+constexpr Limb subborrow(Limb a, Limb b, bool& borrow) noexcept {
+	static_assert(std::is_unsigned_v<Limb>, "subborrow requires an unsigned limb type");
+	Limb diff = static_cast<Limb>(a - b);
+	bool b1 = (a < b);
+	Limb result = static_cast<Limb>(diff - (borrow ? 1u : 0u));
+	bool b2 = (diff < result);
+	borrow = b1 || b2;
+	return result;
+}
+
+// full-width product: returns the lower limb of a * b, and the upper limb in hi
+template<typename Limb>
+constexpr Limb mulwide(Limb a, Limb b, Limb& hi) noexcept {
+	static_assert(std::is_unsigned_v<Limb>, "mulwide requires an unsigned limb type");
+	if constexpr (sizeof(Limb) < sizeof(std::uint64_t)) {
+		constexpr unsigned bitsInLimb = sizeof(Limb) * 8;
+		std::uint64_t product = static_cast<std::uint64_t>(a) * static_cast<std::uint64_t>(b);
+		hi = static_cast<Limb>(product >> bitsInLimb);
+		return static_cast<Limb>(product);
+	}
+	else {
+#if UNIVERSAL_NATIVE_UINT128
+		uint128_native product = static_cast<uint128_native>(a) * static_cast<uint128_native>(b);
+		hi = static_cast<Limb>(product >> 64);
+		return static_cast<Limb>(product);
+#else
+#if defined(_MSC_VER) && defined(_M_X64)
+		if (!std::is_constant_evaluated()) {
+			unsigned __int64 upper;
+			Limb lower = _umul128(a, b, &upper);
+			hi = upper;
+			return lower;
+		}
+#endif
+		// portable decomposition into 32-bit halves
+		std::uint64_t a_lo = a & 0xFFFF'FFFFull, a_hi = a >> 32;
+		std::uint64_t b_lo = b & 0xFFFF'FFFFull, b_hi = b >> 32;
+		std::uint64_t lolo = a_lo * b_lo;
+		std::uint64_t hilo = a_hi * b_lo;
+		std::uint64_t lohi = a_lo * b_hi;
+		std::uint64_t hihi = a_hi * b_hi;
+		std::uint64_t cross = (lolo >> 32) + (hilo & 0xFFFF'FFFFull) + lohi;
+		hi = hihi + (hilo >> 32) + (cross >> 32);
+		return (cross << 32) | (lolo & 0xFFFF'FFFFull);
+#endif
+	}
+}
+
+// multiply-accumulate: returns the lower limb of a * b + addend + carry, and the upper limb in carry
+// the result always fits in two limbs: (2^n - 1)^2 + 2(2^n - 1) = 2^2n - 1
+template<typename Limb>
+constexpr Limb muladd(Limb a, Limb b, Limb addend, Limb& carry) noexcept {
+	static_assert(std::is_unsigned_v<Limb>, "muladd requires an unsigned limb type");
+	if constexpr (sizeof(Limb) < sizeof(std::uint64_t)) {
+		constexpr unsigned bitsInLimb = sizeof(Limb) * 8;
+		std::uint64_t segment = static_cast<std::uint64_t>(a) * static_cast<std::uint64_t>(b)
+			+ static_cast<std::uint64_t>(addend) + static_cast<std::uint64_t>(carry);
+		carry = static_cast<Limb>(segment >> bitsInLimb);
+		return static_cast<Limb>(segment);
+	}
+	else {
+#if UNIVERSAL_NATIVE_UINT128
+		uint128_native segment = static_cast<uint128_native>(a) * static_cast<uint128_native>(b)
+			+ static_cast<uint128_native>(addend) + static_cast<uint128_native>(carry);
+		carry = static_cast<Limb>(segment >> 64);
+		return static_cast<Limb>(segment);
+#else
+		Limb hi{ 0 };
+		Limb lo = mulwide(a, b, hi);
+		bool c{ false };
+		lo = addcarry(lo, addend, c);
+		hi += (c ? 1u : 0u);
+		c = false;
+		lo = addcarry(lo, carry, c);
+		hi += (c ? 1u : 0u);
+		carry = hi;
+		return lo;
+#endif
+	}
+}
+
+// two-by-one division: returns the limb quotient of (hi * B + lo) / d, and the remainder in rem
+// precondition: hi < d, so that the quotient fits in a single limb
+template<typename Limb>
+constexpr Limb divwide(Limb hi, Limb lo, Limb d, Limb& rem) noexcept {
+	static_assert(std::is_unsigned_v<Limb>, "divwide requires an unsigned limb type");
+	if constexpr (sizeof(Limb) < sizeof(std::uint64_t)) {
+		constexpr unsigned bitsInLimb = sizeof(Limb) * 8;
+		std::uint64_t dividend = (static_cast<std::uint64_t>(hi) << bitsInLimb) | static_cast<std::uint64_t>(lo);
+		std::uint64_t quotient = dividend / d;
+		rem = static_cast<Limb>(dividend - quotient * d);
+		return static_cast<Limb>(quotient);
+	}
+	else {
+#if UNIVERSAL_NATIVE_UINT128
+		uint128_native dividend = (static_cast<uint128_native>(hi) << 64) | static_cast<uint128_native>(lo);
+		Limb quotient = static_cast<Limb>(dividend / d);
+		rem = static_cast<Limb>(lo - quotient * d);
+		return quotient;
+#else
+		// portable normalized division on 32-bit digits, Hacker's Delight divlu
+		constexpr std::uint64_t b = 0x1'0000'0000ull;
+		int s = std::countl_zero(d);
+		d <<= s;
+		std::uint64_t un32 = (s == 0) ? hi : ((hi << s) | (lo >> (64 - s)));
+		std::uint64_t un10 = lo << s;
+		std::uint64_t vn1 = d >> 32, vn0 = d & 0xFFFF'FFFFull;
+		std::uint64_t un1 = un10 >> 32, un0 = un10 & 0xFFFF'FFFFull;
+		std::uint64_t q1 = un32 / vn1;
+		std::uint64_t rhat = un32 - q1 * vn1;
+		while (q1 >= b || q1 * vn0 > b * rhat + un1) {
+			--q1;
+			rhat += vn1;
+			if (rhat >= b) break;
+		}
+		std::uint64_t un21 = un32 * b + un1 - q1 * d;
+		std::uint64_t q0 = un21 / vn1;
+		rhat = un21 - q0 * vn1;
+		while (q0 >= b || q0 * vn0 > b * rhat + un0) {
+			--q0;
+			rhat += vn1;
+			if (rhat >= b) break;
+		}
+		rem = (un21 * b + un0 - q0 * d) >> s;
+		return q1 * b + q0;
+#endif
+	}
+}
+
+}} // namespace sw::universal
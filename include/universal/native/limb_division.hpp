@@ -0,0 +1,282 @@
+#pragma once
+// limb_division.hpp: normalized long division and Newton-Raphson division on arrays of native unsigned limbs
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <bit>
+#include <vector>
+#include <universal/native/limb_multiplication.hpp>
+
+/*
+ Division of an m-limb dividend u by an n-limb divisor v.
+
+ The base kernel is Knuth's Algorithm D (TAOCP Vol 2, 4.3.1): the divisor is
+ normalized so that its most significant bit is set, which guarantees that the
+ quotient limb estimated from the top two limbs of the running remainder is at
+ most two too large. The cost is O((m - n + 1) * n) limb operations.
+
+ For very wide divisors, the quotient is computed as u * (1/v) with a reciprocal
+ that is refined with Newton-Raphson iterations x' = x + x * (1 - v * x),
+ doubling the precision at each step. With Karatsuba multiplication the cost is
+ a small multiple of a single multiplication, which only beats Algorithm D when
+ the divisor is very wide: the crossover is set by LIMB_NEWTON_THRESHOLD in limbs.
+ */
+#ifndef LIMB_NEWTON_THRESHOLD
+#define LIMB_NEWTON_THRESHOLD 1024
+#endif
+
+namespace sw { namespace universal {
+
+// number of significant limbs in a[0, n)
+template<typename Limb>
+constexpr unsigned limb_significant(const Limb* a, unsigned n) noexcept {
+	while (n > 0 && a[n - 1] == Limb(0)) --n;
+	return n;
+}
+
+// compare a[0, n) and b[0, n): returns -1, 0, or 1
+template<typename Limb>
+constexpr int limb_compare(const Limb* a, const Limb* b, unsigned n) noexcept {
+	for (unsigned i = n; i > 0; --i) {
+		if (a[i - 1] != b[i - 1]) return (a[i - 1] < b[i - 1]) ? -1 : 1;
+	}
+	return 0;
+}
+
+// r[0, n) = a[0, n) << shift, 0 <= shift < bitsInLimb: returns the bits shifted out of the top limb
+template<typename Limb>
+constexpr Limb limb_shl(const Limb* a, unsigned n, int shift, Limb* r) noexcept {
+	constexpr int bitsInLimb = static_cast<int>(sizeof(Limb) * 8);
+	if (shift == 0) {
+		for (unsigned i = n; i > 0; --i) r[i - 1] = a[i - 1];
+		return Limb(0);
+	}
+	Limb out = static_cast<Limb>(a[n - 1] >> (bitsInLimb - shift));
+	for (unsigned i = n - 1; i > 0; --i) {
+		r[i] = static_cast<Limb>((a[i] << shift) | (a[i - 1] >> (bitsInLimb - shift)));
+	}
+	r[0] = static_cast<Limb>(a[0] << shift);
+	return out;
+}
+
+// r[0, n) = a[0, n) >> shift, with the bits of a[n] shifted in at the top, 0 <= shift < bitsInLimb
+template<typename Limb>
+constexpr void limb_shr(const Limb* a, unsigned n, int shift, Limb* r) noexcept {
+	constexpr int bitsInLimb = static_cast<int>(sizeof(Limb) * 8);
+	if (shift == 0) {
+		for (unsigned i = 0; i < n; ++i) r[i] = a[i];
+		return;
+	}
+	for (unsigned i = 0; i < n; ++i) {
+		r[i] = static_cast<Limb>((a[i] >> shift) | (a[i + 1] << (bitsInLimb - shift)));
+	}
+}
+
+// q[0, m) = u[0, m) / d, returns the remainder u mod d
+template<typename Limb>
+constexpr Limb limb_divmod_1(const Limb* u, unsigned m, Limb d, Limb* q) noexcept {
+	Limb rem{ 0 };
+	for (unsigned j = m; j > 0; --j) {
+		q[j - 1] = divwide(rem, u[j - 1], d, rem);
+	}
+	return rem;
+}
+
+// number of scratch limbs required by limb_divmod_knuth
+constexpr unsigned knuth_scratch_size(unsigned m, unsigned n) noexcept {
+	return m + 1 + n;
+}
+
+// Algorithm D: q[0, m - n + 1) = u[0, m) / v[0, n), r[0, n) = u mod v
+// preconditions: m >= n >= 2 and v[n - 1] != 0, scratch must hold knuth_scratch_size(m, n) limbs
+template<typename Limb>
+constexpr void limb_divmod_knuth(const Limb* u, unsigned m, const Limb* v, unsigned n, Limb* q, Limb* r, Limb* scratch) noexcept {
+	Limb* un = scratch;          // normalized dividend, m + 1 limbs
+	Limb* vn = scratch + m + 1;  // normalized divisor, n limbs
+	int shift = std::countl_zero(v[n - 1]);
+	limb_shl(v, n, shift, vn);
+	un[m] = limb_shl(u, m, shift, un);
+
+	Limb vtop = vn[n - 1];
+	Limb vnext = vn[n - 2];
+	for (unsigned j = m - n + 1; j > 0; --j) {
+		unsigned k = j - 1;  // position of the quotient limb
+		// estimate the quotient limb from the top two limbs of the remainder
+		Limb qhat{ 0 }, rhat{ 0 };
+		bool rhatOverflow{ false };
+		if (un[k + n] >= vtop) {  // the remainder invariant guarantees un[k + n] <= vtop
+			qhat = static_cast<Limb>(~Limb(0));
+			rhat = addcarry(un[k + n - 1], vtop, rhatOverflow);
+		}
+		else {
+			qhat = divwide(un[k + n], un[k + n - 1], vtop, rhat);
+		}
+		// refine with the next limb of the divisor: at most two corrections
+		while (!rhatOverflow) {
+			Limb phi{ 0 };
+			Limb plo = mulwide(qhat, vnext, phi);
+			if (phi > rhat || (phi == rhat && plo > un[k + n - 2])) {
+				--qhat;
+				rhat = addcarry(rhat, vtop, rhatOverflow);
+			}
+			else {
+				break;
+			}
+		}
+		// multiply and subtract
+		Limb carry{ 0 };
+		bool borrow{ false };
+		for (unsigned i = 0; i < n; ++i) {
+			Limb p = muladd(qhat, vn[i], Limb(0), carry);
+			un[k + i] = subborrow(un[k + i], p, borrow);
+		}
+		un[k + n] = subborrow(un[k + n], carry, borrow);
+		if (borrow) {  // the estimate was one too large: add back
+			--qhat;
+			bool c{ false };
+			for (unsigned i = 0; i < n; ++i) un[k + i] = addcarry(un[k + i], vn[i], c);
+			un[k + n] = static_cast<Limb>(un[k + n] + (c ? 1u : 0u));
+		}
+		q[k] = qhat;
+	}
+	// unnormalize the remainder
+	limb_shr(un, n, shift, r);
+}
+
+// full product of operands of unequal length: r[0, na + nb) = a[0, na) * b[0, nb)
+template<unsigned karatsubaThreshold = LIMB_KARATSUBA_THRESHOLD, typename Limb>
+inline void limb_mul_unbalanced(const Limb* a, unsigned na, const Limb* b, unsigned nb, Limb* r) {
+	unsigned n = (na > nb ? na : nb);
+	if (n < karatsubaThreshold) {
+		limb_mul_schoolbook(a, na, b, nb, r);
+		return;
+	}
+	std::vector<Limb> pa(n, Limb(0)), pb(n, Limb(0)), product(2 * n), scratch(karatsuba_scratch_size<karatsubaThreshold>(n) + 1);
+	for (unsigned i = 0; i < na; ++i) pa[i] = a[i];
+	for (unsigned i = 0; i < nb; ++i) pb[i] = b[i];
+	limb_mul_karatsuba<karatsubaThreshold>(pa.data(), pb.data(), n, product.data(), scratch.data());
+	for (unsigned i = 0; i < na + nb; ++i) r[i] = product[i];
+}
+
+// reciprocal of a normalized divisor: x[0, n + 1) ~ B^(2n) / v[0, n), with an error of a few units in the last limb
+// precondition: the most significant bit of v[n - 1] is set
+template<unsigned karatsubaThreshold = LIMB_KARATSUBA_THRESHOLD, typename Limb>
+inline void limb_reciprocal(const Limb* v, unsigned n, Limb* x) {
+	constexpr unsigned exactLimbs = 8;
+	if (n <= exactLimbs) {
+		// the reciprocal at low precision is computed exactly with Algorithm D
+		std::vector<Limb> numerator(2 * n + 1, Limb(0)), quotient(n + 2), rem(n), scratch(knuth_scratch_size(2 * n + 1, n));
+		numerator[2 * n] = Limb(1);
+		if (n == 1) {
+			limb_divmod_1(numerator.data(), 3u, v[0], quotient.data());
+		}
+		else {
+			limb_divmod_knuth(numerator.data(), 2 * n + 1, v, n, quotient.data(), rem.data(), scratch.data());
+		}
+		// B^(2n) / v < 2 B^n, so the top quotient limb is zero
+		for (unsigned i = 0; i <= n; ++i) x[i] = quotient[i];
+		return;
+	}
+	// reciprocal of the top p limbs of v, with p chosen such that the Newton step to n limbs
+	// leaves a guard limb: the squared error of the previous precision stays below one unit
+	unsigned p = (n + 2) / 2;
+	std::vector<Limb> xp(p + 1);
+	limb_reciprocal<karatsubaThreshold>(v + (n - p), p, xp.data());
+
+	// x0 = xp * B^(n - p)
+	std::vector<Limb> x0(n + 1, Limb(0));
+	for (unsigned i = 0; i <= p; ++i) x0[n - p + i] = xp[i];
+
+	// e = B^(2n) - v * x0, a signed residual that is small relative to B^(2n)
+	std::vector<Limb> vx(2 * n + 1);
+	limb_mul_unbalanced<karatsubaThreshold>(v, n, x0.data(), n + 1, vx.data());
+	std::vector<Limb> e(2 * n + 1, Limb(0));
+	e[2 * n] = Limb(1);
+	bool negative = (limb_compare(vx.data(), e.data(), 2 * n + 1) > 0);
+	if (negative) {
+		limb_sub(vx.data(), 2 * n + 1, e.data(), 2 * n + 1);
+		e.swap(vx);
+	}
+	else {
+		limb_sub(e.data(), 2 * n + 1, vx.data(), 2 * n + 1);
+	}
+	// only the top n + 1 limbs of the residual contribute to the correction x0 * e / B^(2n)
+	std::vector<Limb> correction(2 * n + 2);
+	limb_mul_unbalanced<karatsubaThreshold>(x0.data(), n + 1, e.data() + (n - 1), n + 1, correction.data());
+	const Limb* delta = correction.data() + (n + 1);
+	for (unsigned i = 0; i <= n; ++i) x[i] = x0[i];
+	if (negative) {
+		limb_sub(x, n + 1, delta, n + 1);
+	}
+	else {
+		limb_add(x, n + 1, delta, n + 1);
+	}
+}
+
+// Newton-Raphson division: q[0, m - n + 1) = u[0, m) / v[0, n), r[0, n) = u mod v
+// preconditions: 2 <= n <= m < 2n and v[n - 1] != 0
+template<unsigned karatsubaThreshold = LIMB_KARATSUBA_THRESHOLD, typename Limb>
+inline void limb_divmod_newton(const Limb* u, unsigned m, const Limb* v, unsigned n, Limb* q, Limb* r) {
+	// normalize so that the most significant bit of the divisor is set, the quotient is unchanged
+	int shift = std::countl_zero(v[n - 1]);
+	std::vector<Limb> vn(n), un(2 * n, Limb(0));
+	limb_shl(v, n, shift, vn.data());
+	un[m] = limb_shl(u, m, shift, un.data());
+
+	std::vector<Limb> x(n + 1);
+	limb_reciprocal<karatsubaThreshold>(vn.data(), n, x.data());
+
+	// qhat = (un / B^(n-1)) * x / B^(n+1): dropping the lower n - 1 limbs of un costs less than a unit
+	std::vector<Limb> product(2 * n + 2);
+	limb_mul_unbalanced<karatsubaThreshold>(un.data() + (n - 1), n + 1, x.data(), n + 1, product.data());
+	std::vector<Limb> qhat(n + 1);
+	for (unsigned i = 0; i <= n; ++i) qhat[i] = product[n + 1 + i];
+
+	// correct qhat with the exact remainder un - qhat * vn: qhat is off by a few units at most
+	std::vector<Limb> qv(2 * n + 1), one(1, Limb(1));
+	limb_mul_unbalanced<karatsubaThreshold>(qhat.data(), n + 1, vn.data(), n, qv.data());
+	un.push_back(Limb(0));
+	while (limb_compare(qv.data(), un.data(), 2 * n + 1) > 0) {
+		limb_sub(qhat.data(), n + 1, one.data(), 1u);
+		limb_sub(qv.data(), 2 * n + 1, vn.data(), n);
+	}
+	limb_sub(un.data(), 2 * n + 1, qv.data(), 2 * n + 1);
+	while (limb_significant(un.data(), 2 * n + 1) > n || limb_compare(un.data(), vn.data(), n) >= 0) {
+		limb_add(qhat.data(), n + 1, one.data(), 1u);
+		limb_sub(un.data(), 2 * n + 1, vn.data(), n);
+	}
+	for (unsigned i = 0; i < m - n + 1; ++i) q[i] = qhat[i];
+	un[n] = Limb(0);
+	limb_shr(un.data(), n, shift, r);
+}
+
+// number of scratch limbs required by limb_divmod
+constexpr unsigned divmod_scratch_size(unsigned m, unsigned n) noexcept {
+	return knuth_scratch_size(m, n);
+}
+
+// q[0, m) = u[0, m) / v[0, n), r[0, n) = u mod v, for any m and n, scratch must hold divmod_scratch_size(m, n) limbs
+// precondition: v != 0
+template<unsigned newtonThreshold = LIMB_NEWTON_THRESHOLD, unsigned karatsubaThreshold = LIMB_KARATSUBA_THRESHOLD, typename Limb>
+inline void limb_divmod(const Limb* u, unsigned m, const Limb* v, unsigned n, Limb* q, Limb* r, Limb* scratch) {
+	for (unsigned i = 0; i < m; ++i) q[i] = Limb(0);
+	for (unsigned i = 0; i < n; ++i) r[i] = Limb(0);
+	unsigned mu = limb_significant(u, m);
+	unsigned nv = limb_significant(v, n);
+	if (mu < nv) {  // u < v
+		for (unsigned i = 0; i < mu; ++i) r[i] = u[i];
+		return;
+	}
+	if (nv == 1) {
+		r[0] = limb_divmod_1(u, mu, v[0], q);
+	}
+	else if (nv >= newtonThreshold && mu < 2 * nv) {
+		limb_divmod_newton<karatsubaThreshold>(u, mu, v, nv, q, r);
+	}
+	else {
+		limb_divmod_knuth(u, mu, v, nv, q, r, scratch);
+	}
+}
+
+}} // namespace sw::universal
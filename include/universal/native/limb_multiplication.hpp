@@ -0,0 +1,167 @@
+#pragma once
+// limb_multiplication.hpp: schoolbook and Karatsuba multiplication kernels on arrays of native unsigned limbs
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/native/limb_arithmetic.hpp>
+
+/*
+ The block-based integer types compute a modular product: only the lower nrBlocks
+ limbs of the full product are kept. Below the Karatsuba threshold the truncated
+ schoolbook loop is the fastest kernel. Above the threshold the truncated product
+ of two n-limb operands is decomposed as
+
+   a * b mod B^n = a0*b0 mod B^n + B^h * (a0*b1 + a1*b0 mod B^(n-h))
+
+ where the full product a0*b0 is computed with Karatsuba, and the two cross terms
+ are truncated products of half the size that recurse into the same kernel.
+ Since the two cross terms cost as much as a schoolbook product of half the size,
+ the truncated product only breaks even at a multiple of the full product threshold:
+ limb_mullo_threshold is four times the Karatsuba threshold.
+
+ The threshold is expressed in limbs and can be tuned at compile time by defining
+ LIMB_KARATSUBA_THRESHOLD before including the number system headers.
+ The crossover benchmark in benchmark/performance/arithmetic/integer/karatsuba.cpp
+ measures the kernels for different thresholds.
+ */
+#ifndef LIMB_KARATSUBA_THRESHOLD
+#define LIMB_KARATSUBA_THRESHOLD 32
+#endif
+
+namespace sw { namespace universal {
+
+static_assert(LIMB_KARATSUBA_THRESHOLD >= 4, "LIMB_KARATSUBA_THRESHOLD needs to be at least 4 limbs for the recursion to terminate");
+
+// r[0, n) += a[0, m), m <= n: returns the carry out of r
+template<typename Limb>
+constexpr bool limb_add(Limb* r, unsigned n, const Limb* a, unsigned m) noexcept {
+	bool carry{ false };
+	unsigned i = 0;
+	for (; i < m; ++i) r[i] = addcarry(r[i], a[i], carry);
+	for (; carry && i < n; ++i) r[i] = addcarry(r[i], Limb(0), carry);
+	return carry;
+}
+
+// r[0, n) -= a[0, m), m <= n: returns the borrow out of r
+template<typename Limb>
+constexpr bool limb_sub(Limb* r, unsigned n, const Limb* a, unsigned m) noexcept {
+	bool borrow{ false };
+	unsigned i = 0;
+	for (; i < m; ++i) r[i] = subborrow(r[i], a[i], borrow);
+	for (; borrow && i < n; ++i) r[i] = subborrow(r[i], Limb(0), borrow);
+	return borrow;
+}
+
+// full product: r[0, na + nb) = a[0, na) * b[0, nb)
+template<typename Limb>
+constexpr void limb_mul_schoolbook(const Limb* a, unsigned na, const Limb* b, unsigned nb, Limb* r) noexcept {
+	for (unsigned i = 0; i < na + nb; ++i) r[i] = Limb(0);
+	for (unsigned i = 0; i < na; ++i) {
+		Limb carry{ 0 };
+		Limb limb = a[i];
+		for (unsigned j = 0; j < nb; ++j) {
+			r[i + j] = muladd(limb, b[j], r[i + j], carry);
+		}
+		r[i + nb] = carry;
+	}
+}
+
+// truncated product: r[0, n) = a[0, n) * b[0, n) mod B^n
+template<typename Limb>
+constexpr void limb_mullo_schoolbook(const Limb* a, const Limb* b, unsigned n, Limb* r) noexcept {
+	for (unsigned i = 0; i < n; ++i) r[i] = Limb(0);
+	for (unsigned i = 0; i < n; ++i) {
+		Limb carry{ 0 };
+		Limb limb = a[i];
+		for (unsigned j = 0; i + j < n; ++j) {
+			r[i + j] = muladd(limb, b[j], r[i + j], carry);
+		}
+	}
+}
+
+// number of scratch limbs required by limb_mul_karatsuba for n-limb operands
+template<unsigned threshold = LIMB_KARATSUBA_THRESHOLD>
+constexpr unsigned karatsuba_scratch_size(unsigned n) noexcept {
+	if (n < threshold) return 0;
+	unsigned l = n - n / 2;
+	// a0 + a1 and b0 + b1 take l+1 limbs each, their product 2(l+1) limbs, followed by the scratch of that product
+	return 4 * (l + 1) + karatsuba_scratch_size<threshold>(l + 1);
+}
+
+// full product: r[0, 2n) = a[0, n) * b[0, n), scratch must hold karatsuba_scratch_size(n) limbs
+template<unsigned threshold = LIMB_KARATSUBA_THRESHOLD, typename Limb>
+constexpr void limb_mul_karatsuba(const Limb* a, const Limb* b, unsigned n, Limb* r, Limb* scratch) noexcept {
+	if (n < threshold) {
+		limb_mul_schoolbook(a, n, b, n, r);
+		return;
+	}
+	unsigned h = n / 2;  // limbs in the lower half
+	unsigned l = n - h;  // limbs in the upper half, l >= h
+	const Limb* a0 = a;
+	const Limb* a1 = a + h;
+	const Limb* b0 = b;
+	const Limb* b1 = b + h;
+
+	// z0 = a0 * b0 in r[0, 2h), z2 = a1 * b1 in r[2h, 2n)
+	limb_mul_karatsuba<threshold>(a0, b0, h, r, scratch);
+	limb_mul_karatsuba<threshold>(a1, b1, l, r + 2 * h, scratch);
+
+	// z1 = (a0 + a1) * (b0 + b1) - z0 - z2 = a0*b1 + a1*b0
+	Limb* sa = scratch;
+	Limb* sb = scratch + (l + 1);
+	Limb* z1 = scratch + 2 * (l + 1);
+	for (unsigned i = 0; i < l; ++i) {
+		sa[i] = a1[i];
+		sb[i] = b1[i];
+	}
+	sa[l] = Limb(limb_add(sa, l, a0, h) ? 1 : 0);
+	sb[l] = Limb(limb_add(sb, l, b0, h) ? 1 : 0);
+	limb_mul_karatsuba<threshold>(sa, sb, l + 1, z1, scratch + 4 * (l + 1));
+	limb_sub(z1, 2 * (l + 1), r, 2 * h);
+	limb_sub(z1, 2 * (l + 1), r + 2 * h, 2 * l);
+
+	// r += z1 * B^h
+	limb_add(r + h, 2 * n - h, z1, 2 * (l + 1));
+}
+
+// number of limbs below which the truncated product uses the schoolbook kernel
+template<unsigned threshold = LIMB_KARATSUBA_THRESHOLD>
+inline constexpr unsigned limb_mullo_threshold = 4 * threshold;
+
+// number of scratch limbs required by limb_mullo for n-limb operands
+template<unsigned threshold = LIMB_KARATSUBA_THRESHOLD>
+constexpr unsigned mullo_scratch_size(unsigned n) noexcept {
+	if (n < limb_mullo_threshold<threshold>) return 0;
+	unsigned h = n - n / 2;
+	unsigned m = n / 2;
+	unsigned fullScratch = karatsuba_scratch_size<threshold>(h);
+	unsigned loScratch   = mullo_scratch_size<threshold>(m);
+	return 2 * h + m + (fullScratch > loScratch ? fullScratch : loScratch);
+}
+
+// truncated product: r[0, n) = a[0, n) * b[0, n) mod B^n, scratch must hold mullo_scratch_size(n) limbs
+template<unsigned threshold = LIMB_KARATSUBA_THRESHOLD, typename Limb>
+constexpr void limb_mullo(const Limb* a, const Limb* b, unsigned n, Limb* r, Limb* scratch) noexcept {
+	if (n < limb_mullo_threshold<threshold>) {
+		limb_mullo_schoolbook(a, b, n, r);
+		return;
+	}
+	unsigned h = n - n / 2;  // limbs in the lower half, h >= m
+	unsigned m = n / 2;      // limbs in the upper half
+	Limb* full = scratch;
+	Limb* cross = scratch + 2 * h;
+	Limb* next = scratch + 2 * h + m;
+
+	// a0 * b0 contributes all its limbs below B^n
+	limb_mul_karatsuba<threshold>(a, b, h, full, next);
+	for (unsigned i = 0; i < n; ++i) r[i] = full[i];
+
+	// the cross terms only contribute their lower m limbs at B^h
+	limb_mullo<threshold>(a, b + h, m, cross, next);
+	limb_add(r + h, m, cross, m);
+	limb_mullo<threshold>(a + h, b, m, cross, next);
+	limb_add(r + h, m, cross, m);
+}
+
+}} // namespace sw::universal
@@ -0,0 +1,60 @@
+#pragma once
+// array_conversion.hpp: batched conversions between arrays of cfloats of different configurations
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace sw { namespace universal {
+
+// source configurations up to this size are converted through a table of all their encodings
+constexpr unsigned CFLOAT_CONVERSION_TABLE_NBITS = 12;
+
+/// <summary>
+/// convert an array of cfloats to another cfloat configuration, for example when widening
+/// fp8 weights to a half-precision or single-precision accumulator.
+/// Narrow source configurations are converted through a lookup table of all their encodings,
+/// which is built on first use, and wider source configurations element by element.
+/// Each element is rounded once, as with convert(src, tgt).
+/// </summary>
+template<unsigned srcbits, unsigned srces, typename srcbt, bool srcSubnormals, bool srcSupernormals, bool srcSaturating,
+	unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
+inline void convert(const cfloat<srcbits, srces, srcbt, srcSubnormals, srcSupernormals, srcSaturating>* src, cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>* dst, std::size_t n) {
+	using Source = cfloat<srcbits, srces, srcbt, srcSubnormals, srcSupernormals, srcSaturating>;
+	using Target = cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>;
+	if constexpr (srcbits <= CFLOAT_CONVERSION_TABLE_NBITS) {
+		constexpr std::size_t NR_ENCODINGS = (std::size_t(1) << srcbits);
+		static const std::vector<Target> table = [] {
+			std::vector<Target> t(NR_ENCODINGS);
+			Source a;
+			for (std::size_t i = 0; i < NR_ENCODINGS; ++i) {
+				a.setbits(i);
+				convert(a, t[i]);
+			}
+			return t;
+		}();
+		for (std::size_t i = 0; i < n; ++i) {
+			std::size_t index = 0;
+			for (unsigned b = 0; b < Source::nrBlocks; ++b) {
+				index |= std::size_t(src[i].block(b)) << (b * Source::bitsInBlock);
+			}
+			dst[i] = table[index & (NR_ENCODINGS - 1)];
+		}
+	}
+	else {
+		for (std::size_t i = 0; i < n; ++i) convert(src[i], dst[i]);
+	}
+}
+
+// vector form of the batched conversion
+template<unsigned srcbits, unsigned srces, typename srcbt, bool srcSubnormals, bool srcSupernormals, bool srcSaturating,
+	unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
+inline void convert(const std::vector< cfloat<srcbits, srces, srcbt, srcSubnormals, srcSupernormals, srcSaturating> >& src, std::vector< cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> >& dst) {
+	dst.resize(src.size());
+	convert(src.data(), dst.data(), src.size());
+}
+
+}} // namespace sw::universal
@@ -38,11 +38,35 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////
 // enable native sqrt implementation
-// 
+// CFLOAT_NATIVE_SQRT when set will also compute the square root of the IEEE-754
+// equivalent configurations on the blocktriple instead of delegating to the hardware
 #if !defined(CFLOAT_NATIVE_SQRT)
 #define CFLOAT_NATIVE_SQRT 0
 #endif
 
+////////////////////////////////////////////////////////////////////////////////////////
+// enable native integer arithmetic for configurations with nbits <= 64
+// CFLOAT_FAST_SPECIALIZATION when set will turn on the native integer fast paths
+// of add, sub, mul, and div; CFLOAT_NATIVE_ARITHMETIC offers the same control as a 0/1 switch
+#ifdef CFLOAT_FAST_SPECIALIZATION
+#define CFLOAT_NATIVE_ARITHMETIC 1
+#endif
+#if !defined(CFLOAT_NATIVE_ARITHMETIC)
+#define CFLOAT_NATIVE_ARITHMETIC 0
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////
+// delegate the arithmetic of the IEEE-754 equivalent configurations,
+// cfloat<32,8,bt,true,false,false> and cfloat<64,11,bt,true,false,false>, to the floating-point hardware,
+// and compute the arithmetic of half, cfloat<16,5,bt,true,false,false>, in float
+#if !defined(CFLOAT_HARDWARE_DELEGATION)
+#define CFLOAT_HARDWARE_DELEGATION 1
+#endif
+// compute the arithmetic of quad, cfloat<128,15,bt,true,false,false>, in __float128 when the compiler provides it
+#if !defined(CFLOAT_FLOAT128_DELEGATION)
+#define CFLOAT_FLOAT128_DELEGATION 1
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////////////
 // bring in the trait functions
 #include <universal/traits/number_traits.hpp>
@@ -54,6 +78,9 @@
 #include <universal/number/cfloat/exceptions.hpp>
 #include <universal/number/cfloat/cfloat_fwd.hpp>
 #include <universal/number/cfloat/cfloat_impl.hpp>
+#include <universal/number/cfloat/native_arithmetic.hpp>
+#include <universal/number/cfloat/half_conversion.hpp>
+#include <universal/number/cfloat/array_conversion.hpp>
 #include <universal/traits/cfloat_traits.hpp>
 #include <universal/number/cfloat/numeric_limits.hpp>
 
@@ -61,6 +88,11 @@
 #include <universal/number/cfloat/attributes.hpp>
 #include <universal/number/cfloat/manipulators.hpp>
 
+///////////////////////////////////////////////////////////////////////////////////////
+/// the quire that enables the fused dot product
+#include <universal/number/cfloat/quire.hpp>
+#include <universal/number/cfloat/fdp.hpp>
+
 ///////////////////////////////////////////////////////////////////////////////////////
 /// elementary math functions library
 #include <universal/number/cfloat/mathlib.hpp>
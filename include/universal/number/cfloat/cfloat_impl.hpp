@@ -20,8 +20,14 @@
 // number system include file <universal/number/cfloat/cfloat.hpp>
 // 
 // supporting types and functions
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <type_traits>
 #include <universal/native/ieee754.hpp>
 #include <universal/native/subnormal.hpp>
+#include <universal/native/binary16.hpp>
+#include <universal/native/float128.hpp>
 #include <universal/utility/find_msb.hpp>
 #include <universal/number/shared/nan_encoding.hpp>
 #include <universal/number/shared/infinite_encoding.hpp>
@@ -43,6 +49,21 @@
 #define TRACE_CONVERSION 0
 #endif
 
+#ifdef CFLOAT_FAST_SPECIALIZATION
+#define CFLOAT_NATIVE_ARITHMETIC 1
+#endif
+#ifndef CFLOAT_NATIVE_ARITHMETIC
+#define CFLOAT_NATIVE_ARITHMETIC 0
+#endif
+
+#ifndef CFLOAT_HARDWARE_DELEGATION
+#define CFLOAT_HARDWARE_DELEGATION 1
+#endif
+
+#ifndef CFLOAT_FLOAT128_DELEGATION
+#define CFLOAT_FLOAT128_DELEGATION 1
+#endif
+
 namespace sw { namespace universal {
 
 /*
@@ -251,7 +272,7 @@ inline /*constexpr*/ void convert(const blocktriple<srcbits, op, bt>& src, cfloa
 			tgt.setbits(raw);
 //			std::cout << "raw bits (all)   " << to_binary(raw) << '\n';
 			if constexpr (isSaturating) {
-				if (tgt.isnan()) {
+				if (tgt.isnan() || tgt.isinf()) {  // without supernormals, rounding up from maxpos yields an inf encoding
 					if (src.sign()) {
 						tgt.maxneg();	// map back to maxneg
 					}
@@ -281,7 +302,8 @@ inline /*constexpr*/ void convert(const blocktriple<srcbits, op, bt>& src, cfloa
 			//std::cout << "fraction bits : " << to_binary(fracbits, true) << '\n';
 			tgt.clear();
 			//std::cout << "initial state : " << to_binary(tgt) << " : " << tgt << '\n';
-			for (unsigned b = 0; b < btType::nrBlocks; ++b) {
+			constexpr unsigned nrFractionBlocks = (btType::nrBlocks < cfloatType::nrBlocks ? btType::nrBlocks : cfloatType::nrBlocks);
+			for (unsigned b = 0; b < nrFractionBlocks; ++b) {
 				tgt.setblock(b, fracbits.block(b));
 			}
 			//std::cout << "fraction bits : " << to_binary(tgt, true) << '\n';
@@ -291,6 +313,22 @@ inline /*constexpr*/ void convert(const blocktriple<srcbits, op, bt>& src, cfloa
 				std::cerr << "exponent value is out of range: " << exponent << '\n';
 			}
 			//std::cout << "add exponent  : " << to_binary(tgt) << '\n';
+			if (alignment.first) {
+				// round up: increment the encoding, the carry ripples from the fraction into the exponent
+				for (unsigned b = 0; b < cfloatType::nrBlocks; ++b) {
+					bt block = bt(tgt.block(b) + 1u);
+					tgt.setblock(b, block);
+					if (block != 0) break;
+				}
+				if (tgt.isnan() || tgt.isinf()) {
+					if constexpr (isSaturating) {
+						if (src.sign()) tgt.maxneg(); else tgt.maxpos();
+					}
+					else {
+						tgt.setinf(src.sign());
+					}
+				}
+			}
 		}
 	}
 }
@@ -359,41 +397,38 @@ public:
 	static constexpr bool     isSaturating    = _isSaturating;
 	typedef bt BlockType;
 
+	// configurations up to 64 bits can unpack, compute, and round in native integers
+	static constexpr bool     nativeArithmetic = (CFLOAT_NATIVE_ARITHMETIC != 0) && (nbits <= 64);
+
+	// cfloat<32,8,bt,true,false,false> and cfloat<64,11,bt,true,false,false> share their encoding
+	// with IEEE-754 binary32 and binary64: their arithmetic is delegated to the floating-point hardware
+	static constexpr bool     isIeee754 = (CFLOAT_HARDWARE_DELEGATION != 0) && hasSubnormals && !hasSupernormals && !isSaturating &&
+		((nbits == 32 && es == 8 && std::numeric_limits<float>::is_iec559) || (nbits == 64 && es == 11 && std::numeric_limits<double>::is_iec559));
+	// cfloat<16,5,bt,true,false,false> is IEEE-754 binary16: float carries more than 2p+2 bits of precision
+	// for p = 11, so add, sub, mul, div, and sqrt computed in float and rounded once are correctly rounded
+	static constexpr bool     isBinary16 = (CFLOAT_HARDWARE_DELEGATION != 0) && hasSubnormals && !hasSupernormals && !isSaturating &&
+		(nbits == 16 && es == 5 && std::numeric_limits<float>::is_iec559);
+	// cfloat<128,15,bt,true,false,false> is IEEE-754 binary128: when the compiler provides __float128,
+	// its correctly rounded soft-float arithmetic is much faster than the blocktriple emulation
+	static constexpr bool     isBinary128 = (CFLOAT_FLOAT128_DELEGATION != 0) && (UNIVERSAL_NATIVE_FLOAT128 != 0) && hasSubnormals && !hasSupernormals && !isSaturating &&
+		(nbits == 128 && es == 15);
+#if UNIVERSAL_NATIVE_FLOAT128
+	using Ieee754Type = std::conditional_t<(nbits == 128), native_float128, std::conditional_t<(nbits == 64), double, float>>;
+	using Ieee754RawType = std::conditional_t<(nbits == 128), native_uint128, std::conditional_t<(nbits == 64), uint64_t, std::conditional_t<(nbits == 32), uint32_t, uint16_t>>>;
+#else
+	using Ieee754Type = std::conditional_t<(nbits == 64), double, float>;
+	using Ieee754RawType = std::conditional_t<(nbits == 64), uint64_t, std::conditional_t<(nbits == 32), uint32_t, uint16_t>>;
+#endif
+
 	// constructors
 	cfloat() = default;
 	cfloat(const cfloat&) = default;
 	cfloat& operator=(const cfloat&) = default;
 
-	// construct a cfloat from another
+	// construct a cfloat from another configuration, rounding once to this configuration
 	template<unsigned nnbits, unsigned ees, typename bbt, bool ssub, bool ssup, bool ssat>
 	cfloat(const cfloat<nnbits, ees, bbt, ssub, ssup, ssat>& rhs) noexcept : _block{} {
-		if (rhs.isnan()) {
-			setnan(rhs.sign() ? NAN_TYPE_SIGNALLING : NAN_TYPE_QUIET);
-		}
-		else if (rhs.isinf()) {
-			setinf(rhs.sign());
-		}
-		else if (rhs.iszero()) {
-			setzero();
-		}
-		else {
-			if constexpr (std::is_same_v<bt, bbt>) {
-				blocktriple<fbits, BlockTripleOperator::REP, bt> value;
-				value.setnormal();
-				value.setsign(rhs.sign());
-				value.setscale(rhs.scale());
-				//constexpr unsigned rhsFbits = nnbits - 1ul - ees;
-				//blockbinary<rhsFbits, bbt, BinaryNumberType::Signed> fraction;
-				//rhs.fraction<rhsFbits>(fraction);
-				//std::cout << "fraction : " << to_binary(fraction) << '\n';
-				//value.setfraction(fraction);
-				convert(value, *this);
-			}
-			else {
-				static_assert(nnbits < 64, "converting constructor marshalls values through native double precision, and rhs has more bits");
-				*this = double(rhs); // TODO: marshall through a proper blocktriple
-			}
-		}
+		convert(rhs, *this);
 	}
 
 	// converting constructors
@@ -479,6 +514,11 @@ public:
 
 	cfloat& operator+=(const cfloat& rhs) {
 		if constexpr (_trace_add) std::cout << "---------------------- ADD -------------------" << std::endl;
+		if constexpr (isIeee754 || isBinary16 || isBinary128) {
+			// a NaN result takes the generic path, which produces the cfloat NaN encoding or throws
+			Ieee754Type sum = to_ieee754() + rhs.to_ieee754();
+			if (!native_isnan(sum)) return from_ieee754(sum);
+		}
 		// special case handling of the inputs
 #if CFLOAT_THROW_ARITHMETIC_EXCEPTION
 		if (isnan(NAN_TYPE_SIGNALLING) || rhs.isnan(NAN_TYPE_SIGNALLING)) {
@@ -526,6 +566,10 @@ public:
 		}
 		if (rhs.iszero()) return *this;
 
+		if constexpr (nativeArithmetic) {
+			if (cfloat_native_add(*this, rhs, *this)) return *this;
+		}
+
 		// arithmetic operation
 		blocktriple<fbits, BlockTripleOperator::ADD, bt> a, b, sum;
 
@@ -553,6 +597,10 @@ public:
 	}
 	cfloat& operator*=(const cfloat& rhs) {
 		if constexpr (_trace_mul) std::cout << "---------------------- MUL -------------------\n";
+		if constexpr (isIeee754 || isBinary16 || isBinary128) {
+			Ieee754Type product = to_ieee754() * rhs.to_ieee754();
+			if (!native_isnan(product)) return from_ieee754(product);
+		}
 		// special case handling of the inputs
 #if CFLOAT_THROW_ARITHMETIC_EXCEPTION
 		if (isnan(NAN_TYPE_SIGNALLING) || rhs.isnan(NAN_TYPE_SIGNALLING)) {
@@ -600,6 +648,10 @@ public:
 			return *this;
 		}
 
+		if constexpr (nativeArithmetic) {
+			if (cfloat_native_mul(*this, rhs, *this)) return *this;
+		}
+
 		// arithmetic operation
 		blocktriple<fbits, BlockTripleOperator::MUL, bt> a, b, product;
 
@@ -656,6 +708,11 @@ public:
 		// -inf /  inf = -nan(ind)
 		// -inf / -inf = -nan(ind)
 		//	1.0 /  inf = 0
+		if constexpr (isIeee754 || isBinary16 || isBinary128) {
+			// delegate after the division by zero and NaN checks to honor CFLOAT_THROW_ARITHMETIC_EXCEPTION
+			Ieee754Type quotient = to_ieee754() / rhs.to_ieee754();
+			if (!native_isnan(quotient)) return from_ieee754(quotient);
+		}
 		bool resultSign = sign() != rhs.sign();
 		if (isinf()) {
 			if (rhs.isinf()) {
@@ -683,6 +740,10 @@ public:
 			return *this;
 		}
 
+		if constexpr (nativeArithmetic) {
+			if (cfloat_native_div(*this, rhs, *this)) return *this;
+		}
+
 		// arithmetic operation
 		using BlockTriple = blocktriple<fbits, BlockTripleOperator::DIV, bt>;
 		BlockTriple a, b, quotient;
@@ -1105,26 +1166,15 @@ public:
 	}
 	constexpr bool setexponent(int scale) {
 		if (scale < MIN_EXP_SUBNORMAL || scale > MAX_EXP) return false; // this scale cannot be represented
-		if constexpr (nbits < 65) {
-			uint32_t exponentBits = static_cast<uint32_t>(scale + EXP_BIAS);
-			if (scale >= MIN_EXP_SUBNORMAL && scale < MIN_EXP_NORMAL) {
-				// we are a subnormal number: all exponent bits are 0
-				exponentBits = 0;
-			}
-			// TODO: optimize
-			uint32_t mask = (1ul << (es - 1));
-			for (unsigned i = nbits - 2; i > nbits - 2 - es; --i) {
-				setbit(i, (mask & exponentBits));
-				mask >>= 1;
-			}
-		}
-		else {
-			uint32_t exponentBits = static_cast<uint32_t>(scale + EXP_BIAS);
-			uint32_t mask = (1ul << (es - 1));
-			for (unsigned i = nbits - 2; i > nbits - 2 - es; --i) {
-				setbit(i, (mask & exponentBits));
-				mask >>= 1;
-			}
+		constexpr uint64_t fieldMask = (1ull << es) - 1ull;
+		// a subnormal number has all exponent bits 0
+		uint64_t exponentBits = (scale < MIN_EXP_NORMAL ? 0ull : static_cast<uint64_t>(scale + EXP_BIAS));
+		// write the exponent field, bits [fbits, fbits + es), into the blocks it spans
+		for (unsigned b = fbits / bitsInBlock; b <= (nbits - 2) / bitsInBlock; ++b) {
+			unsigned lsb = b * bitsInBlock;  // position of bit 0 of this block in the encoding
+			uint64_t field = (fbits >= lsb ? exponentBits << (fbits - lsb) : exponentBits >> (lsb - fbits));
+			uint64_t mask  = (fbits >= lsb ? fieldMask << (fbits - lsb) : fieldMask >> (lsb - fbits));
+			_block[b] = bt((_block[b] & ~bt(mask)) | bt(field & mask));
 		}
 		return true;
 	}
@@ -1217,7 +1267,61 @@ public:
 	constexpr void setblock(unsigned b, bt data) noexcept {
 		if (b < nrBlocks) _block[b] = data;
 	}
-	
+
+	// convert an IEEE-754 equivalent cfloat to a native float, double, or __float128, and vice versa.
+	// Finite values share their encoding, but cfloat encodes inf as 0b.11..11.11..10 and
+	// all other encodings with an all-ones exponent as NaN, so the special values are translated.
+	// A binary16 cfloat converts to and from float, rounding to nearest on the way back.
+	Ieee754Type to_ieee754() const noexcept {
+		static_assert(nbits == 16 || nbits == 32 || nbits == 64 || isBinary128, "to_ieee754 requires a binary16, binary32, binary64, or binary128 encoding");
+		using RawType = Ieee754RawType;
+		constexpr RawType EXP_FIELD = static_cast<RawType>(static_cast<RawType>(ALL_ONES_ES) << fbits);
+		RawType raw{ 0 };
+		if constexpr (1 == nrBlocks) {
+			raw = static_cast<RawType>(_block[0]);
+		}
+		else {
+			for (unsigned b = 0; b < nrBlocks; ++b) {
+				raw |= static_cast<RawType>(static_cast<RawType>(_block[b]) << (b * bitsInBlock));
+			}
+		}
+		if ((raw & EXP_FIELD) == EXP_FIELD) {
+			if (isinf()) return native_infinity<Ieee754Type>(sign());
+			return native_quiet_nan<Ieee754Type>();
+		}
+		if constexpr (nbits == 16) {
+			return binary16_to_float(raw);
+		}
+		else {
+			return sw::bit_cast<Ieee754Type>(raw);
+		}
+	}
+	cfloat& from_ieee754(Ieee754Type v) noexcept {
+		static_assert(nbits == 16 || nbits == 32 || nbits == 64 || isBinary128, "from_ieee754 requires a binary16, binary32, binary64, or binary128 encoding");
+		using RawType = Ieee754RawType;
+		constexpr RawType EXP_FIELD = static_cast<RawType>(static_cast<RawType>(ALL_ONES_ES) << fbits);
+		constexpr RawType FRACTION_FIELD = static_cast<RawType>((static_cast<RawType>(1) << fbits) - 1u);
+		RawType raw{ 0 };
+		if constexpr (nbits == 16) {
+			raw = float_to_binary16(v);
+		}
+		else {
+			raw = sw::bit_cast<RawType>(v);
+		}
+		if ((raw & EXP_FIELD) == EXP_FIELD) {
+			bool negative = (raw >> (nbits - 1)) != 0;
+			if ((raw & FRACTION_FIELD) == 0) setinf(negative); else setnan(negative ? NAN_TYPE_SIGNALLING : NAN_TYPE_QUIET);
+			return *this;
+		}
+		if constexpr (nbits == 128) {
+			for (unsigned b = 0; b < nrBlocks; ++b) _block[b] = bt(raw >> (b * bitsInBlock));
+			return *this;
+		}
+		else {
+			return setbits(uint64_t(raw));
+		}
+	}
+
 	// create specific number system values of interest
 	constexpr cfloat& maxpos() noexcept {
 		if constexpr (isSaturating) {
@@ -1423,12 +1527,8 @@ public:
 				// subnormal scale is determined by fraction
 				// subnormals: (-1)^s * 2^(2-2^(es-1)) * (f/2^fbits))
 				e = (2l - (1l << (es - 1ull))) - 1;
-				if constexpr (nbits > 2 + es) {
-					for (unsigned i = nbits - 2ull - es; i > 0; --i) {
-						if (test(i)) break;
-						--e;
-					}
-				}
+				int msb = fraction_msb();
+				e -= static_cast<int>(fbits) - 1 - (msb > 0 ? msb : 0);
 			}
 			else {
 				e -= EXP_BIAS;
@@ -1441,12 +1541,8 @@ public:
 				// subnormal scale is determined by fraction
 				// subnormals: (-1)^s * 2^(2-2^(es-1)) * (f/2^fbits))
 				e = (2l - (1l << (es - 1ull))) - 1;
-				if constexpr (nbits > 2 + es) {
-					for (unsigned i = nbits - 2ull - es; i > 0; --i) {
-						if (test(i)) break;
-						--e;
-					}
-				}
+				int msb = fraction_msb();
+				e -= static_cast<int>(fbits) - 1 - (msb > 0 ? msb : 0);
 			}
 			else {
 				e = static_cast<int>(unsigned(ebits) - EXP_BIAS);
@@ -1784,25 +1880,19 @@ public:
 		}
 		else if constexpr (nrBlocks > 1) {
 			s.clear();
-			// TODO: design and implement a block-oriented algorithm, this sequential algorithm is super slow
+			for (unsigned i = 0; i < FSU; ++i) { s.setblock(i, _block[i]); }
+			s.setblock(FSU, bt(_block[FSU] & FSU_MASK));
 			if (isNormal) {
 				s.setbit(fbits);
-				for (unsigned i = 0; i < fbits; ++i) { s.setbit(i, at(i)); }
 			}
 			else {
-				// Find the MSB of the subnormal: 
-				unsigned msb = 0;
-				for (unsigned i = 0; i < fbits; ++i) { // msb protected from not being assigned through iszero test at prelude of function
-					msb = fbits - 1ull - i;
-					if (test(msb)) break;
-				}
+				// shift the MSB of the subnormal into the hidden bit position
 				//      m-----lsb
 				// h00001010101
 				// 101010100000
-				for (unsigned i = 0; i <= msb; ++i) {
-					s.setbit(fbits - msb + i, at(i));
-				}
-				shift = fhbits - msb;
+				int msb = fraction_msb(); // msb is positive as zero is rejected at the prelude of the function
+				shift = fbits - static_cast<unsigned>(msb);
+				s <<= static_cast<int>(shift);
 			}
 		}
 		return shift;
@@ -1826,6 +1916,10 @@ public:
 	// with a final rounding step.
 	template<typename TargetFloat>
 	TargetFloat to_native() const { 
+		if constexpr (isIeee754 || isBinary16 || isBinary128) {
+			// the NaN encodings are mapped to signalling and quiet NaNs below
+			if (!isnan()) return static_cast<TargetFloat>(to_ieee754());
+		}
 		TargetFloat v{ 0.0 };
 		if (iszero()) {
 			// the optimizer might destroy the sign
@@ -1937,6 +2031,7 @@ public:
 				}
 				else {
 					blockcopy(tgt);
+					tgt.setradix();
 					tgt.setbit(fbits);
 				}
 			}
@@ -1950,7 +2045,8 @@ public:
 				}
 				else {
 					blockcopy(tgt);
-					tgt <<= shift;
+					tgt.setradix();
+					tgt.bitShift(shift);
 					tgt.setbit(fbits);
 				}
 			}
@@ -2004,7 +2100,7 @@ public:
 			else {
 				if (isdenormal()) { // it is a subnormal encoding in this target cfloat
 					if constexpr (hasSubnormals) {
-						if constexpr (BlockTripleConfiguration::rbits < (64 - fbits)) {
+						if constexpr (fbits < 64 && BlockTripleConfiguration::rbits < (64 - fbits)) {
 							uint64_t raw = fraction_ull();
 							int shift = MIN_EXP_NORMAL - scale;
 							raw <<= shift; // shift but do NOT add a hidden bit as the MSB of the subnormal is shifted in the hidden bit position
@@ -2108,10 +2204,9 @@ public:
 		tgt.setradix(fbits); // override the radix with the input scale for accurate value printing
 	}
 
-	// normalize a cfloat to a blocktriple used in div, which has the form 0'00000'00001.fffff
-	// that is 3*fbits, plus 1 overflow bit, and the radix set at <fbits>.
-	// the result radix will go to 2*fbits after multiplication.
-	// TODO: needs implementation
+	// normalize a cfloat to a blocktriple used in div, which has the form 01.fffff00000
+	// with the radix at divbits = 3*fbits + 4, and the quotient comes out at the same radix.
+	// Subnormals are normalized, so that the division operates on significants with a leading 1.
 	constexpr void normalizeDivision(blocktriple<fbits, BlockTripleOperator::DIV, bt>& tgt) const {
 		constexpr unsigned divshift = blocktriple<fbits, BlockTripleOperator::DIV, bt>::divshift;
 		// test special cases
@@ -2168,6 +2263,113 @@ public:
 		tgt.setradix(blocktriple<fbits, BlockTripleOperator::DIV, bt>::radix);
 	}
 
+	// normalize a cfloat to a blocktriple used in sqrt, which has the form 01.fffff with the radix at fbits.
+	// Subnormals are normalized, so that the root is computed on a significant with a leading 1.
+	constexpr void normalizeSqrt(blocktriple<fbits, BlockTripleOperator::SQRT, bt>& tgt) const {
+		using BlockTripleConfiguration = blocktriple<fbits, BlockTripleOperator::SQRT, bt>;
+		// test special cases
+		if (isnan()) {
+			tgt.setnan();
+		}
+		else if (isinf()) {
+			tgt.setinf();
+		}
+		else if (iszero()) {
+			tgt.setzero();
+		}
+		else {
+			tgt.setnormal(); // a blocktriple is always normalized
+			int scale = this->scale();
+			tgt.setsign(sign());
+			tgt.setscale(scale);
+			if (isnormal() || issupernormal()) {
+				if constexpr (BlockTripleConfiguration::bfbits <= 64) {
+					uint64_t raw = fraction_ull();
+					raw |= (1ull << fbits); // add the hidden bit
+					tgt.setbits(raw);
+				}
+				else {
+					blockcopy(tgt);
+					tgt.setbit(fbits); // add the hidden bit
+				}
+			}
+			else { // it is a subnormal encoding in this target cfloat
+				if constexpr (hasSubnormals) {
+					int shift = MIN_EXP_NORMAL - scale; // the MSB of the subnormal is shifted in the hidden bit position
+					if constexpr (BlockTripleConfiguration::bfbits <= 64) {
+						uint64_t raw = fraction_ull();
+						tgt.setbits(raw << shift);
+					}
+					else {
+						blockcopy(tgt);
+						tgt.bitShift(shift);
+					}
+				}
+				else { // this cfloat has no subnormals
+					tgt.setzero(tgt.sign()); // preserve the sign
+				}
+			}
+		}
+		tgt.setradix(fbits);
+	}
+
+	// normalize a cfloat to the addend of a fused multiply-add, which has the form 001.ffff'eeee'eeee
+	// that is 3 + fmabits, with the radix at fmabits, so that it aligns with the unrounded product.
+	constexpr void normalizeFma(blocktriple<fbits, BlockTripleOperator::FMA, bt>& tgt) const {
+		using BlockTripleConfiguration = blocktriple<fbits, BlockTripleOperator::FMA, bt>;
+		constexpr unsigned fmashift = BlockTripleConfiguration::fmabits - fbits;
+		// test special cases
+		if (isnan()) {
+			tgt.setnan();
+		}
+		else if (isinf()) {
+			tgt.setinf();
+		}
+		else if (iszero()) {
+			tgt.setzero();
+		}
+		else {
+			tgt.setnormal(); // a blocktriple is always normalized
+			int scale = this->scale();
+			tgt.setsign(sign());
+			tgt.setscale(scale);
+			if (isdenormal()) { // it is a subnormal encoding in this target cfloat
+				if constexpr (hasSubnormals) {
+					int shift = MIN_EXP_NORMAL - scale;
+					if constexpr (BlockTripleConfiguration::bfbits < 64) {
+						uint64_t raw = fraction_ull();
+						raw <<= shift; // the MSB of the subnormal is shifted in the hidden bit position
+						tgt.setbits(raw << fmashift);
+					}
+					else {
+						blockcopy(tgt);
+						tgt.setradix();
+						tgt.bitShift(shift + static_cast<int>(fmashift));
+					}
+				}
+				else {  // this cfloat has no subnormals
+					tgt.setzero(tgt.sign()); // preserve the sign
+				}
+			}
+			else if (isnormal() || hasSupernormals) {
+				if constexpr (BlockTripleConfiguration::bfbits < 64) {
+					uint64_t raw = fraction_ull();
+					raw |= (1ull << fbits); // add the hidden bit
+					tgt.setbits(raw << fmashift);
+				}
+				else {
+					blockcopy(tgt);
+					tgt.setradix();
+					tgt.setbit(fbits); // add the hidden bit
+					tgt.bitShift(static_cast<int>(fmashift));
+				}
+			}
+			else {  // this cfloat has no supernormals and thus this represents a nan, signalling or quiet determined by the sign
+				tgt.setnan(tgt.sign());
+			}
+		}
+	}
+
 	// helper debug function
 	void constexprClassParameters() const noexcept {
 		std::cout << "-------------------------------------------------------------\n";
@@ -2263,6 +2465,10 @@ protected:
 	constexpr cfloat& convert_unsigned_integer(const Ty& rhs) noexcept {
 		clear();
 		if (0 == rhs) return *this;
+#if UNIVERSAL_NATIVE_FLOAT128
+		// binary128 holds every 64-bit integer exactly
+		if constexpr (isBinary128) return from_ieee754(static_cast<native_float128>(rhs));
+#endif
 
 		uint64_t raw = static_cast<uint64_t>(rhs);
 		int msb = static_cast<int>(find_msb(raw)) - 1; // msb > 0 due to zero test above 
@@ -2299,6 +2505,9 @@ protected:
 	constexpr cfloat& convert_signed_integer(const Ty& rhs) noexcept {
 		clear();
 		if (0 == rhs) return *this;
+#if UNIVERSAL_NATIVE_FLOAT128
+		if constexpr (isBinary128) return from_ieee754(static_cast<native_float128>(rhs));
+#endif
 		bool s = (rhs < 0);
 		uint64_t raw = static_cast<uint64_t>(s ? -rhs : rhs);
 
@@ -2335,6 +2544,15 @@ protected:
 public:
 	template<typename Real>
 	CONSTEXPRESSION cfloat& convert_ieee754(Real rhs) noexcept {
+		// binary128 holds every float, double, and x87 extended precision value exactly
+		if constexpr (((isIeee754 || isBinary16) && std::is_same_v<Real, Ieee754Type>) || (isBinary128 && std::numeric_limits<Real>::digits <= 64)) {
+			// the NaN encodings of rhs are mapped to signalling and quiet NaNs below
+			bool runtime = true;
+#if BIT_CAST_SUPPORT
+			runtime = !std::is_constant_evaluated();  // convert_ieee754 is only constexpr with bit_cast support
+#endif
+			if (runtime && !std::isnan(rhs)) return from_ieee754(rhs);
+		}
 		if constexpr (nbits == 32 && es == 8 && sizeof(Real) == 4) {
 			// we CANNOT use the native conversion to float as cfloats have supernormals
 			// which IEEE-754 does not have and thus a native conversion would destroy
@@ -3022,6 +3240,16 @@ protected:
 		return (negative ? (1.0 / result) : result);
 	}
 
+	// position of the most significant fraction bit that is set, -1 if all fraction bits are 0
+	constexpr int fraction_msb() const noexcept {
+		bt fsu = bt(_block[FSU] & FSU_MASK);
+		if (fsu != 0) return static_cast<int>(FSU * bitsInBlock + bitsInBlock - 1) - std::countl_zero(fsu);
+		for (int i = static_cast<int>(FSU) - 1; i >= 0; --i) {
+			if (_block[i] != 0) return i * static_cast<int>(bitsInBlock) + static_cast<int>(bitsInBlock - 1) - std::countl_zero(_block[i]);
+		}
+		return -1;
+	}
+
 	template<BlockTripleOperator btop>
 	constexpr void blockcopy(blocktriple<fbits, btop, bt>& tgt) const {
 		// brute force copy of blocks
@@ -3111,6 +3339,104 @@ private:
 	friend bool operator>=(const cfloat<nnbits,nes,nbt,nsub,nsup,nsat>& lhs, const cfloat<nnbits,nes,nbt,nsub,nsup,nsat>& rhs);
 };
 
+/////////////////////////////  CONVERSION between cfloat configurations  ////////////////////////////
+
+/// <summary>
+/// convert a cfloat to a cfloat of another configuration with a single rounding.
+/// The significant of the source, with subnormals normalized, is aligned in a blocktriple of the
+/// target precision, which the blocktriple conversion rounds into the target, so that overflow,
+/// underflow, and subnormals follow the rules of the target configuration. A widening conversion
+/// uses the representation layout. A narrowing conversion uses the layout of the divider, which
+/// leaves room for the guard and round bits below the lsb, and folds source bits that do not fit
+/// into the sticky bit.
+/// </summary>
+/// <param name="src">the cfloat to convert</param>
+/// <param name="tgt">the resulting cfloat</param>
+template<unsigned srcbits, unsigned srces, typename srcbt, bool srcSubnormals, bool srcSupernormals, bool srcSaturating,
+	unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
+inline void convert(const cfloat<srcbits, srces, srcbt, srcSubnormals, srcSupernormals, srcSaturating>& src, cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& tgt) {
+	using Source = cfloat<srcbits, srces, srcbt, srcSubnormals, srcSupernormals, srcSaturating>;
+	using Target = cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>;
+	constexpr BlockTripleOperator op = (Source::fbits > Target::fbits ? BlockTripleOperator::DIV : BlockTripleOperator::REP);
+	using BlockTriple = blocktriple<Target::fbits, op, bt>;
+	constexpr int radix = BlockTriple::radix;
+	// the value of an IEEE-754 equivalent source is exact as a native type, so the native assignment
+	// rounds once, and between IEEE-754 equivalent configurations the rounding is done by the native
+	// conversion, except to binary16 from binary64 and binary128, which would round twice through float
+	constexpr bool nativeSource = Source::isIeee754 || Source::isBinary16 || Source::isBinary128;
+	constexpr bool nativeTarget = Target::isIeee754 || Target::isBinary16 || Target::isBinary128;
+	if constexpr (nativeSource && ((nativeTarget && !(Target::isBinary16 && srcbits >= 64)) || !Source::isBinary128)) {
+		if (!src.isnan()) {
+			if constexpr (nativeTarget && !(Target::isBinary16 && srcbits >= 64)) {
+				tgt.from_ieee754(static_cast<typename Target::Ieee754Type>(src.to_ieee754()));
+			}
+			else {
+				tgt = static_cast<double>(src.to_ieee754());
+			}
+			return;
+		}
+	}
+	if (src.isnan()) {
+		tgt.setnan(src.sign() ? NAN_TYPE_SIGNALLING : NAN_TYPE_QUIET);
+		return;
+	}
+	if (src.isinf()) {
+		tgt.setinf(src.sign());
+		return;
+	}
+	if (src.iszero()) {
+		tgt.setzero();
+		tgt.setsign(src.sign());
+		return;
+	}
+	BlockTriple v;
+	v.setnormal();
+	v.setsign(src.sign());
+	int scale = src.scale();
+	v.setscale(scale);
+	// left shift that moves the leading one of a subnormal to the hidden bit position
+	int normalize = ((!src.isnormal() && !src.issupernormal()) ? Source::MIN_EXP_NORMAL - scale : 0);
+	// left shift that aligns the hidden bit of the source to the radix of the blocktriple
+	int shift = normalize + radix - static_cast<int>(Source::fbits);
+	if constexpr (Source::fbits < 64 && BlockTriple::bfbits <= 64) {
+		uint64_t raw = src.fraction_ull() << normalize;
+		raw |= (1ull << Source::fbits);  // add the hidden bit
+		if constexpr (radix >= static_cast<int>(Source::fbits)) {
+			raw <<= (radix - static_cast<int>(Source::fbits));
+		}
+		else {
+			constexpr unsigned rightShift = Source::fbits - static_cast<unsigned>(radix);
+			bool sticky = (raw & ((1ull << rightShift) - 1ull)) != 0;
+			raw >>= rightShift;
+			if (sticky) raw |= 1ull;
+		}
+		v.setbits(raw);
+	}
+	else {
+		if constexpr (std::is_same_v<srcbt, bt>) {
+			if (shift >= 0) {
+				// copy the blocks that contain fraction bits and clear the exponent bits that came along
+				for (unsigned b = 0; b < Source::fBlocks; ++b) v.setblock(b, src.block(b));
+				for (unsigned i = Source::fbits; i < Source::fBlocks * Source::bitsInBlock; ++i) v.setbit(i, false);
+				v.bitShift(shift);
+				v.setbit(static_cast<unsigned>(radix));  // add the hidden bit
+				v.setradix(radix);
+				convert(v, tgt);
+				return;
+			}
+		}
+		bool sticky = false;
+		for (unsigned i = 0; i < Source::fbits; ++i) {
+			int position = static_cast<int>(i) + shift;
+			if (position < 0) sticky |= src.at(i); else v.setbit(static_cast<unsigned>(position), src.at(i));
+		}
+		if (sticky) v.setbit(0);
+		v.setbit(static_cast<unsigned>(radix));  // add the hidden bit
+		v.setradix(radix);
+	}
+	convert(v, tgt);
+}
+
 ///////////////////////////// IOSTREAM operators ///////////////////////////////////////////////
 
 // convert cfloat to decimal fixpnt string, i.e. "-1234.5678"
@@ -3358,6 +3684,7 @@ template<unsigned nnbits, unsigned nes, typename nbt, bool nsub, bool nsup, bool
 inline bool operator!=(const cfloat<nnbits,nes,nbt,nsub,nsup,nsat>& lhs, const cfloat<nnbits,nes,nbt,nsub,nsup,nsat>& rhs) { return !operator==(lhs, rhs); }
 template<unsigned nnbits, unsigned nes, typename nbt, bool nsub, bool nsup, bool nsat>
 inline bool operator< (const cfloat<nnbits, nes, nbt, nsub, nsup, nsat>& lhs, const cfloat<nnbits, nes, nbt, nsub, nsup, nsat>& rhs) {
+	if constexpr (cfloat<nnbits, nes, nbt, nsub, nsup, nsat>::isIeee754 || cfloat<nnbits, nes, nbt, nsub, nsup, nsat>::isBinary16) return lhs.to_ieee754() < rhs.to_ieee754();
 	if (lhs.isnan() || rhs.isnan()) return false;
 	// need this as arithmetic difference is defined as snan(indeterminate)
 	if (lhs.isinf(INF_TYPE_NEGATIVE) && rhs.isinf(INF_TYPE_NEGATIVE)) return false;
@@ -3395,6 +3722,7 @@ inline bool operator< (const cfloat<nnbits, nes, nbt, nsub, nsup, nsat>& lhs, co
 }
 template<unsigned nnbits, unsigned nes, typename nbt, bool nsub, bool nsup, bool nsat>
 inline bool operator> (const cfloat<nnbits,nes,nbt,nsub,nsup,nsat>& lhs, const cfloat<nnbits,nes,nbt,nsub,nsup,nsat>& rhs) { 
+	if constexpr (cfloat<nnbits, nes, nbt, nsub, nsup, nsat>::isIeee754 || cfloat<nnbits, nes, nbt, nsub, nsup, nsat>::isBinary16) return lhs.to_ieee754() > rhs.to_ieee754();
 	if (lhs.isnan() || rhs.isnan()) return false;
 	// need this as arithmetic difference is defined as snan(indeterminate)
 	if (lhs.isinf(INF_TYPE_NEGATIVE) && rhs.isinf(INF_TYPE_NEGATIVE)) return false;
@@ -3403,11 +3731,13 @@ inline bool operator> (const cfloat<nnbits,nes,nbt,nsub,nsup,nsat>& lhs, const c
 }
 template<unsigned nnbits, unsigned nes, typename nbt, bool nsub, bool nsup, bool nsat>
 inline bool operator<=(const cfloat<nnbits,nes,nbt,nsub,nsup,nsat>& lhs, const cfloat<nnbits,nes,nbt,nsub,nsup,nsat>& rhs) { 
+	if constexpr (cfloat<nnbits, nes, nbt, nsub, nsup, nsat>::isIeee754 || cfloat<nnbits, nes, nbt, nsub, nsup, nsat>::isBinary16) return lhs.to_ieee754() <= rhs.to_ieee754();
 	if (lhs.isnan() || rhs.isnan()) return false;
 	return !operator> (lhs, rhs); 
 }
 template<unsigned nnbits, unsigned nes, typename nbt, bool nsub, bool nsup, bool nsat>
 inline bool operator>=(const cfloat<nnbits,nes,nbt,nsub,nsup,nsat>& lhs, const cfloat<nnbits,nes,nbt,nsub,nsup,nsat>& rhs) {
+	if constexpr (cfloat<nnbits, nes, nbt, nsub, nsup, nsat>::isIeee754 || cfloat<nnbits, nes, nbt, nsub, nsup, nsat>::isBinary16) return lhs.to_ieee754() >= rhs.to_ieee754();
 	if (lhs.isnan() || rhs.isnan()) return false;
 	return !operator< (lhs, rhs); 
 }
@@ -3925,22 +4255,50 @@ inline cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>
 fma(cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> x,
 	cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> y,
 	cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> z) {
-	cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating> fused{ 0 };
-	constexpr unsigned FBITS = cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>::fbits;
-	constexpr unsigned EXTRA_FBITS = FBITS+2;
-	constexpr unsigned EXTENDED_PRECISION = nbits + EXTRA_FBITS;
+	using Cfloat = cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>;
+	constexpr unsigned fbits = Cfloat::fbits;
+	if constexpr (Cfloat::isIeee754 || Cfloat::isBinary128) {
+		auto hardware = native_fma(x.to_ieee754(), y.to_ieee754(), z.to_ieee754());
+		if (!native_isnan(hardware)) return x.from_ieee754(hardware);
+	}
 	// the C++ fma spec indicates that the x*y+z is evaluated in 'infinite' precision
-	// with only a single rounding event. The minimum finite precision that would behave like this
-	// is the precision where the product x*y does not need to be rounded, which will
-	// need at least 2*(fbits+1) mantissa bits to capture all bits that can be
-	// generated by the product.
-	cfloat<EXTENDED_PRECISION, es, bt, hasSubnormals, hasSupernormals, isSaturating> preciseX(x), preciseY(y), preciseZ(z);
-//	ReportValue(preciseX, "extended precision x");
-//	ReportValue(preciseY, "extended precision y");
-//	ReportValue(preciseZ, "extended precision z");
-	cfloat<EXTENDED_PRECISION, es, bt, hasSubnormals, hasSupernormals, isSaturating> product = preciseX * preciseY;
-//	ReportValue(product, "extended precision p");
-	fused = product + preciseZ;
+	// with only a single rounding event: the product stays unrounded in the blocktriple
+	// and the addend is accumulated in a significant that is wide enough to round once.
+	Cfloat fused{ 0 };
+	if (x.isnan(NAN_TYPE_SIGNALLING) || y.isnan(NAN_TYPE_SIGNALLING) || z.isnan(NAN_TYPE_SIGNALLING)) {
+		fused.setnan(NAN_TYPE_SIGNALLING);
+		return fused;
+	}
+	if (x.isnan(NAN_TYPE_QUIET) || y.isnan(NAN_TYPE_QUIET) || z.isnan(NAN_TYPE_QUIET)) {
+		fused.setnan(NAN_TYPE_QUIET);
+		return fused;
+	}
+	bool productSign = x.sign() != y.sign();
+	if (x.isinf() || y.isinf()) {
+		// 0 * inf and inf - inf are indeterminate
+		if (x.iszero() || y.iszero() || (z.isinf() && z.sign() != productSign)) {
+			fused.setnan(NAN_TYPE_QUIET);
+		}
+		else {
+			fused.setinf(productSign);
+		}
+		return fused;
+	}
+	if (z.isinf()) return z;
+	if (x.iszero() || y.iszero()) {
+		if (z.iszero()) fused.setsign(productSign && z.sign()); // the sum of two zeros is -0 only when both are negative
+		else fused = z;
+		return fused;
+	}
+	if (z.iszero()) return x * y; // a single rounding of the product
+
+	blocktriple<fbits, BlockTripleOperator::MUL, bt> a, b;
+	blocktriple<fbits, BlockTripleOperator::FMA, bt> c, result;
+	x.normalizeMultiplication(a);
+	y.normalizeMultiplication(b);
+	z.normalizeFma(c);
+	result.fma(a, b, c);
+	convert(result, fused);
 	return fused;
 }
 
@@ -0,0 +1,59 @@
+#pragma once
+// fdp.hpp :  include file containing templated C++ interfaces to the cfloat fused dot product
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <iostream>
+#include <vector>
+#include <universal/traits/cfloat_traits.hpp>
+#include <universal/number/cfloat/quire.hpp>
+
+namespace sw { namespace universal {
+
+/// //////////////////////////////////////////////////////////////////
+/// fused dot product operators for cfloat
+/// fdp_qc         fused dot product with quire continuation
+/// fdp_stride     fused dot product with non-negative stride
+/// fdp            fused dot product of two vectors
+
+// Fused dot product with quire continuation
+template<typename Cfloat, unsigned capacity, typename Vector>
+void fdp_qc(cfloat_quire<Cfloat, capacity>& sum_of_products, size_t n, const Vector& x, size_t incx, const Vector& y, size_t incy) {
+	size_t ix, iy;
+	for (ix = 0, iy = 0; ix < n && iy < n; ix = ix + incx, iy = iy + incy) {
+		sum_of_products.add_product(x[ix], y[iy]);
+	}
+}
+
+// Resolved fused dot product, with the option to control capacity bits in the quire
+template<typename Vector>
+enable_if_cfloat<value_type<Vector>, value_type<Vector> > // as return type
+fdp_stride(size_t n, const Vector& x, size_t incx, const Vector& y, size_t incy) {
+	constexpr unsigned capacity = 20; // support vectors up to 1M elements
+	cfloat_quire<typename Vector::value_type, capacity> q;
+	size_t ix, iy;
+	for (ix = 0, iy = 0; ix < n && iy < n; ix = ix + incx, iy = iy + incy) {
+		q.add_product(x[ix], y[iy]);
+	}
+	typename Vector::value_type sum;
+	convert(q, sum);     // one and only rounding step of the fused-dot product
+	return sum;
+}
+
+// Specialized resolved fused dot product that assumes unit stride and a standard vector
+template<typename Vector>
+enable_if_cfloat<value_type<Vector>, value_type<Vector> > // as return type
+fdp(const Vector& x, const Vector& y) {
+	constexpr unsigned capacity = 20; // support vectors up to 1M elements
+	cfloat_quire<typename Vector::value_type, capacity> q;
+	size_t ix, iy, n = size(x);
+	for (ix = 0, iy = 0; ix < n && iy < n; ++ix, ++iy) {
+		q.add_product(x[ix], y[iy]);
+	}
+	typename Vector::value_type sum;
+	convert(q, sum);     // one and only rounding step of the fused-dot product
+	return sum;
+}
+
+}} // namespace sw::universal
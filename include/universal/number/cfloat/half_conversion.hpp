@@ -0,0 +1,79 @@
+#pragma once
+// half_conversion.hpp: batched conversions between arrays of half-precision cfloats and floats
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <universal/native/binary16.hpp>
+
+namespace sw { namespace universal {
+
+// chunk of encodings converted at a time: the staging buffer stays in the L1 cache
+constexpr std::size_t HALF_CONVERSION_CHUNK = 256;
+
+/// <summary>
+/// widen an array of cfloat<16,5,bt,true,false,false> to floats, for example when loading a tensor.
+/// The encodings are converted as IEEE-754 binary16, after which the cfloat inf and NaN encodings,
+/// which differ from IEEE-754, are patched up.
+/// </summary>
+template<typename bt>
+inline void half_to_float(const cfloat<16, 5, bt, true, false, false>* src, float* dst, std::size_t n) {
+	using Half = cfloat<16, 5, bt, true, false, false>;
+	std::uint16_t bits[HALF_CONVERSION_CHUNK];
+	for (std::size_t i = 0; i < n; i += HALF_CONVERSION_CHUNK) {
+		std::size_t m = (n - i < HALF_CONVERSION_CHUNK ? n - i : HALF_CONVERSION_CHUNK);
+		for (std::size_t j = 0; j < m; ++j) {
+			if constexpr (Half::nrBlocks == 1) {
+				bits[j] = static_cast<std::uint16_t>(src[i + j].block(0));
+			}
+			else {
+				bits[j] = static_cast<std::uint16_t>(src[i + j].block(0) | (std::uint16_t(src[i + j].block(1)) << 8));
+			}
+		}
+		binary16_to_float(bits, dst + i, m);
+		for (std::size_t j = 0; j < m; ++j) {
+			if ((bits[j] & 0x7C00u) == 0x7C00u) dst[i + j] = float(src[i + j]);
+		}
+	}
+}
+
+/// <summary>
+/// narrow an array of floats to cfloat<16,5,bt,true,false,false>, rounding to nearest, ties to even,
+/// for example when storing a tensor. Overflow yields the cfloat inf encoding and a NaN the cfloat
+/// NaN encoding of the same sign.
+/// </summary>
+template<typename bt>
+inline void float_to_half(const float* src, cfloat<16, 5, bt, true, false, false>* dst, std::size_t n) {
+	std::uint16_t bits[HALF_CONVERSION_CHUNK];
+	for (std::size_t i = 0; i < n; i += HALF_CONVERSION_CHUNK) {
+		std::size_t m = (n - i < HALF_CONVERSION_CHUNK ? n - i : HALF_CONVERSION_CHUNK);
+		float_to_binary16(src + i, bits, m);
+		for (std::size_t j = 0; j < m; ++j) {
+			if ((bits[j] & 0x7C00u) == 0x7C00u) {
+				bool negative = (bits[j] & 0x8000u) != 0;
+				if ((bits[j] & 0x03FFu) == 0) dst[i + j].setinf(negative); else dst[i + j].setnan(negative ? NAN_TYPE_SIGNALLING : NAN_TYPE_QUIET);
+			}
+			else {
+				dst[i + j].setbits(bits[j]);
+			}
+		}
+	}
+}
+
+// vector forms of the batched conversions
+template<typename bt>
+inline void half_to_float(const std::vector< cfloat<16, 5, bt, true, false, false> >& src, std::vector<float>& dst) {
+	dst.resize(src.size());
+	half_to_float(src.data(), dst.data(), src.size());
+}
+
+template<typename bt>
+inline void float_to_half(const std::vector<float>& src, std::vector< cfloat<16, 5, bt, true, false, false> >& dst) {
+	dst.resize(src.size());
+	float_to_half(src.data(), dst.data(), src.size());
+}
+
+}} // namespace sw::universal
@@ -74,30 +74,43 @@ namespace sw { namespace universal {
 	*/
 
 
-#if CFLOAT_NATIVE_SQRT
-	// sqrt for arbitrary cfloat
+	// correctly rounded sqrt for arbitrary cfloat: the root is computed on the blocktriple SQRT operator.
+	// IEEE-754 equivalent configurations are delegated to the hardware unless CFLOAT_NATIVE_SQRT is set.
 	template<unsigned nbits, unsigned es, typename bt, bool hasSubnormal, bool hasSupernormal, bool isSaturating>
 	inline cfloat<nbits, es, bt, hasSubnormal, hasSupernormal, isSaturating> sqrt(const cfloat<nbits, es, bt, hasSubnormal, hasSupernormal, isSaturating>& a) {
+		using Cfloat = cfloat<nbits, es, bt, hasSubnormal, hasSupernormal, isSaturating>;
+		if (a.iszero()) {
+			// sqrt(-0) = -0, and without subnormals the subnormal encodings are zero too
+			Cfloat zero;
+			zero.setzero();
+			zero.setsign(a.sign());
+			return zero;
+		}
+		if (a.isnan()) return a;
 #if CFLOAT_THROW_ARITHMETIC_EXCEPTION
 		if (a.isneg()) throw cfloat_negative_sqrt_arg();
 #else
-		if (a.isneg()) std::cerr << "cfloat argument to sqrt is negative: " << a << std::endl;
+		if (a.isneg()) {
+			std::cerr << "cfloat argument to sqrt is negative: " << a << std::endl;
+			Cfloat nan;
+			nan.setnan(NAN_TYPE_QUIET);
+			return nan;
+		}
 #endif
-		if (a.iszero()) return a;
-		return cfloat<nbits, es, bt, hasSubnormal, hasSupernormal, isSaturating>(std::sqrt((double)a));  // TBD
-	}
-#else
-	template<unsigned nbits, unsigned es, typename bt, bool hasSubnormal, bool hasSupernormal, bool isSaturating>
-	inline cfloat<nbits, es, bt, hasSubnormal, hasSupernormal, isSaturating> sqrt(const cfloat<nbits, es, bt, hasSubnormal, hasSupernormal, isSaturating>& a) {
-#if CFLOAT_THROW_ARITHMETIC_EXCEPTION
-		if (a.isneg()) throw cfloat_negative_sqrt_arg();
-#else
-		if (a.isneg()) std::cerr << "cfloat argument to sqrt is negative: " << a << std::endl;
+		if (a.isinf()) return a;
+#if !CFLOAT_NATIVE_SQRT
+		if constexpr (Cfloat::isIeee754 || Cfloat::isBinary16 || Cfloat::isBinary128) {
+			auto root = native_sqrt(a.to_ieee754());
+			if (!native_isnan(root)) return Cfloat().from_ieee754(root);
+		}
 #endif
-		if (a.iszero()) return a;
-		return cfloat<nbits, es, bt, hasSubnormal, hasSupernormal, isSaturating>(std::sqrt((double)a));
+		blocktriple<Cfloat::fbits, BlockTripleOperator::SQRT, bt> v, root;
+		a.normalizeSqrt(v);
+		root.sqrt(v);
+		Cfloat result;
+		convert(root, result);
+		return result;
 	}
-#endif
 
 	// reciprocal sqrt
 	template<unsigned nbits, unsigned es, typename bt, bool hasSubnormal, bool hasSupernormal, bool isSaturating>
@@ -0,0 +1,245 @@
+#pragma once
+// native_arithmetic.hpp: native integer arithmetic for cfloat configurations that fit in 64 bits
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <bit>
+#include <universal/native/limb_arithmetic.hpp>
+
+/*
+ The generic cfloat operators normalize their operands into blocktriples, compute, and round
+ the result back through convert(). For a cfloat with nbits <= 64 the significands fit in a
+ native integer, and the same operations reduce to:
+
+     unpack    : significand and exponent of each operand from the raw encoding
+     compute   : add, multiply, or divide the significands in uint64_t, jamming the bits
+                 that fall off into a sticky bit
+     round     : clz-based normalization, round-to-nearest-even, and the same overflow,
+                 underflow, and saturation rules as convert()
+
+ The kernels expect finite, non-zero operands: the cfloat operators dispatch the special
+ cases before they get here. A kernel returns false when it does not cover the configuration
+ or the encoding, in which case the caller falls back to the blocktriple path.
+ */
+
+namespace sw { namespace universal {
+
+// the raw encoding of a cfloat with nbits <= 64
+template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
+inline uint64_t cfloat_native_bits(const cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& v) noexcept {
+	using Cfloat = cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>;
+	static_assert(nbits <= 64, "cfloat_native_bits requires nbits <= 64");
+	uint64_t raw{ 0 };
+	for (unsigned b = 0; b < Cfloat::nrBlocks; ++b) {
+		raw |= uint64_t(v.block(b)) << (b * Cfloat::bitsInBlock);
+	}
+	return raw;
+}
+
+// unpack a finite, non-zero cfloat into value = significand * 2^exponent
+// returns false for a subnormal encoding of a cfloat without subnormals, which the
+// blocktriple path interprets per operator
+template<bool decodeSubnormals, unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
+inline bool cfloat_native_unpack(const cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& v, bool& sign, uint64_t& significand, int& exponent) noexcept {
+	using Cfloat = cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>;
+	constexpr unsigned fbits = Cfloat::fbits;
+	uint64_t raw = cfloat_native_bits(v);
+	sign = ((raw >> (nbits - 1u)) & 1u) != 0;
+	uint64_t fraction = raw & Cfloat::ALL_ONES_FR;
+	int biasedExponent = static_cast<int>((raw >> fbits) & Cfloat::ALL_ONES_ES);
+	if (biasedExponent == 0) {
+		if constexpr (!decodeSubnormals) return false;
+		significand = fraction;
+		exponent = Cfloat::MIN_EXP_SUBNORMAL;
+	}
+	else {
+		significand = fraction | (1ull << fbits);
+		exponent = biasedExponent - Cfloat::EXP_BIAS - static_cast<int>(fbits);
+	}
+	return true;
+}
+
+/// <summary>
+/// round value = (-1)^sign * significand * 2^exponent, plus a sticky remainder below the
+/// significand, to the nearest cfloat, with the overflow, underflow, and saturation rules of convert()
+/// </summary>
+template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
+inline void cfloat_native_round(bool sign, uint64_t significand, int exponent, bool sticky, cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& tgt) noexcept {
+	using Cfloat = cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>;
+	constexpr unsigned fbits = Cfloat::fbits;
+	const uint64_t signBit = (sign ? (1ull << (nbits - 1u)) : 0ull);
+	int scale = exponent + 63 - std::countl_zero(significand);
+
+	// underflow and overflow
+	if constexpr (!hasSubnormals) {
+		if (scale < Cfloat::MIN_EXP_NORMAL) {
+			tgt.setbits(signBit);
+			return;
+		}
+	}
+	if (scale > Cfloat::MAX_EXP) {
+		if constexpr (isSaturating) {
+			if (sign) tgt.maxneg(); else tgt.maxpos();
+		}
+		else {
+			tgt.setinf(sign);
+		}
+		return;
+	}
+
+	// align the significand to the lsb of the target
+	uint64_t biasedExponent{ 0 };
+	int lsbExponent{ 0 };
+	if (scale < Cfloat::MIN_EXP_NORMAL) {
+		lsbExponent = Cfloat::MIN_EXP_SUBNORMAL;
+	}
+	else {
+		biasedExponent = static_cast<uint64_t>(scale + Cfloat::EXP_BIAS);
+		lsbExponent = scale - static_cast<int>(fbits);
+	}
+	int shift = lsbExponent - exponent;
+	uint64_t fracbits{ 0 };
+	bool roundup{ false };
+	if (shift <= 0) {
+		fracbits = significand << -shift; // exact
+	}
+	else {
+		fracbits = (shift < 64 ? (significand >> shift) : 0ull);
+		bool guard = (shift <= 64 ? ((significand >> (shift - 1)) & 1u) != 0 : false);
+		bool rest = sticky || (shift >= 2 && (shift > 64 ? significand != 0 : (significand & ((1ull << (shift - 1)) - 1u)) != 0));
+		roundup = guard && (rest || (fracbits & 1u));
+	}
+	fracbits &= Cfloat::ALL_ONES_FR; // remove the hidden bit
+	if (roundup) ++fracbits;
+	if (fracbits == (1ull << fbits)) {
+		if (biasedExponent == Cfloat::ALL_ONES_ES) {
+			fracbits = Cfloat::INF_ENCODING;
+		}
+		else {
+			++biasedExponent;
+			fracbits = 0;
+		}
+	}
+	tgt.setbits(signBit | (biasedExponent << fbits) | fracbits);
+	if (biasedExponent == Cfloat::ALL_ONES_ES && (tgt.isnan() || tgt.isinf())) {  // without supernormals, rounding up from maxpos yields an inf encoding
+		if constexpr (isSaturating) {
+			if (sign) tgt.maxneg(); else tgt.maxpos();
+		}
+		else {
+			tgt.setinf(sign);
+		}
+	}
+}
+
+// sum of two finite, non-zero cfloats
+template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
+inline bool cfloat_native_add(const cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& lhs, const cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& rhs, cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& sum) noexcept {
+	constexpr unsigned fhbits = nbits - es;
+	if constexpr (nbits > 64 || fhbits > 59) {
+		return false; // too few guard bits left in a uint64_t
+	}
+	else {
+		bool xs, ys;
+		uint64_t x, y;
+		int xe, ye;
+		if (!cfloat_native_unpack<hasSubnormals>(lhs, xs, x, xe)) return false;
+		if (!cfloat_native_unpack<hasSubnormals>(rhs, ys, y, ye)) return false;
+		// normalize both significands to bit 62, leaving bit 63 for the carry
+		int xshift = std::countl_zero(x) - 1;
+		int yshift = std::countl_zero(y) - 1;
+		x <<= xshift; xe -= xshift;
+		y <<= yshift; ye -= yshift;
+		if (xe < ye || (xe == ye && x < y)) {
+			std::swap(x, y); std::swap(xe, ye); std::swap(xs, ys);
+		}
+		// align the smaller operand and jam the bits that fall off into the lsb
+		int d = xe - ye;
+		if (d > 0) {
+			bool sticky = (d >= 64 ? y != 0 : (y & ((1ull << d) - 1u)) != 0);
+			y = (d >= 64 ? 0ull : (y >> d));
+			y |= (sticky ? 1u : 0u);
+		}
+		uint64_t s = (xs == ys ? x + y : x - y);
+		if (s == 0) {
+			sum.setzero(); // exact cancellation yields +0
+			return true;
+		}
+		cfloat_native_round(xs, s, xe, false, sum);
+		return true;
+	}
+}
+
+// product of two finite, non-zero cfloats
+template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
+inline bool cfloat_native_mul(const cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& lhs, const cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& rhs, cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& product) noexcept {
+	constexpr unsigned fhbits = nbits - es;
+	if constexpr (nbits > 64) {
+		return false;
+	}
+	else {
+		bool xs, ys;
+		uint64_t x, y;
+		int xe, ye;
+		if (!cfloat_native_unpack<hasSubnormals>(lhs, xs, x, xe)) return false;
+		if (!cfloat_native_unpack<hasSubnormals>(rhs, ys, y, ye)) return false;
+		if constexpr (2 * fhbits <= 64) {
+			cfloat_native_round(xs != ys, x * y, xe + ye, false, product);
+		}
+		else {
+			uint64_t hi{ 0 };
+			uint64_t lo = mulwide(x, y, hi);
+			if (hi == 0) {
+				cfloat_native_round(xs != ys, lo, xe + ye, false, product);
+			}
+			else {
+				// keep the upper 64 bits of the product and fold the rest into the sticky bit
+				int s = 64 - std::countl_zero(hi);
+				uint64_t p = (hi << (64 - s)) | (lo >> s);
+				bool sticky = (lo & ((1ull << s) - 1u)) != 0;
+				cfloat_native_round(xs != ys, p, xe + ye + s, sticky, product);
+			}
+		}
+		return true;
+	}
+}
+
+// quotient of two finite, non-zero cfloats
+template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
+inline bool cfloat_native_div(const cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& lhs, const cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& rhs, cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& quotient) noexcept {
+	constexpr unsigned fhbits = nbits - es;
+	if constexpr (nbits > 64) {
+		return false;
+	}
+	else {
+		bool xs, ys;
+		uint64_t x, y;
+		int xe, ye;
+		// the blocktriple division interprets subnormal encodings by value in all configurations
+		cfloat_native_unpack<true>(lhs, xs, x, xe);
+		cfloat_native_unpack<true>(rhs, ys, y, ye);
+		// normalize the dividend to bit 62, so that the quotient carries at least fhbits + 2 bits
+		int xshift = std::countl_zero(x) - 1;
+		x <<= xshift; xe -= xshift;
+		uint64_t q{ 0 }, r{ 0 };
+		if constexpr (fhbits <= 29) {
+			// divisor at bit 31: the quotient falls in [2^30, 2^32)
+			int yshift = std::countl_zero(y) - 32;
+			y <<= yshift; ye -= yshift;
+			q = x / y;
+			r = x - q * y;
+			cfloat_native_round(xs != ys, q, xe - ye, r != 0, quotient);
+		}
+		else {
+			// divisor at bit 63 and a 128-by-64 division: the quotient falls in [2^62, 2^64)
+			int yshift = std::countl_zero(y);
+			y <<= yshift; ye -= yshift;
+			q = divwide(x, uint64_t(0), y, r);
+			cfloat_native_round(xs != ys, q, xe - ye - 64, r != 0, quotient);
+		}
+		return true;
+	}
+}
+
+}} // namespace sw::universal
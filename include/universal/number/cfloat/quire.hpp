@@ -0,0 +1,370 @@
+#pragma once
+// quire.hpp: definition of a super-accumulator for cfloat fused dot products
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <bit>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <universal/native/limb_arithmetic.hpp>
+
+/*
+ A cfloat_quire is a Kulisch super-accumulator: a two's complement fixed-point
+ register wide enough to hold any product of two finite cfloats exactly, plus
+ 2^capacity of them before it can overflow.
+
+ The radix point sits at twice the scale of the smallest ulp of the cfloat,
+ and the upper part covers twice the scale of maxpos plus the carry of the
+ significand product. Products are placed in the register with a three-limb
+ add or subtract followed by a carry ripple that stops at the first limb that
+ does not carry, so accumulation cost is independent of the size of the quire.
+ Rounding only happens when the quire is converted back to a cfloat.
+
+ The posit quire owns the class template name quire<nbits, es, capacity>,
+ hence the distinct name for the cfloat super-accumulator.
+ */
+
+namespace sw { namespace universal {
+
+template<typename CfloatType, unsigned capacity = 30>
+class cfloat_quire {
+public:
+	using Cfloat = CfloatType;
+	using bt = typename Cfloat::BlockType;
+	using ProductTriple = blocktriple<Cfloat::fbits, BlockTripleOperator::MUL, bt>;
+	static_assert(Cfloat::fbits < 64, "cfloat_quire requires a significand that fits in 64 bits");
+
+	static constexpr unsigned fbits = Cfloat::fbits;
+	// scale of the least significant bit of the smallest nonzero cfloat
+	static constexpr int      min_ulp_scale = (Cfloat::hasSubnormals ? Cfloat::MIN_EXP_SUBNORMAL : Cfloat::MIN_EXP_NORMAL - int(fbits));
+	static constexpr int      max_scale = Cfloat::MAX_EXP;
+	static_assert(min_ulp_scale <= 0, "cfloat_quire requires a cfloat with fraction bits");
+	static constexpr unsigned radix_point = unsigned(-2 * min_ulp_scale);        // bit position of 2^0
+	static constexpr unsigned upper_range = unsigned(2 * max_scale + 2);         // maxpos^2 < 2^(2*max_scale + 2)
+	static constexpr unsigned qbits = radix_point + upper_range + capacity + 1u; // including the sign bit
+	static constexpr unsigned bitsInLimb = 64;
+	static constexpr unsigned nrLimbs = (qbits + bitsInLimb - 1u) / bitsInLimb;
+	static constexpr unsigned MSU = nrLimbs - 1u;
+
+	cfloat_quire() noexcept : _limb{}, _nan{ false }, _inf{ false }, _infSign{ false } {}
+	cfloat_quire(const cfloat_quire&) noexcept = default;
+	cfloat_quire& operator=(const cfloat_quire&) noexcept = default;
+
+	cfloat_quire(const Cfloat& rhs) noexcept : cfloat_quire() { *this += rhs; }
+	cfloat_quire& operator=(const Cfloat& rhs) noexcept { clear(); return *this += rhs; }
+
+	// accumulate a single cfloat
+	cfloat_quire& operator+=(const Cfloat& rhs) noexcept { return accumulate(rhs, false); }
+	cfloat_quire& operator-=(const Cfloat& rhs) noexcept { return accumulate(rhs, true); }
+
+	// accumulate an unrounded product generated by quire_mul
+	cfloat_quire& operator+=(const ProductTriple& rhs) noexcept { return accumulate(rhs, false); }
+	cfloat_quire& operator-=(const ProductTriple& rhs) noexcept { return accumulate(rhs, true); }
+
+	// accumulate another quire
+	cfloat_quire& operator+=(const cfloat_quire& rhs) noexcept {
+		if (rhs._nan) setnan();
+		else if (rhs._inf) setinf(rhs._infSign);
+		bool carry{ false };
+		for (unsigned i = 0; i < nrLimbs; ++i) _limb[i] = addcarry(_limb[i], rhs._limb[i], carry);
+		return *this;
+	}
+	cfloat_quire& operator-=(const cfloat_quire& rhs) noexcept {
+		if (rhs._nan) setnan();
+		else if (rhs._inf) setinf(!rhs._infSign);
+		bool borrow{ false };
+		for (unsigned i = 0; i < nrLimbs; ++i) _limb[i] = subborrow(_limb[i], rhs._limb[i], borrow);
+		return *this;
+	}
+
+	/// <summary>
+	/// fused multiply-accumulate: add the exact product of two cfloats without
+	/// materializing a blocktriple. This is the inner loop of the fused dot product.
+	/// </summary>
+	void add_product(const Cfloat& lhs, const Cfloat& rhs) noexcept {
+		std::uint64_t a{ 0 }, b{ 0 };
+		int ascale{ 0 }, bscale{ 0 };
+		int atype = decode(lhs, a, ascale);
+		int btype = decode(rhs, b, bscale);
+		bool negative = (lhs.sign() != rhs.sign());
+		if (atype == FINITE && btype == FINITE) {
+			std::uint64_t hi{ 0 };
+			std::uint64_t lo = mulwide(a, b, hi);
+			place(hi, lo, ascale + bscale, negative);
+		}
+		else if (atype == NOT_A_NUMBER || btype == NOT_A_NUMBER) {
+			setnan();
+		}
+		else if (atype == INFINITE || btype == INFINITE) {
+			if (atype == ZERO || btype == ZERO) setnan(); else setinf(negative);
+		}
+	}
+
+	// modifiers
+	void clear() noexcept {
+		for (unsigned i = 0; i < nrLimbs; ++i) _limb[i] = 0;
+		_nan = false;
+		_inf = false;
+		_infSign = false;
+	}
+	void reset() noexcept { clear(); }
+
+	// selectors
+	bool iszero() const noexcept {
+		if (_nan || _inf) return false;
+		for (unsigned i = 0; i < nrLimbs; ++i) if (_limb[i] != 0) return false;
+		return true;
+	}
+	bool isnan() const noexcept { return _nan; }
+	bool isinf() const noexcept { return !_nan && _inf; }
+	bool isneg() const noexcept { return (_inf && !_nan) ? _infSign : (_limb[MSU] >> (bitsInLimb - 1u)) != 0; }
+	bool sign()  const noexcept { return isneg(); }
+	std::uint64_t limb(unsigned i) const noexcept { return (i < nrLimbs ? _limb[i] : 0); }
+
+	/// <summary>
+	/// scale of the most significant bit of the magnitude of the accumulation
+	/// </summary>
+	/// <returns>scale of the msb, or min_ulp_scale - 1 when the quire is zero</returns>
+	int scale() const noexcept {
+		std::uint64_t magnitude[nrLimbs];
+		absolute(magnitude);
+		int msb = msbpos(magnitude);
+		return (msb < 0 ? 2 * min_ulp_scale - 1 : msb - int(radix_point));
+	}
+
+	/// <summary>
+	/// round the accumulation to the target cfloat: this is the one and only rounding step
+	/// </summary>
+	/// <param name="tgt">resulting cfloat</param>
+	void to_cfloat(Cfloat& tgt) const {
+		if (_nan) { tgt.setnan(NAN_TYPE_QUIET); return; }
+		if (_inf) { tgt.setinf(_infSign); return; }
+		std::uint64_t magnitude[nrLimbs];
+		bool negative = absolute(magnitude);
+		int msb = msbpos(magnitude);
+		if (msb < 0) { tgt.setzero(); return; }
+
+		// gather the msb and the next fbits + 2 bits into the ADD format 001.ffff'grs
+		// of a blocktriple, and fold all the remaining lower bits into the sticky bit
+		using AddTriple = blocktriple<fbits, BlockTripleOperator::ADD, bt>;
+		constexpr unsigned abits = AddTriple::abits;
+		int lsb = msb - int(abits);
+		AddTriple triple;
+		triple.setnormal();
+		triple.setsign(negative);
+		triple.setscale(msb - int(radix_point));
+		triple.setradix();
+		for (unsigned b = 0; b < AddTriple::Significant::nrBlocks; ++b) {
+			triple.setblock(b, bt(extract(magnitude, lsb + int(b * AddTriple::bitsInBlock))));
+		}
+		if (sticky(magnitude, lsb)) triple.setbit(0);
+		convert(triple, tgt);
+	}
+
+private:
+	std::uint64_t _limb[nrLimbs];
+	bool          _nan;
+	bool          _inf;
+	bool          _infSign;
+
+	enum { ZERO, FINITE, INFINITE, NOT_A_NUMBER };
+
+	void setnan() noexcept { _nan = true; }
+	void setinf(bool sign) noexcept {
+		if (_inf && _infSign != sign) _nan = true;   // inf - inf
+		_inf = true;
+		_infSign = sign;
+	}
+
+	// decode a cfloat into an integer significand and the scale of its lsb
+	static int decode(const Cfloat& v, std::uint64_t& significand, int& lsbScale) noexcept {
+		if (v.isnan()) return NOT_A_NUMBER;
+		if (v.isinf()) return INFINITE;
+		std::uint64_t raw{ 0 };
+		for (unsigned b = 0; b < Cfloat::nrBlocks; ++b) {
+			raw |= std::uint64_t(v.block(b)) << (b * Cfloat::bitsInBlock);
+		}
+		std::uint64_t fraction = raw & (0xFFFF'FFFF'FFFF'FFFFull >> (64u - fbits));
+		std::uint64_t exponent = (raw >> fbits) & Cfloat::ALL_ONES_ES;
+		if (exponent == 0) {
+			if constexpr (!Cfloat::hasSubnormals) return ZERO;
+			if (fraction == 0) return ZERO;
+			significand = fraction;
+			lsbScale = Cfloat::MIN_EXP_SUBNORMAL;
+			return FINITE;
+		}
+		if constexpr (!Cfloat::hasSupernormals) {
+			if (exponent == Cfloat::ALL_ONES_ES) return NOT_A_NUMBER;
+		}
+		significand = fraction | (1ull << fbits);
+		lsbScale = int(exponent) - Cfloat::EXP_BIAS - int(fbits);
+		return FINITE;
+	}
+
+	cfloat_quire& accumulate(const Cfloat& v, bool subtract) noexcept {
+		std::uint64_t significand{ 0 };
+		int lsbScale{ 0 };
+		bool negative = (v.sign() != subtract);
+		switch (decode(v, significand, lsbScale)) {
+		case FINITE:
+			place(0, significand, lsbScale, negative);
+			break;
+		case INFINITE:
+			setinf(negative);
+			break;
+		case NOT_A_NUMBER:
+			setnan();
+			break;
+		default:
+			break;
+		}
+		return *this;
+	}
+
+	cfloat_quire& accumulate(const ProductTriple& v, bool subtract) noexcept {
+		if (v.isnan()) { setnan(); return *this; }
+		bool negative = (v.sign() != subtract);
+		if (v.isinf()) { setinf(negative); return *this; }
+		if (v.iszero()) return *this;
+		std::uint64_t lo{ 0 }, hi{ 0 };
+		for (unsigned b = 0; b < ProductTriple::Significant::nrBlocks; ++b) {
+			unsigned pos = b * ProductTriple::bitsInBlock;
+			std::uint64_t block = std::uint64_t(v.block(b));
+			if (pos < 64) lo |= block << pos; else hi |= block << (pos - 64);
+			if (pos < 64 && pos + ProductTriple::bitsInBlock > 64) hi |= block >> (64 - pos);
+		}
+		place(hi, lo, v.scale() - int(2 * fbits), negative);
+		return *this;
+	}
+
+	// add or subtract the 128-bit unsigned integer hi:lo scaled by 2^lsbScale
+	void place(std::uint64_t hi, std::uint64_t lo, int lsbScale, bool subtract) noexcept {
+		int pos = int(radix_point) + lsbScale;
+		if (pos < 0) {
+			// only normalized products of subnormals can reach below the lsb of the quire,
+			// and the bits that are shifted out are zero
+			unsigned rightShift = unsigned(-pos);
+			if (rightShift >= 64) { lo = hi >> (rightShift - 64); hi = 0; }
+			else { lo = (lo >> rightShift) | (hi << (64 - rightShift)); hi >>= rightShift; }
+			pos = 0;
+		}
+		unsigned i = unsigned(pos) / bitsInLimb;
+		unsigned shift = unsigned(pos) % bitsInLimb;
+		std::uint64_t w[3];
+		w[0] = lo << shift;
+		w[1] = (shift == 0 ? hi : (hi << shift) | (lo >> (bitsInLimb - shift)));
+		w[2] = (shift == 0 ? 0 : hi >> (bitsInLimb - shift));
+		bool carry{ false };
+		if (subtract) {
+			for (unsigned j = 0; j < 3 && i < nrLimbs; ++j, ++i) _limb[i] = subborrow(_limb[i], w[j], carry);
+			for (; carry && i < nrLimbs; ++i) _limb[i] = subborrow(_limb[i], std::uint64_t(0), carry);
+		}
+		else {
+			for (unsigned j = 0; j < 3 && i < nrLimbs; ++j, ++i) _limb[i] = addcarry(_limb[i], w[j], carry);
+			for (; carry && i < nrLimbs; ++i) _limb[i] = addcarry(_limb[i], std::uint64_t(0), carry);
+		}
+	}
+
+	// write the magnitude of the accumulation into m and return the sign
+	bool absolute(std::uint64_t (&m)[nrLimbs]) const noexcept {
+		bool negative = (_limb[MSU] >> (bitsInLimb - 1u)) != 0;
+		bool borrow{ false };
+		for (unsigned i = 0; i < nrLimbs; ++i) {
+			m[i] = (negative ? subborrow(std::uint64_t(0), _limb[i], borrow) : _limb[i]);
+		}
+		return negative;
+	}
+
+	static int msbpos(const std::uint64_t (&m)[nrLimbs]) noexcept {
+		for (int i = int(MSU); i >= 0; --i) {
+			if (m[i] != 0) return i * int(bitsInLimb) + int(bitsInLimb) - 1 - std::countl_zero(m[i]);
+		}
+		return -1;
+	}
+
+	// the 64 bits of m starting at bit position pos, which may be negative
+	static std::uint64_t extract(const std::uint64_t (&m)[nrLimbs], int pos) noexcept {
+		if (pos <= -int(bitsInLimb) || pos >= int(nrLimbs * bitsInLimb)) return 0;
+		if (pos < 0) return m[0] << unsigned(-pos);
+		unsigned i = unsigned(pos) / bitsInLimb;
+		unsigned shift = unsigned(pos) % bitsInLimb;
+		std::uint64_t bits = m[i] >> shift;
+		if (shift != 0 && i + 1 < nrLimbs) bits |= m[i + 1] << (bitsInLimb - shift);
+		return bits;
+	}
+
+	// are any of the bits below position pos set
+	static bool sticky(const std::uint64_t (&m)[nrLimbs], int pos) noexcept {
+		if (pos <= 0) return false;
+		unsigned top = unsigned(pos) / bitsInLimb;
+		for (unsigned i = 0; i < top && i < nrLimbs; ++i) if (m[i] != 0) return true;
+		unsigned shift = unsigned(pos) % bitsInLimb;
+		return (shift != 0 && top < nrLimbs && (m[top] & ((1ull << shift) - 1ull)) != 0);
+	}
+
+	template<typename C, unsigned c>
+	friend std::ostream& operator<<(std::ostream& ostr, const cfloat_quire<C, c>& q);
+};
+
+// generate the unrounded product of two cfloats for accumulation in a cfloat_quire
+template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating>
+blocktriple<nbits - 1u - es, BlockTripleOperator::MUL, bt> quire_mul(const cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& lhs, const cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>& rhs) {
+	constexpr unsigned fbits = nbits - 1u - es;
+	blocktriple<fbits, BlockTripleOperator::MUL, bt> a, b, product;
+	bool negative = (lhs.sign() != rhs.sign());
+	if (lhs.isnan() || rhs.isnan()) {
+		product.setnan();
+	}
+	else if (lhs.isinf() || rhs.isinf()) {
+		if (lhs.iszero() || rhs.iszero()) product.setnan(); else product.setinf(negative);
+	}
+	else if (lhs.iszero() || rhs.iszero()) {
+		product.setzero(negative);
+	}
+	else {
+		lhs.normalizeMultiplication(a);
+		rhs.normalizeMultiplication(b);
+		product.mul(a, b);
+	}
+	return product;
+}
+
+// round the quire to the cfloat it accumulates
+template<typename Cfloat, unsigned capacity>
+inline void convert(const cfloat_quire<Cfloat, capacity>& q, Cfloat& tgt) {
+	q.to_cfloat(tgt);
+}
+
+// generate the properties of a cfloat quire configuration
+template<typename Cfloat, unsigned capacity = 30>
+std::string cfloat_quire_properties() {
+	using Quire = cfloat_quire<Cfloat, capacity>;
+	std::stringstream ss;
+	ss << "Properties of a cfloat_quire<" << type_tag(Cfloat()) << ", " << capacity << ">\n";
+	ss << "  radix point of accumulator : " << Quire::radix_point << '\n';
+	ss << "  upper quire size in bits   : " << Quire::upper_range << '\n';
+	ss << "  capacity bits              : " << capacity << '\n';
+	ss << "  full quire size in bits    : " << Quire::qbits << '\n';
+	ss << "  number of 64-bit limbs     : " << Quire::nrLimbs << '\n';
+	return ss.str();
+}
+
+// print the two's complement accumulator as hexadecimal limbs, most significant limb first
+template<typename Cfloat, unsigned capacity>
+std::ostream& operator<<(std::ostream& ostr, const cfloat_quire<Cfloat, capacity>& q) {
+	using Quire = cfloat_quire<Cfloat, capacity>;
+	if (q.isnan()) return ostr << "nan";
+	if (q.isinf()) return ostr << (q.sign() ? "-inf" : "+inf");
+	std::stringstream ss;
+	ss << std::hex << std::setfill('0');
+	for (int i = int(Quire::MSU); i >= 0; --i) {
+		ss << std::setw(16) << q._limb[i] << (i > 0 ? "'" : "");
+	}
+	return ostr << ss.str();
+}
+
+}} // namespace sw::universal
@@ -0,0 +1,55 @@
+#pragma once
+// addition_table.hpp: precomputed addition and subtraction tables for small double-base number configurations
+//
+// Copyright (C) 2022-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <vector>
+
+namespace sw { namespace universal {
+
+/// <summary>
+/// Sum and difference of every pair of dbns magnitudes, indexed by the magnitude encodings.
+/// The tables are generated once through the reference conversion, so the native adder
+/// reproduces the rounding of the double round trip bit for bit.
+/// </summary>
+template<typename DbnsType>
+class DbnsAdditionTable {
+public:
+	using BlockType = typename DbnsType::BlockType;
+	static constexpr unsigned nbits = DbnsType::nbits;
+	static_assert(nbits <= 8, "DbnsAdditionTable: configuration is too large to tabulate");
+	static constexpr std::size_t NR_MAGNITUDES = (std::size_t(1) << (nbits - 1));
+
+	static const DbnsAdditionTable& instance() {
+		static const DbnsAdditionTable table;
+		return table;
+	}
+
+	// encoding of |x| + |y|
+	BlockType sum(std::size_t x, std::size_t y) const noexcept { return _sum[x * NR_MAGNITUDES + y]; }
+	// encoding of |x| - |y|, carrying the sign of the difference
+	BlockType difference(std::size_t x, std::size_t y) const noexcept { return _difference[x * NR_MAGNITUDES + y]; }
+
+private:
+	std::vector<BlockType> _sum, _difference;
+
+	DbnsAdditionTable() : _sum(NR_MAGNITUDES * NR_MAGNITUDES), _difference(NR_MAGNITUDES * NR_MAGNITUDES) {
+		DbnsType a, b, c;
+		for (std::size_t i = 0; i < NR_MAGNITUDES; ++i) {
+			a.setbits(i);
+			double da = (a.iszero() ? 0.0 : double(a));
+			for (std::size_t j = 0; j < NR_MAGNITUDES; ++j) {
+				b.setbits(j);
+				double db = (b.iszero() ? 0.0 : double(b));
+				c = da + db;
+				_sum[i * NR_MAGNITUDES + j] = c.block(0);
+				c = da - db;
+				_difference[i * NR_MAGNITUDES + j] = c.block(0);
+			}
+		}
+	}
+};
+
+}} // namespace sw::universal
@@ -12,6 +12,7 @@
 #include <universal/number/shared/specific_value_encoding.hpp>
 #include <universal/behavior/arithmetic.hpp>
 #include <universal/number/dbns/dbns_fwd.hpp>
+#include <universal/number/dbns/addition_table.hpp>
 
 namespace sw { namespace universal {
 		
@@ -194,27 +195,13 @@ public:
 
 	// in-place arithmetic assignment operators
 	dbns& operator+=(const dbns& rhs) {
-		double sum{ 0.0 };
-		if constexpr (behavior == Behavior::Saturating) {
-			sum = double(*this) + double(rhs);  // TODO: native implementation
-		}
-		else {
-			sum = double(*this) + double(rhs);  // TODO: native implementation
-		}
-		return *this = sum; // <-- saturation happens in the assignment
+		return add(rhs, false);
 	}
 	dbns& operator+=(double rhs) { 
 		return operator+=(dbns(rhs));
 	}
 	dbns& operator-=(const dbns& rhs) { 
-		double diff{ 0.0 };
-		if constexpr (behavior == Behavior::Saturating) {
-			diff = double(*this) - double(rhs);  // TODO: native implementation
-		}
-		else {
-			diff = double(*this) - double(rhs);  // TODO: native implementation
-		}
-		return *this = diff; // <-- saturation happens in the assignment
+		return add(rhs, true);
 	}
 	dbns& operator-=(double rhs) {
 		return operator-=(dbns(rhs));
@@ -397,11 +384,13 @@ public:
 	constexpr void setinf(bool sign = false)       noexcept { (sign ? maxneg() : maxpos()); } // TODO: is that what we want?
 	constexpr void setsign(bool s = true)          noexcept { setbit(nbits - 1, s); }
 	constexpr void setbit(unsigned i, bool v = true) noexcept {
+		// guard on the block index and keep bits outside of nbits at 0: a branch on nbits creates
+		// bodies that differ only in value ranges, which gcc 12 identical code folding merges across sizes
 		unsigned blockIndex = i / bitsInBlock;
-		if (i < nbits) {
+		if (blockIndex < nrBlocks) {
 			bt block = _block[blockIndex];
 			bt null = ~(1ull << (i % bitsInBlock));
-			bt bit = bt(v ? 1 : 0);
+			bt bit = bt((v && i < nbits) ? 1 : 0);
 			bt mask = bt(bit << (i % bitsInBlock));
 			_block[blockIndex] = bt((block & null) | mask);
 		}
@@ -622,6 +611,101 @@ public:
 
 protected:
 
+	/// <summary>
+	/// native addition: small configurations look up the sum of the magnitudes in precomputed tables,
+	/// larger configurations add in the logarithmic domain and search for the nearest representation
+	/// </summary>
+	/// <param name="rhs">the addend</param>
+	/// <param name="negate">subtract rhs instead of adding it</param>
+	/// <returns>reference to this dbns object</returns>
+	dbns& add(const dbns& rhs, bool negate) {
+		if (isnan()) return *this;
+		if (rhs.isnan()) {
+			setnan();
+			return *this;
+		}
+		if (rhs.iszero()) return *this;
+		if (iszero()) return *this = (negate ? -rhs : rhs);
+		bool lsign = sign();
+		bool rsign = (rhs.sign() != negate);
+		if constexpr (nbits <= 8) {
+			const DbnsAdditionTable<dbns>& table = DbnsAdditionTable<dbns>::instance();
+			std::size_t x = static_cast<std::size_t>(_block[0] & ~SIGN_BIT_MASK);
+			std::size_t y = static_cast<std::size_t>(rhs._block[0] & ~SIGN_BIT_MASK);
+			_block[0] = (lsign == rsign ? table.sum(x, y) : table.difference(x, y));
+			if (lsign) *this = -(*this); // the tables are built for a positive left hand side
+		}
+		else {
+			double lx = logarithm(), ly = rhs.logarithm();
+			// order the operands by magnitude: the result carries the sign of the larger one
+			bool negative = (lx >= ly ? lsign : rsign);
+			double x = (lx >= ly ? lx : ly);
+			double distance = (lx >= ly ? lx - ly : ly - lx);
+			double target{ 0.0 };
+			if (lsign == rsign) {
+				target = x + std::log2(1.0 + std::exp2(-distance));
+			}
+			else {
+				if (distance == 0.0) { // X - X: log2(3) is irrational, so equal logarithms imply equal exponents
+					setzero();
+					return *this;
+				}
+				target = x + std::log2(-std::expm1(-distance * 0.69314718055994530942));
+			}
+			assign_logarithm(target, negative);
+		}
+		return *this;
+	}
+
+	// log2 of the magnitude: 0.5^a * 3^b = 2^(b * log2(3) - a)
+	double logarithm() const noexcept {
+		return static_cast<double>(extractExponent(1)) * log2of3 - static_cast<double>(extractExponent(0));
+	}
+
+	/// <summary>
+	/// set the encoding to the representation closest to 2^target in the logarithmic domain.
+	/// For every second base exponent b, the best first base exponent is a = round(b * log2(3) - target),
+	/// so only the b for which that a fits in the first base field need to be visited:
+	/// (target - 0.5) / log2(3) <= b <= (target + MAX_A + 0.5) / log2(3)
+	/// </summary>
+	/// <param name="target">log2 of the magnitude to represent</param>
+	/// <param name="negative">sign of the result</param>
+	void assign_logarithm(double target, bool negative) {
+		// the smallest positive value is minpos = 0.5^(MAX_A - 1): round to zero below half of it
+		if (target < -(static_cast<double>(MAX_A) - 1.0) - 0.5) {
+			if constexpr (bCollectDbnsEventStatistics) ++dbnsStats.roundingFailure;
+			setzero();
+			return;
+		}
+		if (target >= static_cast<double>(MAX_B) * log2of3) {
+			if constexpr (bCollectDbnsEventStatistics) ++dbnsStats.roundingFailure;
+			negative ? maxneg() : maxpos();
+			return;
+		}
+		double lowerBound = std::ceil((target - 0.5) / log2of3);
+		double upperBound = std::floor((target + static_cast<double>(MAX_A) + 0.5) / log2of3);
+		int64_t bLow = (lowerBound < 0.0 ? 0 : static_cast<int64_t>(lowerBound));
+		int64_t bHigh = (upperBound > static_cast<double>(MAX_B) ? static_cast<int64_t>(MAX_B) : static_cast<int64_t>(upperBound));
+		double lowestError = 1.0e10;
+		int64_t best_a{ 0 }, best_b{ static_cast<int64_t>(MAX_B) };
+		double distance = static_cast<double>(bLow) * log2of3 - target; // b * log2(3) - target, which is >= -0.5 in the search range
+		for (int64_t b = bLow; b <= bHigh; ++b, distance += log2of3) {
+			int64_t a = (distance < -0.5 ? 0 : static_cast<int64_t>(distance + 0.5)); // round to nearest
+			if (a > static_cast<int64_t>(MAX_A)) a = static_cast<int64_t>(MAX_A);
+			if (a == static_cast<int64_t>(MAX_A) && b == 0) a = static_cast<int64_t>(MAX_A) - 1; // zero encoding
+			double err = std::abs(distance - static_cast<double>(a));
+			if (err < lowestError) {
+				lowestError = err;
+				best_a = a;
+				best_b = b;
+			}
+		}
+		clear();
+		setexponent(0, static_cast<uint32_t>(best_a));
+		setexponent(1, static_cast<uint32_t>(best_b));
+		setsign(negative);
+	}
+
 	/// <summary>
 	/// 1's complement of the encoding. Used internally to create specific bit patterns
 	/// </summary>
@@ -661,8 +745,6 @@ protected:
 		if constexpr (bCollectDbnsEventStatistics) ++dbnsStats.conversionEvents;
 		using std::abs;
 		using std::log2;
-		using std::pow;
-		using std::round;
 		bool s{ false };
 		uint64_t unbiasedExponent{ 0 };
 		uint64_t rawFraction{ 0 };
@@ -698,93 +780,10 @@ protected:
 			return *this;
 		}
 
-		// it is too expensive to check if the value is in the representable range
-		// the search below will end up at 0 or maxpos
-
-		// we search for the a and b in v = 2^a * 3^b, with both a and b positive
-		// in our representation we have 0.5^a * 3^b, which would be equivalent
-		// to a being negative
-		// 
-		// v = 2^a * 3^b =>
-		// v = 2^(a + b*log2of3) =>
-		// scale of v = (a + b*log2of3)
-		// we use this relationship to search among the second base exponents 
-		// and find a first base exponent that minimizes the error
-		// between the result and the value we are trying to approximate.
-		constexpr bool bDebug = false;
-		double scale = log2(abs(v)); 
-		if constexpr (bDebug) std::cout << "scale : " << scale << '\n';
-		double lowestError = 1.0e10;
-		int best_a = std::numeric_limits<int>::max();
-		int best_b = std::numeric_limits<int>::max();
-		for (int b = 0; b <= static_cast<int>(SB_MASK); ++b) {
-			int a = static_cast<int>(round((scale - b * log2of3))); // find the first base exponent that is closest to the value
-			if (a > 0 || a > static_cast<int>(MAX_A)) {
-				if constexpr (bCollectDbnsEventStatistics) ++dbnsStats.exponentOverflowDuringSearch;
-				continue;
-			}
-			double err = abs(scale - (a + b * log2of3));
-			if constexpr (bDebug) {
-				double fb = pow(2.0, a);
-				double sb = pow(3.0, b);
-				double value = fb * sb;
-				std::cout << "a : " << a << " b : " << b << " err : " << err << " fb : " << fb << " sb : " << sb << " value : " << value << '\n';
-			}
-			if (err < lowestError) {
-				lowestError = err;
-				best_a = a;
-				best_b = b;
-			}
-		}
-		if constexpr (bDebug) std::cout << "best a : " << best_a << " best b : " << best_b << " lowest err : " << lowestError << '\n';
-		assert(best_b >= 0); // second exponent is negative
-		clear();
-		int a = -best_a;
-		int b = best_b;
-		if (a < 0 || a > static_cast<int>(MAX_A) || b > static_cast<int>(MAX_B)) {
-			// try to project the value back into valid pairs
-			// the approximations of unity looks like (8,-5), (19,-12), (84,-53),... 
-			// they grow too fast and in a rather irregular manner. There are more 
-			// subtle number theoretic considerations, but the ones outlined above 
-			// should be sufficient to figure out a good solution to the problem.
-			// 2^3*3^-2 = 0.888  2^-3*3^2 = 1.125
-			// 2^8*3^-5 = 1.053  2^-8*3^5 = 0.949
-			// multiplier   0.5, 1.5, 0.6, 0.889, 1.125, 0.949, 1.053.....
-			int first[]  = { 1, 1, -1, 3, -3, 5, -5, 8, -8, 19, -19, 84, -84 };
-			int second[] = { 0, 1, -1, 2, -2, 3, -3, 5, -5, 12, -12, 53, -53 };
-			bool unableToAdjust{ true };
-			for (unsigned i = 0; i < 13; ++i) {
-				int adjusted_a = a - first[i];
-				int adjusted_b = b - second[i];
-				if (adjusted_a >= 0 && adjusted_a < static_cast<int>(MAX_A) && adjusted_b >= 0 && adjusted_b < static_cast<int>(MAX_B)) {
-					setexponent(0, static_cast<unsigned>(adjusted_a));
-					setexponent(1, static_cast<unsigned>(adjusted_b));
-					setsign(s);
-					unableToAdjust = false;
-					break;
-				}
-			}
-			if (unableToAdjust) {
-				if constexpr (bCollectDbnsEventStatistics) ++dbnsStats.roundingFailure;
-				//if (a > b) {
-				if (best_a < 0 && best_b >= 0) {
-					setexponent(0, MAX_A);
-					setexponent(1, 0);
-					setsign(false); // we need to avoid nan(ind)
-				}
-				else {   // we have maxed out
-					setexponent(0, 0);
-					setexponent(1, MAX_B);
-					setsign(s);
-				}
-			}
-		}
-		else {
-			a <<= sbbits;
-			_block[MSU] = static_cast<bt>(static_cast<bt>(s ? SIGN_BIT_MASK : 0u) | static_cast<bt>(a) | static_cast<bt>(b));
-		}
-		// avoid assigning to nan(ind)
-		if (isnan()) setzero();
+		// we search for the a and b in v = 2^-a * 3^b, with both a and b positive:
+		// scale of v = (b*log2of3 - a), so we search the representation that is
+		// closest to the scale of v in the logarithmic domain
+		assign_logarithm(static_cast<double>(log2(abs(v))), s);
 		return *this;
 	}
 
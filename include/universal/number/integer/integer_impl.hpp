@@ -17,6 +17,7 @@
 #include <universal/number/shared/specific_value_encoding.hpp>
 #include <universal/number/shared/blocktype.hpp>
 #include <universal/native/integers.hpp> // just for printing native integers in binary form
+#include <universal/native/limb_multiplication.hpp>
 
 /*
 the integer arithmetic can be configured to:
@@ -279,27 +280,17 @@ public:
 			_block[MSU] = static_cast<bt>(MSU_MASK & _block[MSU]);
 		}
 		else {
-			integer<nbits, BlockType, NumberType> sum;
-			std::uint64_t carry = 0;
-			BlockType* pA = _block;
-			BlockType const* pB = rhs._block;
-			BlockType* pC = sum._block;
-			BlockType* pEnd = pC + nrBlocks;
-			while (pC != pEnd) {
-				carry += static_cast<std::uint64_t>(*pA) + static_cast<std::uint64_t>(*pB);
-				*pC = static_cast<bt>(carry);
-				if constexpr (bitsInBlock == 64) carry = 0; else carry >>= bitsInBlock;
-				++pA; ++pB; ++pC;
+			bool carry = false;
+			for (unsigned i = 0; i < nrBlocks; ++i) {
+				_block[i] = addcarry(_block[i], rhs._block[i], carry);
 			}
 			// enforce precondition for fast comparison by properly nulling bits that are outside of nbits
-			BlockType* pLast = pEnd - 1;
-			*pLast = static_cast<bt>(MSU_MASK & *pLast);
+			_block[MSU] = static_cast<bt>(MSU_MASK & _block[MSU]);
 	#if INTEGER_THROW_ARITHMETIC_EXCEPTION
 			// TODO: what is the real overflow condition?
 			// it is not carry == 1 as  say 1 + -1 sets the carry but is 0
 		//		if (carry) throw integer_overflow();
 	#endif
-			* this = sum;
 		}
 		return *this;
 	}
@@ -326,68 +317,30 @@ public:
 		return *this;
 	}
 	integer& operator*=(const integer& rhs) {
-		if constexpr (NumberType == IntegerNumberType::IntegerNumber) {
-			if constexpr (nrBlocks == 1) {
-				_block[0] = static_cast<bt>(_block[0] * rhs.block(0));
-			}
-			else {
-				// is there a better way than upconverting to deal with maxneg in a 2's complement encoding?
-				integer<nbits + 1, BlockType, NumberType> base(*this);
-				integer<nbits + 1, BlockType, NumberType> multiplicant(rhs);
-				bool resultIsNeg = (base.isneg() ^ multiplicant.isneg());
-				if (base.isneg()) {
-					base.twosComplement();
-				}
-				if (multiplicant.isneg()) {
-					multiplicant.twosComplement();
-				}
-				clear();
-				for (unsigned i = 0; i < static_cast<unsigned>(nrBlocks); ++i) {
-					std::uint64_t segment(0);
-					for (unsigned j = 0; j < static_cast<unsigned>(nrBlocks); ++j) {
-						segment += static_cast<std::uint64_t>(base.block(i)) * static_cast<std::uint64_t>(multiplicant.block(j));
-
-						if (i + j < static_cast<unsigned>(nrBlocks)) {
-							segment += _block[i + j];
-							_block[i + j] = static_cast<bt>(segment);
-							segment >>= bitsInBlock;
-						}
-					}
-				}
-				if (resultIsNeg) twosComplement();
-			}
+		// the lower nbits of the product are identical for 2's complement and unsigned operands,
+		// so integer, whole, and natural numbers share the same modular kernel
+		if constexpr (nrBlocks == 1) {
+			_block[0] = static_cast<bt>(_block[0] * rhs.block(0));
 		}
-		else {  // whole and natural numbers are closed under multiplication (modulo)
-			if constexpr (nrBlocks == 1) {
-				_block[0] = static_cast<bt>(_block[0] * rhs.block(0));
+		else {
+			bt product[nrBlocks];
+			if constexpr (nrBlocks < limb_mullo_threshold<>) {
+				limb_mullo_schoolbook(_block, rhs._block, nrBlocks, product);
 			}
 			else {
-				integer<nbits, BlockType, NumberType> base(*this), multiplicant(rhs);
-				clear();
-				for (unsigned i = 0; i < static_cast<unsigned>(nrBlocks); ++i) {
-					std::uint64_t segment(0);
-					for (unsigned j = 0; j < static_cast<unsigned>(nrBlocks); ++j) {
-						segment += static_cast<std::uint64_t>(base.block(i)) * static_cast<std::uint64_t>(multiplicant.block(j));
-
-						if (i + j < static_cast<unsigned>(nrBlocks)) {
-							segment += _block[i + j];
-							_block[i + j] = static_cast<bt>(segment);
-							segment >>= bitsInBlock;
-						}
-					}
-				}
+				bt scratch[mullo_scratch_size(nrBlocks)];
+				limb_mullo(_block, rhs._block, nrBlocks, product, scratch);
 			}
+			for (unsigned i = 0; i < nrBlocks; ++i) _block[i] = product[i];
 		}
 		// null any leading bits that fall outside of nbits
 		_block[MSU] = static_cast<bt>(MSU_MASK & _block[MSU]);
 		return *this;
 	}
 	integer& operator*=(const BlockType& scale) noexcept {
-		std::uint64_t scaleFactor(scale), segment(0);
+		bt carry{ 0 };
 		for (unsigned i = 0; i < nrBlocks; ++i) {
-			segment += static_cast<std::uint64_t>(_block[i]) * scaleFactor;
-			_block[i] = static_cast<BlockType>(segment);
-			segment >>= bitsInBlock;
+			_block[i] = muladd(_block[i], scale, bt(0), carry);
 		}
 		return *this;
 	}
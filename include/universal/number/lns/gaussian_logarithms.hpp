@@ -0,0 +1,192 @@
+#pragma once
+// gaussian_logarithms.hpp: sb/db functions to add and subtract in the logarithmic domain
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cmath>
+#include <array>
+#include <vector>
+
+/*
+ Addition and subtraction of two logarithmic numbers X = 2^x and Y = 2^y, with |X| >= |Y|,
+ are expressed through the Gaussian logarithms of the distance t = x - y >= 0:
+
+     log2(|X| + |Y|) = x + sb(t),   sb(t) = log2(1 + 2^-t)
+     log2(|X| - |Y|) = x + db(t),   db(t) = log2(1 - 2^-t)
+
+ The lns exponent is a fixed-point number with rbits fraction bits, so t is an integer
+ multiple of 2^-rbits, and x + sb(t) rounds correctly when sb(t) is rounded to rbits.
+ Both functions vanish in the exponent once 2^rbits * 2^-t / ln(2) < 1/2, which happens
+ before t = rbits + 2, bounding the domain that needs to be tabulated.
+
+ Three tiers are provided:
+   - rbits <= 8  : tables of every sample in the domain, generated at compile time
+   - rbits <= 20 : tables sampled at 2^-p, with p = (rbits + 1)/2, linearly interpolated,
+                   which keeps the interpolation error well below half an ulp
+   - otherwise   : sb/db are evaluated in double precision, which still avoids
+                   the conversion of both operands out of the logarithmic domain
+ */
+
+namespace sw { namespace universal {
+
+// 2^-t for t >= 0, evaluated with constexpr-friendly arithmetic
+constexpr double gaussian_log_exp2_negative(double t) {
+	constexpr double ln2 = 0.693147180559945309417232121458;
+	double scale = 1.0;
+	while (t >= 1.0) { t -= 1.0; scale *= 0.5; }
+	// e^(-t ln2) for t in [0, 1)
+	double x = -t * ln2;
+	double term = 1.0, sum = 1.0;
+	for (int i = 1; i < 30; ++i) {
+		term *= x / i;
+		sum += term;
+	}
+	return sum * scale;
+}
+
+// log2(y) for y > 0, evaluated with constexpr-friendly arithmetic
+constexpr double gaussian_log_log2(double y) {
+	constexpr double ln2 = 0.693147180559945309417232121458;
+	int e = 0;
+	while (y < 0.70710678118654752440) { y *= 2.0; --e; }
+	while (y > 1.41421356237309504880) { y *= 0.5; ++e; }
+	// ln(y) = 2 atanh((y - 1)/(y + 1)), with |z| < 0.172
+	double z = (y - 1.0) / (y + 1.0);
+	double z2 = z * z;
+	double power = z, sum = 0.0;
+	for (int i = 0; i < 20; ++i) {
+		sum += power / (2 * i + 1);
+		power *= z2;
+	}
+	return e + 2.0 * sum / ln2;
+}
+
+constexpr std::int64_t gaussian_log_round(double v) {
+	return (v < 0.0 ? -static_cast<std::int64_t>(-v + 0.5) : static_cast<std::int64_t>(v + 0.5));
+}
+
+// size of the domain of sb/db in units of 2^-rbits, limited by the dynamic range of the exponent
+template<unsigned nbits, unsigned rbits>
+constexpr std::uint64_t gaussian_log_domain() {
+	constexpr std::uint64_t vanishing = std::uint64_t(rbits + 2) << rbits;
+	constexpr std::uint64_t range = (nbits - 1 < 64) ? (std::uint64_t(1) << (nbits - 1)) : ~std::uint64_t(0);
+	return (vanishing < range ? vanishing : range);
+}
+
+/// <summary>
+/// compile-time tables of sb and db for every distance in the domain, in units of 2^-rbits
+/// </summary>
+template<unsigned nbits, unsigned rbits>
+struct GaussianLogarithmTable {
+	static constexpr std::uint64_t size = gaussian_log_domain<nbits, rbits>();
+	static constexpr double scaling = double(std::uint64_t(1) << rbits);
+
+	static constexpr std::array<std::int32_t, size> generate_sb() {
+		std::array<std::int32_t, size> table{};
+		for (std::uint64_t k = 0; k < size; ++k) {
+			table[k] = static_cast<std::int32_t>(gaussian_log_round(scaling * gaussian_log_log2(1.0 + gaussian_log_exp2_negative(double(k) / scaling))));
+		}
+		return table;
+	}
+	static constexpr std::array<std::int32_t, size> generate_db() {
+		std::array<std::int32_t, size> table{};
+		table[0] = 0; // X - X is handled by the caller
+		for (std::uint64_t k = 1; k < size; ++k) {
+			table[k] = static_cast<std::int32_t>(gaussian_log_round(scaling * gaussian_log_log2(1.0 - gaussian_log_exp2_negative(double(k) / scaling))));
+		}
+		return table;
+	}
+
+	static constexpr std::array<std::int32_t, size> sb = generate_sb();
+	static constexpr std::array<std::int32_t, size> db = generate_db();
+};
+
+/// <summary>
+/// sb and db sampled at 2^-p and linearly interpolated between the samples
+/// </summary>
+template<unsigned nbits, unsigned rbits>
+class GaussianLogarithmInterpolator {
+public:
+	static constexpr unsigned p = (rbits + 1) / 2;
+	static constexpr unsigned shift = rbits - p;                  // distance bits below the sample grid
+	static constexpr std::uint64_t size = gaussian_log_domain<nbits, rbits>();
+	static constexpr double scaling = double(std::uint64_t(1) << rbits);
+
+	static const GaussianLogarithmInterpolator& instance() {
+		static const GaussianLogarithmInterpolator interpolator;
+		return interpolator;
+	}
+
+	// sb(t) in units of 2^-rbits
+	std::int64_t sb(std::uint64_t distance) const noexcept {
+		return interpolate(_sb, distance);
+	}
+	// db(t) in units of 2^-rbits, for distance > 0
+	std::int64_t db(std::uint64_t distance) const noexcept {
+		if (distance < (std::uint64_t(1) << rbits)) {
+			// the singularity at t = 0 defeats interpolation: evaluate directly
+			double t = double(distance) / scaling;
+			return gaussian_log_round(scaling * std::log2(-std::expm1(-t * 0.693147180559945309417232121458)));
+		}
+		return interpolate(_db, distance);
+	}
+
+private:
+	std::vector<double> _sb, _db;
+
+	GaussianLogarithmInterpolator() {
+		std::size_t samples = std::size_t(size >> shift) + 2;
+		_sb.resize(samples);
+		_db.resize(samples);
+		for (std::size_t i = 0; i < samples; ++i) {
+			double t = std::ldexp(double(i), -int(p));
+			_sb[i] = scaling * std::log2(1.0 + std::exp2(-t));
+			_db[i] = (i == 0 ? 0.0 : scaling * std::log2(-std::expm1(-t * 0.693147180559945309417232121458)));
+		}
+	}
+
+	static std::int64_t interpolate(const std::vector<double>& table, std::uint64_t distance) noexcept {
+		std::size_t i = std::size_t(distance >> shift);
+		double fraction = double(distance & ((std::uint64_t(1) << shift) - 1u)) / double(std::uint64_t(1) << shift);
+		return gaussian_log_round(table[i] + (table[i + 1] - table[i]) * fraction);
+	}
+};
+
+/// <summary>
+/// Gaussian logarithms of a distance in units of 2^-rbits, dispatched on the size of the lns
+/// </summary>
+template<unsigned nbits, unsigned rbits>
+struct GaussianLogarithm {
+	static constexpr std::uint64_t domain = gaussian_log_domain<nbits, rbits>();
+
+	static std::int64_t sb(std::uint64_t distance) noexcept {
+		if (distance >= domain) return 0;
+		if constexpr (rbits <= 8) {
+			return GaussianLogarithmTable<nbits, rbits>::sb[distance];
+		}
+		else if constexpr (rbits <= 20) {
+			return GaussianLogarithmInterpolator<nbits, rbits>::instance().sb(distance);
+		}
+		else {
+			double t = std::ldexp(double(distance), -int(rbits));
+			return gaussian_log_round(std::ldexp(std::log2(1.0 + std::exp2(-t)), int(rbits)));
+		}
+	}
+	static std::int64_t db(std::uint64_t distance) noexcept {
+		if (distance >= domain) return 0;
+		if constexpr (rbits <= 8) {
+			return GaussianLogarithmTable<nbits, rbits>::db[distance];
+		}
+		else if constexpr (rbits <= 20) {
+			return GaussianLogarithmInterpolator<nbits, rbits>::instance().db(distance);
+		}
+		else {
+			double t = std::ldexp(double(distance), -int(rbits));
+			return gaussian_log_round(std::ldexp(std::log2(-std::expm1(-t * 0.693147180559945309417232121458)), int(rbits)));
+		}
+	}
+};
+
+}} // namespace sw::universal
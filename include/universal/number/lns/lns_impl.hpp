@@ -13,6 +13,7 @@
 #include <universal/number/shared/specific_value_encoding.hpp>
 #include <universal/behavior/arithmetic.hpp>
 #include <universal/number/lns/lns_fwd.hpp>
+#include <universal/number/lns/gaussian_logarithms.hpp>
 
 namespace sw { namespace universal {
 		
@@ -184,27 +185,25 @@ public:
 
 	// in-place arithmetic assignment operators
 	lns& operator+=(const lns& rhs) {
-		double sum{ 0.0 };
-		if constexpr (behavior == Behavior::Saturating) {
-			sum = double(*this) + double(rhs);  // TODO: native implementation
+		if constexpr (nbits <= 64) {
+			return add(rhs, false);
 		}
 		else {
-			sum = double(*this) + double(rhs);  // TODO: native implementation
+			double sum = double(*this) + double(rhs);
+			return *this = sum; // <-- saturation happens in the assignment
 		}
-		return *this = sum; // <-- saturation happens in the assignment
 	}
 	lns& operator+=(double rhs) { 
 		return operator+=(lns(rhs));
 	}
 	lns& operator-=(const lns& rhs) { 
-		double diff{ 0.0 };
-		if constexpr (behavior == Behavior::Saturating) {
-			diff = double(*this) - double(rhs);  // TODO: native implementation
+		if constexpr (nbits <= 64) {
+			return add(rhs, true);
 		}
 		else {
-			diff = double(*this) - double(rhs);  // TODO: native implementation
+			double diff = double(*this) - double(rhs);
+			return *this = diff; // <-- saturation happens in the assignment
 		}
-		return *this = diff; // <-- saturation happens in the assignment
 	}
 	lns& operator-=(double rhs) {
 		return operator-=(lns(rhs));
@@ -295,6 +294,27 @@ public:
 	}
 	lns& operator/=(double rhs) { return operator/=(lns(rhs)); }
 
+	// multiplicative inverse: negation of the exponent
+	lns reciprocate() const {
+		lns r;
+		if (isnan()) return *this;
+		if (iszero()) {
+#if LNS_THROW_ARITHMETIC_EXCEPTION
+			throw lns_divide_by_zero();
+#else
+			r.setnan();
+			return r;
+#endif
+		}
+		if constexpr (nbits <= 64) {
+			r.setexponent(-exponent_bits(), sign());
+		}
+		else {
+			r = lns(1) / *this;
+		}
+		return r;
+	}
+
 	// prefix/postfix operators
 	lns& operator++() {
 		++_block;
@@ -323,16 +343,9 @@ public:
 	constexpr void setinf(bool sign)               noexcept { (sign ? maxneg() : maxpos()); } // TODO: is that what we want?
 	constexpr void setsign(bool s = true)          noexcept { setbit(nbits - 1, s); }
 	constexpr void setbit(unsigned i, bool v = true) noexcept {
-		unsigned blockIndex = i / bitsInBlock;
-		if (i < nbits) {
-			bt block = _block[blockIndex];
-			bt null = ~(1ull << (i % bitsInBlock));
-			bt bit = bt(v ? 1 : 0);
-			bt mask = bt(bit << (i % bitsInBlock));
-			//_block[i / bitsInBlock] = bt((block & null) | mask);
-			_block.setblock(blockIndex, bt((block & null) | mask));
-		}
-		// nop if i is out of range
+		// bits outside of nbits are kept at 0: branching on nbits instead creates bodies that differ
+		// only in value ranges, which identical code folding in gcc 12 merges across lns sizes
+		_block.setbit(i, v && (i < nbits));
 	}
 	constexpr void setbits(uint64_t value) noexcept {
 		if constexpr (1 == nrBlocks) {
@@ -346,6 +359,23 @@ public:
 		}
 		_block.setblock(MSU, static_cast<bt>(_block[MSU] & MSU_MASK)); // enforce precondition for fast comparison by properly nulling bits that are outside of nbits
 	}
+	// set the value to +-2^(exponent / 2^rbits): exponents below the dynamic range underflow to zero,
+	// exponents above it saturate or wrap, following the arithmetic behavior
+	constexpr lns& setexponent(int64_t exponent, bool negative) noexcept {
+		static_assert(nbits <= 64, "setexponent requires the encoding to fit in 64 bits");
+		constexpr int64_t rawmax = static_cast<int64_t>((1ull << (nbits - 2)) - 1ull);
+		constexpr int64_t rawmin = -rawmax - 1; // zero encoding
+		if (exponent <= rawmin) { // underflow
+			setzero();
+			return *this;
+		}
+		if constexpr (behavior == Behavior::Saturating) {
+			if (exponent > rawmax) return (negative ? maxneg() : maxpos());
+		}
+		uint64_t bits = static_cast<uint64_t>(exponent) & ((1ull << (nbits - 1)) - 1ull); // wrapping drops the carry
+		setbits(negative ? (bits | (1ull << (nbits - 1))) : bits);
+		return *this;
+	}
 	
 	// create specific number system values of interest
 	constexpr lns& maxpos() noexcept {
@@ -451,6 +481,16 @@ public:
 		exp >>= rbits;
 		return long(exp);
 	}
+	// two's complement exponent, sign extended into a native integer, in units of 2^-rbits
+	constexpr int64_t exponent_bits() const noexcept {
+		static_assert(nbits <= 64, "exponent_bits requires the encoding to fit in 64 bits");
+		uint64_t raw{ 0 };
+		for (unsigned i = 0; i < nrBlocks; ++i) {
+			raw |= (uint64_t(_block[i]) & storageMask) << (i * bitsInBlock);
+		}
+		uint64_t signExtension = (0xFFFF'FFFF'FFFF'FFFFull << (nbits - 2));
+		return static_cast<int64_t>((raw & (1ull << (nbits - 2))) ? (raw | signExtension) : (raw & ~signExtension));
+	}
 	constexpr blockbinary<nbits+2, std::uint32_t, BinaryNumberType::Unsigned> fraction() const noexcept {
 		blockbinary<nbits + 2, std::uint32_t, BinaryNumberType::Unsigned> bb{ 0 };
 		// TODO: how? and what is the size of the blockbinary? it is much bigger than nbits+2
@@ -514,6 +554,45 @@ public:
 
 protected:
 
+	/// <summary>
+	/// native addition in the logarithmic domain through the Gaussian logarithms sb and db
+	/// </summary>
+	/// <param name="rhs">the addend</param>
+	/// <param name="negate">subtract rhs instead of adding it</param>
+	/// <returns>reference to this lns object</returns>
+	lns& add(const lns& rhs, bool negate) noexcept {
+		if (isnan()) return *this;
+		if (rhs.isnan()) {
+			setnan();
+			return *this;
+		}
+		if (rhs.iszero()) return *this;
+		if (iszero()) return *this = (negate ? -rhs : rhs);
+		int64_t lexp = exponent_bits(), rexp = rhs.exponent_bits();
+		bool lsign = sign(), rsign = (rhs.sign() != negate);
+		// order the operands by magnitude: the result carries the sign of the larger one
+		int64_t x = lexp, y = rexp;
+		bool negative = lsign;
+		if (rexp > lexp) {
+			x = rexp;
+			y = lexp;
+			negative = rsign;
+		}
+		uint64_t distance = static_cast<uint64_t>(x) - static_cast<uint64_t>(y);
+		int64_t r{ 0 };
+		if (lsign == rsign) {
+			r = x + GaussianLogarithm<nbits, rbits>::sb(distance);
+		}
+		else {
+			if (distance == 0) { // X - X
+				setzero();
+				return *this;
+			}
+			r = x + GaussianLogarithm<nbits, rbits>::db(distance);
+		}
+		return setexponent(r, negative);
+	}
+
 	/// <summary>
 	/// 1's complement of the encoding. Used internally to create specific bit patterns
 	/// </summary>
@@ -9,12 +9,17 @@ namespace sw { namespace universal {
 
 // the current shims are NON-COMPLIANT with the Universal standard, which says that every function must be
 // correctly rounded for every input value. Anything less sacrifices bitwise reproducibility of results.
+// The exponential functions generate the value of x and use it as the exponent of the result,
+// falling back to double precision when the result is out of range.
 
 // Base-e exponential function
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> exp(lns<nbits, rbits, bt, xtra...> x) {
 	if (isnan(x)) return x;
 	lns<nbits, rbits, bt, xtra...> p;
+	if constexpr (nbits <= 64) {
+		if (lns_native_exponential(x, 1.442695040888963407359924681001892137, p)) return p; // log2(e)
+	}
 	double d = std::exp(double(x));
 	if (d == 0.0) {
 		p.minpos();
@@ -30,6 +35,9 @@ template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> exp2(lns<nbits, rbits, bt, xtra...> x) {
 	if (isnan(x)) return x;
 	lns<nbits, rbits, bt, xtra...> p;
+	if constexpr (nbits <= 64) {
+		if (lns_native_exponential(x, 1.0, p)) return p;
+	}
 	double d = std::exp2(double(x));
 	if (d == 0.0) {
 		p.minpos();
@@ -43,6 +51,10 @@ lns<nbits, rbits, bt, xtra...> exp2(lns<nbits, rbits, bt, xtra...> x) {
 // Base-10 exponential function
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> exp10(lns<nbits, rbits, bt, xtra...> x) {
+	if constexpr (nbits <= 64) {
+		lns<nbits, rbits, bt, xtra...> p;
+		if (!isnan(x) && lns_native_exponential(x, 3.321928094887362347870319429489390175, p)) return p; // log2(10)
+	}
 	return lns<nbits, rbits, bt, xtra...>(std::pow(10.0, double(x)));
 }
 		
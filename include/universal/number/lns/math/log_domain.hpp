@@ -0,0 +1,170 @@
+#pragma once
+// log_domain.hpp: building blocks to evaluate the lns elementary functions without leaving the logarithmic domain
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cmath>
+#include <vector>
+
+/*
+ An lns value X = +-2^x carries its logarithm x as a fixed-point number with rbits fraction bits.
+ The elementary functions map onto simple operations on that fixed-point exponent:
+
+     sqrt(X)       = 2^(x/2)             a shift of the exponent
+     pow(X, y)     = 2^(x*y)             a fixed-point multiply
+     1/X           = 2^-x                a negation
+     exp2(X)       = 2^X                 the exponent of the result is the value of X
+     log2(X)       = x                   the value of the result is the exponent of X
+
+ exp2 and log2 still need a conversion between the value and the logarithm of a fixed-point number,
+ which is a table lookup on the fraction bits of the exponent for small configurations.
+ exp, exp10, log, and log10 follow by scaling with log2(e), log2(10), ln(2), and log10(2).
+ */
+
+namespace sw { namespace universal {
+
+// exponents with up to this many fraction bits use the tables below
+constexpr unsigned LNS_MATHLIB_TABLE_BITS = 10;
+
+/// <summary>
+/// 2^(k / 2^rbits) for the fraction bits k of an lns exponent
+/// </summary>
+template<unsigned rbits>
+class LnsExp2Table {
+public:
+	static const LnsExp2Table& instance() {
+		static const LnsExp2Table table;
+		return table;
+	}
+	double operator()(std::uint64_t k) const noexcept { return _table[k]; }
+
+private:
+	std::vector<double> _table;
+
+	LnsExp2Table() : _table(std::size_t(1) << rbits) {
+		for (std::size_t k = 0; k < _table.size(); ++k) {
+			_table[k] = std::exp2(std::ldexp(double(k), -int(rbits)));
+		}
+	}
+};
+
+/// <summary>
+/// log2(k) for the magnitudes k of an lns exponent with up to nbits - 2 bits
+/// </summary>
+template<unsigned nbits>
+class LnsLog2Table {
+public:
+	static const LnsLog2Table& instance() {
+		static const LnsLog2Table table;
+		return table;
+	}
+	double operator()(std::uint64_t k) const noexcept { return _table[k]; }
+
+private:
+	std::vector<double> _table;
+
+	LnsLog2Table() : _table(std::size_t(1) << (nbits - 2)) {
+		_table[0] = -INFINITY;
+		for (std::size_t k = 1; k < _table.size(); ++k) {
+			_table[k] = std::log2(double(k));
+		}
+	}
+};
+
+// 2^(exponent / 2^rbits): the magnitude of an lns value with the given exponent
+template<unsigned rbits>
+inline double lns_exponent_to_value(std::int64_t exponent) noexcept {
+	std::int64_t integer = exponent >> rbits; // floor
+	std::uint64_t fraction = static_cast<std::uint64_t>(exponent) & ((std::uint64_t(1) << rbits) - 1u);
+	if (integer > 2048) return INFINITY;
+	if (integer < -2048) return 0.0;
+	if constexpr (rbits <= LNS_MATHLIB_TABLE_BITS) {
+		return std::ldexp(LnsExp2Table<rbits>::instance()(fraction), int(integer));
+	}
+	else {
+		return std::ldexp(std::exp2(std::ldexp(double(fraction), -int(rbits))), int(integer));
+	}
+}
+
+// log2(|exponent| / 2^rbits): the logarithm of the value of an lns exponent, for a non-zero exponent
+template<unsigned nbits, unsigned rbits>
+inline double lns_exponent_log2(std::int64_t exponent) noexcept {
+	std::uint64_t magnitude = static_cast<std::uint64_t>(exponent < 0 ? -exponent : exponent);
+	if constexpr (nbits - 2 <= LNS_MATHLIB_TABLE_BITS) {
+		return LnsLog2Table<nbits>::instance()(magnitude) - double(rbits);
+	}
+	else {
+		return std::log2(double(magnitude)) - double(rbits);
+	}
+}
+
+// round a logarithm in units of 2^-rbits to the nearest lns exponent, returning false when
+// the exponent falls outside of the dynamic range of the lns. A tie in the logarithm is the
+// geometric mean of its neighbors, which is closer in value to the smaller one: ties round down.
+template<unsigned nbits>
+inline bool lns_round_exponent(double scaledLogarithm, std::int64_t& exponent) noexcept {
+	constexpr double rawmax = double((std::uint64_t(1) << (nbits - 2)) - 1u);
+	double rounded = std::ceil(scaledLogarithm - 0.5);
+	if (!(rounded > -rawmax - 1.0 && rounded <= rawmax)) return false; // also rejects NaN
+	exponent = static_cast<std::int64_t>(rounded);
+	return true;
+}
+
+// exponential with a base of 2^(1/log2base): the exponent of the result is the value of x scaled by log2base
+// returns false when the result is out of range, leaving the function to handle saturation and underflow
+template<typename LnsType>
+inline bool lns_native_exponential(const LnsType& x, double log2base, LnsType& result) noexcept {
+	constexpr unsigned nbits = LnsType::nbits;
+	constexpr unsigned rbits = LnsType::rbits;
+	if (x.iszero()) {
+		result.setexponent(0, false); // x^0 = 1
+		return true;
+	}
+	double value = lns_exponent_to_value<rbits>(x.exponent_bits());
+	double scaledLogarithm = (x.sign() ? -value : value) * log2base * LnsType::scaling;
+	std::int64_t exponent{ 0 };
+	if (!lns_round_exponent<nbits>(scaledLogarithm, exponent)) return false;
+	result.setexponent(exponent, false);
+	return true;
+}
+
+// logarithm with a base of 2^(1/log2scale): the value of the result is the exponent of x scaled by log2scale
+// returns false when x is not positive or the result is out of range
+template<typename LnsType>
+inline bool lns_native_logarithm(const LnsType& x, double log2scale, LnsType& result) noexcept {
+	constexpr unsigned nbits = LnsType::nbits;
+	constexpr unsigned rbits = LnsType::rbits;
+	if (x.isnan() || x.iszero() || x.sign()) return false;
+	std::int64_t exponent = x.exponent_bits();
+	if (exponent == 0) { // log(1) = 0
+		result.setzero();
+		return true;
+	}
+	double scaledLogarithm = (lns_exponent_log2<nbits, rbits>(exponent) + std::log2(log2scale)) * LnsType::scaling;
+	std::int64_t logarithm{ 0 };
+	if (!lns_round_exponent<nbits>(scaledLogarithm, logarithm)) return false;
+	result.setexponent(logarithm, exponent < 0);
+	return true;
+}
+
+// power with a real exponent: a fixed-point multiply of the exponent of x
+// returns false for special values, negative bases with non-integer exponents, and out of range results
+template<typename LnsType>
+inline bool lns_native_power(const LnsType& x, double y, LnsType& result) noexcept {
+	constexpr unsigned nbits = LnsType::nbits;
+	if (x.isnan() || x.iszero() || std::isnan(y)) return false;
+	bool negative = false;
+	if (x.sign()) {
+		double integer = std::trunc(y);
+		if (integer != y) return false;
+		negative = (std::fmod(integer, 2.0) != 0.0);
+	}
+	std::int64_t exponent{ 0 };
+	if (!lns_round_exponent<nbits>(double(x.exponent_bits()) * y, exponent)) return false;
+	result.setexponent(exponent, negative);
+	return true;
+}
+
+}} // namespace sw::universal
@@ -7,21 +7,36 @@
 
 namespace sw { namespace universal {
 
+// The logarithms of x are scaled copies of the exponent of x, which only needs to be converted into an lns value.
+// Non-positive arguments and out of range results fall back to double precision.
+
 // Natural logarithm of x
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> log(lns<nbits, rbits, bt, xtra...> x) {
+	if constexpr (nbits <= 64) {
+		lns<nbits, rbits, bt, xtra...> result;
+		if (lns_native_logarithm(x, 0.693147180559945309417232121458176568, result)) return result; // ln(2)
+	}
 	return lns<nbits, rbits, bt, xtra...>(std::log(double(x)));
 }
 
 // Binary logarithm of x
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> log2(lns<nbits, rbits, bt, xtra...> x) {
+	if constexpr (nbits <= 64) {
+		lns<nbits, rbits, bt, xtra...> result;
+		if (lns_native_logarithm(x, 1.0, result)) return result;
+	}
 	return lns<nbits, rbits, bt, xtra...>(std::log2(double(x)));
 }
 
 // Decimal logarithm of x
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> log10(lns<nbits, rbits, bt, xtra...> x) {
+	if constexpr (nbits <= 64) {
+		lns<nbits, rbits, bt, xtra...> result;
+		if (lns_native_logarithm(x, 0.301029995663981195213738894724493027, result)) return result; // log10(2)
+	}
 	return lns<nbits, rbits, bt, xtra...>(std::log10(double(x)));
 }
 		
@@ -7,19 +7,45 @@
 
 namespace sw { namespace universal {
 
+// the power functions multiply the exponent of x by y in the logarithmic domain,
+// and fall back to the double precision reference for special values and out of range results
+
+template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
+lns<nbits, rbits, bt, xtra...> pow(lns<nbits, rbits, bt, xtra...> x, double y) {
+	if constexpr (nbits <= 64) {
+		lns<nbits, rbits, bt, xtra...> result;
+		if (lns_native_power(x, y, result)) return result;
+	}
+	return lns<nbits, rbits, bt, xtra...>(std::pow(double(x), y));
+}
+
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> pow(lns<nbits, rbits, bt, xtra...> x, lns<nbits, rbits, bt, xtra...> y) {
+	if constexpr (nbits <= 64) {
+		if (!y.isnan()) {
+			double dy = (y.iszero() ? 0.0 : lns_exponent_to_value<rbits>(y.exponent_bits()));
+			return pow(x, (y.sign() ? -dy : dy));
+		}
+	}
 	return lns<nbits, rbits, bt, xtra...>(std::pow(double(x), double(y)));
 }
 		
 template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 lns<nbits, rbits, bt, xtra...> pow(lns<nbits, rbits, bt, xtra...> x, int y) {
+	if constexpr (nbits <= 64) {
+		// the product of the exponent and an integer is exact: check the range before multiplying
+		constexpr int64_t rawmax = static_cast<int64_t>((1ull << (nbits - 2)) - 1ull);
+		if (!x.isnan() && !x.iszero()) {
+			int64_t exponent = x.exponent_bits();
+			int64_t magnitude = (exponent < 0 ? -exponent : exponent);
+			int64_t n = y;
+			if (magnitude == 0 || (n < 0 ? -n : n) <= rawmax / magnitude) {
+				lns<nbits, rbits, bt, xtra...> result;
+				return result.setexponent(exponent * n, x.sign() && (y & 1));
+			}
+		}
+	}
 	return lns<nbits, rbits, bt, xtra...>(std::pow(double(x), double(y)));
 }
-		
-template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
-lns<nbits, rbits, bt, xtra...> pow(lns<nbits, rbits, bt, xtra...> x, double y) {
-	return lns<nbits, rbits, bt, xtra...>(std::pow(double(x), y));
-}
 
 }} // namespace sw::universal
@@ -8,7 +8,7 @@
 //#include <universal/number/lns/math/sqrt_tables.hpp>
 
 #ifndef LNS_NATIVE_SQRT
-#define LNS_NATIVE_SQRT 0
+#define LNS_NATIVE_SQRT 1
 #endif
 
 namespace sw { namespace universal {
@@ -75,8 +75,14 @@ namespace sw { namespace universal {
 	*/
 
 
+	// halve an lns exponent: the tie of an odd exponent rounds down, as the geometric mean
+	// of two neighboring lns values is closer to the smaller one
+	inline int64_t lns_halve_exponent(int64_t exponent) noexcept {
+		return (exponent >> 1); // floor
+	}
+
 #if LNS_NATIVE_SQRT
-	// sqrt for arbitrary lns
+	// sqrt for arbitrary lns: the logarithm of the square root is half the logarithm of the argument
 	template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 	inline lns<nbits, rbits, bt, xtra...> sqrt(const lns<nbits, rbits, bt, xtra...>& a) {
 #if LNS_THROW_ARITHMETIC_EXCEPTION
@@ -85,7 +91,13 @@ namespace sw { namespace universal {
 		if (a.isneg()) std::cerr << "lns argument to sqrt is negative: " << a << std::endl;
 #endif
 		if (a.iszero()) return a;
-		return lns<nbits, rbits, bt, xtra...>(std::sqrt((double)a));  // TBD
+		if constexpr (nbits <= 64) {
+			if (!a.isnan() && !a.isneg()) {
+				lns<nbits, rbits, bt, xtra...> root;
+				return root.setexponent(lns_halve_exponent(a.exponent_bits()), false);
+			}
+		}
+		return lns<nbits, rbits, bt, xtra...>(std::sqrt((double)a));
 	}
 #else
 	template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
@@ -103,6 +115,14 @@ namespace sw { namespace universal {
 	// reciprocal sqrt
 	template<unsigned nbits, unsigned rbits, typename bt, auto... xtra>
 	inline lns<nbits, rbits, bt, xtra...> rsqrt(const lns<nbits, rbits, bt, xtra...>& a) {
+#if LNS_NATIVE_SQRT
+		if constexpr (nbits <= 64) {
+			if (!a.isnan() && !a.iszero() && !a.isneg()) {
+				lns<nbits, rbits, bt, xtra...> v;
+				return v.setexponent(lns_halve_exponent(-a.exponent_bits()), false);
+			}
+		}
+#endif
 		lns<nbits, rbits, bt, xtra...> v = sqrt(a);
 		return v.reciprocate();
 	}
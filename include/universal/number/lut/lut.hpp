@@ -0,0 +1,35 @@
+// lut.hpp: lookup-table arithmetic adapter for 8-bit number systems standard header
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#ifndef _LUT_STANDARD_HEADER_
+#define _LUT_STANDARD_HEADER_
+
+////////////////////////////////////////////////////////////////////////////////////////
+///  COMPILATION DIRECTIVES TO DIFFERENT COMPILERS
+#include <universal/utility/compiler.hpp>
+#include <universal/utility/architecture.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////
+/// required std libraries
+#include <iostream>
+#include <iomanip>
+
+////////////////////////////////////////////////////////////////////////////////////////
+///  BEHAVIORAL COMPILATION SWITCHES
+
+////////////////////////////////////////////////////////////////////////////////////////
+// The lut<Ty> adapter does not pull in a number system: include the header of Ty first,
+// for example,
+//   #include <universal/number/posit/posit.hpp>
+//   #include <universal/number/lut/lut.hpp>
+//   using Scalar = sw::universal::lut< sw::universal::posit<8, 2> >;
+
+////////////////////////////////////////////////////////////////////////////////////////
+/// INCLUDE FILES that make up the library
+#include <universal/number/shared/specific_value_encoding.hpp>
+#include <universal/number/lut/lut_tables.hpp>
+#include <universal/number/lut/lut_impl.hpp>
+
+#endif
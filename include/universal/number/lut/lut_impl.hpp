@@ -0,0 +1,203 @@
+#pragma once
+// lut_impl.hpp: implementation of a lookup-table arithmetic adapter for 8-bit number systems
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <string>
+#include <sstream>
+#include <vector>
+
+namespace sw { namespace universal {
+
+/// <summary>
+/// lut<Ty> carries the encoding of an 8-bit number system Ty and evaluates the arithmetic operators
+/// through the tables of LutTables<Ty>, replacing the decode, compute, and round pipeline of Ty with
+/// a single load. Conversions and comparisons delegate to Ty.
+/// </summary>
+template<typename Ty>
+class lut {
+public:
+	using NumberType = Ty;
+	using Tables = LutTables<Ty>;
+	static constexpr unsigned nbits = Ty::nbits;
+
+	lut() = default;
+
+	constexpr lut(const lut&) = default;
+	constexpr lut(lut&&) = default;
+
+	constexpr lut& operator=(const lut&) = default;
+	constexpr lut& operator=(lut&&) = default;
+
+	lut(const Ty& v) : _bits{ lut_encoding(v) } {}
+	lut(SpecificValue code) : _bits{ lut_encoding(Ty(code)) } {}
+
+	lut(signed char initial_value)        { *this = initial_value; }
+	lut(short initial_value)              { *this = initial_value; }
+	lut(int initial_value)                { *this = initial_value; }
+	lut(long initial_value)               { *this = initial_value; }
+	lut(long long initial_value)          { *this = initial_value; }
+	lut(char initial_value)               { *this = initial_value; }
+	lut(unsigned short initial_value)     { *this = initial_value; }
+	lut(unsigned int initial_value)       { *this = initial_value; }
+	lut(unsigned long initial_value)      { *this = initial_value; }
+	lut(unsigned long long initial_value) { *this = initial_value; }
+	lut(float initial_value)              { *this = initial_value; }
+	lut(double initial_value)             { *this = initial_value; }
+
+	// assignment operators for native types convert through Ty
+	lut& operator=(const Ty& rhs)          { _bits = lut_encoding(rhs); return *this; }
+	lut& operator=(signed char rhs)        { return *this = Ty(rhs); }
+	lut& operator=(short rhs)              { return *this = Ty(rhs); }
+	lut& operator=(int rhs)                { return *this = Ty(rhs); }
+	lut& operator=(long rhs)               { return *this = Ty(rhs); }
+	lut& operator=(long long rhs)          { return *this = Ty(rhs); }
+	lut& operator=(char rhs)               { return *this = Ty(rhs); }
+	lut& operator=(unsigned short rhs)     { return *this = Ty(rhs); }
+	lut& operator=(unsigned int rhs)       { return *this = Ty(rhs); }
+	lut& operator=(unsigned long rhs)      { return *this = Ty(rhs); }
+	lut& operator=(unsigned long long rhs) { return *this = Ty(rhs); }
+	lut& operator=(float rhs)              { return *this = Ty(rhs); }
+	lut& operator=(double rhs)             { return *this = Ty(rhs); }
+
+	// conversion operators
+	explicit operator Ty()     const { Ty v; v.setbits(_bits); return v; }
+	explicit operator int()    const { return int(Tables::instance().value(_bits)); }
+	explicit operator float()  const { return float(Tables::instance().value(_bits)); }
+	explicit operator double() const { return Tables::instance().value(_bits); }
+
+	// prefix operator
+	lut operator-() const {
+		lut n;
+		n._bits = Tables::instance().negate(_bits);
+		return n;
+	}
+
+	// in-place arithmetic assignment operators
+	lut& operator+=(const lut& rhs) { _bits = Tables::instance().add(_bits, rhs._bits); return *this; }
+	lut& operator-=(const lut& rhs) { _bits = Tables::instance().sub(_bits, rhs._bits); return *this; }
+	lut& operator*=(const lut& rhs) { _bits = Tables::instance().mul(_bits, rhs._bits); return *this; }
+	lut& operator/=(const lut& rhs) { _bits = Tables::instance().div(_bits, rhs._bits); return *this; }
+	lut& operator+=(double rhs) { return *this += lut(rhs); }
+	lut& operator-=(double rhs) { return *this -= lut(rhs); }
+	lut& operator*=(double rhs) { return *this *= lut(rhs); }
+	lut& operator/=(double rhs) { return *this /= lut(rhs); }
+
+	// modifiers
+	void clear() noexcept { _bits = 0; }
+	void setbits(std::uint64_t value) noexcept { _bits = static_cast<std::uint8_t>(value & ((1ull << nbits) - 1ull)); }
+
+	// selectors
+	std::uint8_t bits() const noexcept { return _bits; }
+	bool iszero() const { return Ty(*this).iszero(); }
+	bool isnan()  const { return Ty(*this).isnan(); }
+	bool sign()   const { return Ty(*this).sign(); }
+
+private:
+	std::uint8_t _bits;
+};
+
+////////////////////////    binary arithmetic operators   ///////////////////////////////
+
+template<typename Ty>
+inline lut<Ty> operator+(const lut<Ty>& lhs, const lut<Ty>& rhs) { lut<Ty> sum(lhs); return sum += rhs; }
+template<typename Ty>
+inline lut<Ty> operator-(const lut<Ty>& lhs, const lut<Ty>& rhs) { lut<Ty> diff(lhs); return diff -= rhs; }
+template<typename Ty>
+inline lut<Ty> operator*(const lut<Ty>& lhs, const lut<Ty>& rhs) { lut<Ty> mul(lhs); return mul *= rhs; }
+template<typename Ty>
+inline lut<Ty> operator/(const lut<Ty>& lhs, const lut<Ty>& rhs) { lut<Ty> ratio(lhs); return ratio /= rhs; }
+
+////////////////////////    logic operators, following the semantics of Ty   ////////////
+
+template<typename Ty>
+inline bool operator==(const lut<Ty>& lhs, const lut<Ty>& rhs) { return Ty(lhs) == Ty(rhs); }
+template<typename Ty>
+inline bool operator!=(const lut<Ty>& lhs, const lut<Ty>& rhs) { return Ty(lhs) != Ty(rhs); }
+template<typename Ty>
+inline bool operator< (const lut<Ty>& lhs, const lut<Ty>& rhs) { return Ty(lhs) <  Ty(rhs); }
+template<typename Ty>
+inline bool operator> (const lut<Ty>& lhs, const lut<Ty>& rhs) { return Ty(lhs) >  Ty(rhs); }
+template<typename Ty>
+inline bool operator<=(const lut<Ty>& lhs, const lut<Ty>& rhs) { return Ty(lhs) <= Ty(rhs); }
+template<typename Ty>
+inline bool operator>=(const lut<Ty>& lhs, const lut<Ty>& rhs) { return Ty(lhs) >= Ty(rhs); }
+
+////////////////////////    stream and manipulators   ///////////////////////////////////
+
+template<typename Ty>
+inline std::ostream& operator<<(std::ostream& ostr, const lut<Ty>& v) {
+	return ostr << Ty(v);
+}
+
+template<typename Ty>
+inline std::string type_tag(const lut<Ty>& = {}) {
+	std::stringstream s;
+	s << "lut<" << type_tag(Ty()) << '>';
+	return s.str();
+}
+
+template<typename Ty>
+inline std::string to_binary(const lut<Ty>& v, bool nibbleMarker = false) {
+	return to_binary(Ty(v), nibbleMarker);
+}
+
+////////////////////////    batch API   /////////////////////////////////////////////////
+
+/// <summary>
+/// apply a binary operator to arrays of encodings: result[i] = lhs[i] op rhs[i]
+/// </summary>
+template<typename Ty>
+inline void lut_batch(LutOperator op, const std::uint8_t* lhs, const std::uint8_t* rhs, std::uint8_t* result, std::size_t n) {
+	const LutTables<Ty>& tables = LutTables<Ty>::instance();
+	for (std::size_t i = 0; i < n; ++i) {
+		result[i] = tables.row(op, lhs[i])[rhs[i]];
+	}
+}
+
+/// <summary>
+/// apply a binary operator with a scalar left-hand side to an array of encodings: result[i] = a op rhs[i].
+/// The scalar selects a single row of the table, which stays in the L1 cache.
+/// </summary>
+template<typename Ty>
+inline void lut_batch(LutOperator op, std::uint8_t a, const std::uint8_t* rhs, std::uint8_t* result, std::size_t n) {
+	const std::uint8_t* row = LutTables<Ty>::instance().row(op, a);
+	for (std::size_t i = 0; i < n; ++i) {
+		result[i] = row[rhs[i]];
+	}
+}
+
+/// <summary>
+/// dot product of two arrays of encodings, accumulating with the rounding of Ty after every step
+/// </summary>
+template<typename Ty>
+inline std::uint8_t lut_dot(const std::uint8_t* x, const std::uint8_t* y, std::size_t n) {
+	const LutTables<Ty>& tables = LutTables<Ty>::instance();
+	std::uint8_t sum = lut_encoding(Ty(0));
+	for (std::size_t i = 0; i < n; ++i) {
+		sum = tables.add(sum, tables.mul(x[i], y[i]));
+	}
+	return sum;
+}
+
+// vector forms of the batch API
+template<typename Ty>
+inline void lut_batch(LutOperator op, const std::vector< lut<Ty> >& lhs, const std::vector< lut<Ty> >& rhs, std::vector< lut<Ty> >& result) {
+	static_assert(sizeof(lut<Ty>) == 1, "lut<Ty> must be a single byte to process arrays of encodings");
+	std::size_t n = (lhs.size() < rhs.size() ? lhs.size() : rhs.size());
+	result.resize(n);
+	lut_batch<Ty>(op, reinterpret_cast<const std::uint8_t*>(lhs.data()), reinterpret_cast<const std::uint8_t*>(rhs.data()), reinterpret_cast<std::uint8_t*>(result.data()), n);
+}
+
+template<typename Ty>
+inline lut<Ty> lut_dot(const std::vector< lut<Ty> >& x, const std::vector< lut<Ty> >& y) {
+	static_assert(sizeof(lut<Ty>) == 1, "lut<Ty> must be a single byte to process arrays of encodings");
+	std::size_t n = (x.size() < y.size() ? x.size() : y.size());
+	lut<Ty> sum;
+	sum.setbits(lut_dot<Ty>(reinterpret_cast<const std::uint8_t*>(x.data()), reinterpret_cast<const std::uint8_t*>(y.data()), n));
+	return sum;
+}
+
+}} // namespace sw::universal
@@ -0,0 +1,117 @@
+#pragma once
+// lut_tables.hpp: operator tables of 8-bit number systems, indexed by the encodings of the operands
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace sw { namespace universal {
+
+// the binary operators that are tabulated
+enum class LutOperator : unsigned {
+	ADD = 0,
+	SUB = 1,
+	MUL = 2,
+	DIV = 3
+};
+
+// the encoding of an 8-bit value: the number systems differ in how they expose their bits
+template<typename Ty>
+inline std::uint8_t lut_encoding(const Ty& v) noexcept {
+	if constexpr (requires { v.block(0); }) {         // cfloat, lns, dbns, fixpnt, ...
+		return static_cast<std::uint8_t>(v.block(0));
+	}
+	else if constexpr (requires { v.bits(); }) {      // posit
+		return static_cast<std::uint8_t>(v.bits());
+	}
+	else if constexpr (requires { v.encoding(); }) {  // posit<8,2>
+		return static_cast<std::uint8_t>(v.encoding());
+	}
+	else {
+		static_assert(sizeof(Ty) == 1, "lut_encoding: no way to extract the encoding of this type");
+		std::uint8_t bits{ 0 };
+		std::memcpy(&bits, &v, 1);
+		return bits;
+	}
+}
+
+/// <summary>
+/// Sum, difference, product, and quotient of every pair of encodings of an 8-bit number system,
+/// together with the negation and the double value of every encoding.
+/// The tables are generated once, on first use, through the arithmetic of the number system itself,
+/// so lookup arithmetic reproduces its rounding bit for bit.
+/// </summary>
+template<typename Ty>
+class LutTables {
+public:
+	static constexpr unsigned nbits = Ty::nbits;
+	static_assert(nbits <= 8, "LutTables: lookup-table arithmetic is limited to 8-bit number systems");
+	static constexpr std::size_t NR_ENCODINGS = (std::size_t(1) << nbits);
+	static constexpr std::size_t NR_ENTRIES = NR_ENCODINGS * NR_ENCODINGS;
+
+	static const LutTables& instance() {
+		static const LutTables tables;
+		return tables;
+	}
+
+	std::uint8_t add(std::uint8_t a, std::uint8_t b) const noexcept { return _table[0][index(a, b)]; }
+	std::uint8_t sub(std::uint8_t a, std::uint8_t b) const noexcept { return _table[1][index(a, b)]; }
+	std::uint8_t mul(std::uint8_t a, std::uint8_t b) const noexcept { return _table[2][index(a, b)]; }
+	std::uint8_t div(std::uint8_t a, std::uint8_t b) const noexcept { return _table[3][index(a, b)]; }
+	std::uint8_t negate(std::uint8_t a) const noexcept { return _negate[a]; }
+	double       value(std::uint8_t a) const noexcept { return _value[a]; }
+
+	// the row of the operator table for a left-hand side operand
+	const std::uint8_t* row(LutOperator op, std::uint8_t a) const noexcept {
+		return _table[static_cast<unsigned>(op)].data() + (std::size_t(a) << nbits);
+	}
+
+private:
+	std::vector<std::uint8_t> _table[4];
+	std::vector<std::uint8_t> _negate;
+	std::vector<double> _value;
+
+	static constexpr std::size_t index(std::uint8_t a, std::uint8_t b) noexcept {
+		return (std::size_t(a) << nbits) | b;
+	}
+
+	LutTables() : _negate(NR_ENCODINGS), _value(NR_ENCODINGS) {
+		for (auto& table : _table) table.resize(NR_ENTRIES);
+		Ty a, b;
+		for (std::size_t i = 0; i < NR_ENCODINGS; ++i) {
+			a.setbits(i);
+			_negate[i] = lut_encoding(Ty(-a));
+			_value[i] = double(a);
+			for (std::size_t j = 0; j < NR_ENCODINGS; ++j) {
+				b.setbits(j);
+				std::size_t k = (i << nbits) | j;
+				_table[0][k] = evaluate(a, b, LutOperator::ADD);
+				_table[1][k] = evaluate(a, b, LutOperator::SUB);
+				_table[2][k] = evaluate(a, b, LutOperator::MUL);
+				_table[3][k] = evaluate(a, b, LutOperator::DIV);
+			}
+		}
+	}
+
+	// number systems that are configured to throw on arithmetic exceptions yield their NaN encoding
+	static std::uint8_t evaluate(const Ty& a, const Ty& b, LutOperator op) {
+		Ty c;
+		try {
+			switch (op) {
+			case LutOperator::ADD: c = a + b; break;
+			case LutOperator::SUB: c = a - b; break;
+			case LutOperator::MUL: c = a * b; break;
+			case LutOperator::DIV: c = a / b; break;
+			}
+		}
+		catch (...) {
+			c = Ty(SpecificValue::qnan);
+		}
+		return lut_encoding(c);
+	}
+};
+
+}} // namespace sw::universal
@@ -0,0 +1,73 @@
+#pragma once
+// array_conversion.hpp: batched conversions between arrays of IEEE-754 floating-point values and posits
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace sw { namespace universal {
+
+// posit configurations up to this size are converted to float and double through a table of all their encodings
+constexpr unsigned POSIT_CONVERSION_TABLE_NBITS = 12;
+
+/// <summary>
+/// convert an array of floats or doubles to posits, for example when loading a dataset into a posit vector.
+/// Each element is rounded once, on the bits of its IEEE-754 encoding, as with the posit assignment operator.
+/// </summary>
+template<typename Real, unsigned nbits, unsigned es,
+	std::enable_if_t< std::is_floating_point_v<Real>, bool> = true>
+inline void convert(const Real* src, posit<nbits, es>* dst, std::size_t n) {
+	if constexpr (nbits <= 64 && (std::is_same_v<Real, float> || std::is_same_v<Real, double>)) {
+		for (std::size_t i = 0; i < n; ++i) dst[i].setbits(ieee754_to_posit_bits<nbits, es>(src[i]));
+	}
+	else {
+		for (std::size_t i = 0; i < n; ++i) dst[i] = src[i];
+	}
+}
+
+/// <summary>
+/// convert an array of posits to floats or doubles, rounding to nearest even.
+/// Narrow posit configurations are converted through a lookup table of all their encodings,
+/// which is built on first use, and wider configurations element by element.
+/// </summary>
+template<unsigned nbits, unsigned es, typename Real,
+	std::enable_if_t< std::is_floating_point_v<Real>, bool> = true>
+inline void convert(const posit<nbits, es>* src, Real* dst, std::size_t n) {
+	constexpr bool ieee754 = (std::is_same_v<Real, float> || std::is_same_v<Real, double>);
+	if constexpr (ieee754 && nbits <= POSIT_CONVERSION_TABLE_NBITS) {
+		constexpr std::size_t NR_ENCODINGS = (std::size_t(1) << nbits);
+		static const std::vector<Real> table = [] {
+			std::vector<Real> t(NR_ENCODINGS);
+			for (std::size_t i = 0; i < NR_ENCODINGS; ++i) t[i] = posit_bits_to_ieee754<Real, nbits, es>(i);
+			return t;
+		}();
+		for (std::size_t i = 0; i < n; ++i) dst[i] = table[src[i].bits() & (NR_ENCODINGS - 1)];
+	}
+	else if constexpr (ieee754 && nbits <= 64) {
+		for (std::size_t i = 0; i < n; ++i) dst[i] = posit_bits_to_ieee754<Real, nbits, es>(src[i].bits());
+	}
+	else {
+		for (std::size_t i = 0; i < n; ++i) dst[i] = Real(src[i]);
+	}
+}
+
+// vector forms of the batched conversions
+template<typename Real, unsigned nbits, unsigned es,
+	std::enable_if_t< std::is_floating_point_v<Real>, bool> = true>
+inline void convert(const std::vector<Real>& src, std::vector< posit<nbits, es> >& dst) {
+	dst.resize(src.size());
+	convert(src.data(), dst.data(), src.size());
+}
+
+template<unsigned nbits, unsigned es, typename Real,
+	std::enable_if_t< std::is_floating_point_v<Real>, bool> = true>
+inline void convert(const std::vector< posit<nbits, es> >& src, std::vector<Real>& dst) {
+	dst.resize(src.size());
+	convert(src.data(), dst.data(), src.size());
+}
+
+}} // namespace sw::universal
@@ -0,0 +1,117 @@
+#pragma once
+// native_arithmetic.hpp: native integer arithmetic for posit configurations that fit in 32 bits
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <bit>
+#include <utility>
+
+/*
+ The generic posit operators normalize their operands into value<> triples with bitblock
+ fractions, compute, and round the result back through convert(). For a posit with nbits <= 32
+ the significands fit in a native integer, and the same operations reduce to:
+
+     decode    : decode_bits measures the regime run length with a count of leading zeros or ones,
+                 and extracts the exponent and fraction fields with shifts
+     compute   : add, multiply, or divide the significands in uint64_t, jamming the bits
+                 that fall off into a sticky bit
+     round     : encode_bits rounds regime, exponent, and fraction to nearest even on the encoding,
+                 with the same projection onto minpos and maxpos as convert()
+
+ This generalizes the hand-written fast posits, such as posit_16_1.hpp, to any posit<nbits, es>
+ with nbits <= 32. The kernels expect operands that are not zero or NaR: the posit operators
+ dispatch the special cases before they get here.
+ */
+
+namespace sw { namespace universal {
+
+// the position of the leading one of a non-zero significand, with the bits after it left aligned in fraction
+inline int posit_native_normalize(uint64_t significand, uint64_t& fraction) noexcept {
+	int msb = 63 - std::countl_zero(significand);
+	fraction = (msb > 0 ? significand << (64 - msb) : 0ull);
+	return msb;
+}
+
+// round (sign, scale, fraction) to the nearest posit, projecting scales beyond the regime range onto minpos and maxpos
+template<unsigned nbits, unsigned es>
+inline void posit_native_round(bool sign, int scale, uint64_t fraction, bool sticky, posit<nbits, es>& result) noexcept {
+	if (check_inward_projection_range<nbits, es>(scale)) {
+		result.setBitblock(scale < 0 ? minpos_pattern<nbits, es>(sign) : maxpos_pattern<nbits, es>(sign));
+	}
+	else {
+		result.setbits(encode_bits<nbits, es>(sign, scale, fraction, sticky));
+	}
+}
+
+// sign and magnitude of a posit encoding
+template<unsigned nbits, unsigned es>
+inline uint64_t posit_native_magnitude(const posit<nbits, es>& p, bool& sign) noexcept {
+	constexpr uint64_t mask = (1ull << nbits) - 1ull;
+	uint64_t raw = p.bits();
+	sign = ((raw >> (nbits - 1)) & 1u) != 0;
+	return (sign ? (~raw + 1ull) & mask : raw);
+}
+
+// result = a + b
+template<unsigned nbits, unsigned es>
+inline void posit_native_add(const posit<nbits, es>& a, const posit<nbits, es>& b, posit<nbits, es>& result) noexcept {
+	bool sa{ false }, sb{ false };
+	uint64_t ma = posit_native_magnitude(a, sa);
+	uint64_t mb = posit_native_magnitude(b, sb);
+	if (ma < mb) {   // the magnitude of a posit is monotonic in its encoding
+		std::swap(ma, mb);
+		std::swap(sa, sb);
+	}
+	if (sa != sb && ma == mb) {
+		result.setzero();
+		return;
+	}
+	uint64_t fa{ 0 }, fb{ 0 };
+	int scale = decode_bits<nbits, es>(ma, fa);
+	int shift = scale - decode_bits<nbits, es>(mb, fb);
+	// significands with the hidden bit at position 62, which leaves room for the carry of the sum
+	uint64_t siga = (1ull << 62) | (fa >> 2);
+	uint64_t sigb = (1ull << 62) | (fb >> 2);
+	bool sticky = (shift >= 64 ? true : (sigb & ((1ull << shift) - 1ull)) != 0);
+	sigb = (shift >= 64 ? 0ull : sigb >> shift) | (sticky ? 1ull : 0ull);
+	uint64_t fraction{ 0 };
+	int msb = posit_native_normalize(sa == sb ? siga + sigb : siga - sigb, fraction);
+	posit_native_round<nbits, es>(sa, scale + msb - 62, fraction, false, result);
+}
+
+// result = a * b
+template<unsigned nbits, unsigned es>
+inline void posit_native_mul(const posit<nbits, es>& a, const posit<nbits, es>& b, posit<nbits, es>& result) noexcept {
+	bool sa{ false }, sb{ false };
+	uint64_t ma = posit_native_magnitude(a, sa);
+	uint64_t mb = posit_native_magnitude(b, sb);
+	uint64_t fa{ 0 }, fb{ 0 };
+	int scale = decode_bits<nbits, es>(ma, fa) + decode_bits<nbits, es>(mb, fb);
+	// significands with the hidden bit at position 30: their product is exact in 62 bits
+	uint64_t siga = (1ull << 30) | (fa >> 34);
+	uint64_t sigb = (1ull << 30) | (fb >> 34);
+	uint64_t fraction{ 0 };
+	int msb = posit_native_normalize(siga * sigb, fraction);
+	posit_native_round<nbits, es>(sa != sb, scale + msb - 60, fraction, false, result);
+}
+
+// result = a / b
+template<unsigned nbits, unsigned es>
+inline void posit_native_div(const posit<nbits, es>& a, const posit<nbits, es>& b, posit<nbits, es>& result) noexcept {
+	bool sa{ false }, sb{ false };
+	uint64_t ma = posit_native_magnitude(a, sa);
+	uint64_t mb = posit_native_magnitude(b, sb);
+	uint64_t fa{ 0 }, fb{ 0 };
+	int scale = decode_bits<nbits, es>(ma, fa) - decode_bits<nbits, es>(mb, fb);
+	// the quotient of the significands, scaled by 2^32, carries at least 31 bits after its leading one,
+	// and the remainder collapses into the sticky bit
+	uint64_t dividend = ((1ull << 30) | (fa >> 34)) << 32;
+	uint64_t divisor = (1ull << 30) | (fb >> 34);
+	uint64_t fraction{ 0 };
+	int msb = posit_native_normalize(dividend / divisor, fraction);
+	posit_native_round<nbits, es>(sa != sb, scale + msb - 32, fraction, (dividend % divisor) != 0, result);
+}
+
+}} // namespace sw::universal
@@ -52,6 +52,17 @@
 #endif
 #endif
 
+////////////////////////////////////////////////////////////////////////////////////////
+// enable native integer arithmetic for configurations with nbits <= 32
+// POSIT_FAST_SPECIALIZATION when set will turn on the native integer fast paths
+// of add, sub, mul, and div; POSIT_NATIVE_ARITHMETIC offers the same control as a 0/1 switch
+#ifdef POSIT_FAST_SPECIALIZATION
+#define POSIT_NATIVE_ARITHMETIC 1
+#endif
+#if !defined(POSIT_NATIVE_ARITHMETIC)
+#define POSIT_NATIVE_ARITHMETIC 0
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////
 ///                         END OF BEHAVIOR SWITCHES                                 ///
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -69,6 +80,7 @@
 #include <universal/number/posit/posit_fwd.hpp>
 #include <universal/number/posit/posit_parse.hpp>
 #include <universal/number/posit/posit_impl.hpp>
+#include <universal/number/posit/native_arithmetic.hpp>
 #include <universal/traits/posit_traits.hpp>
 #include <universal/number/posit/numeric_limits.hpp>
 
@@ -86,6 +98,10 @@
 #include <universal/number/posit/manipulators.hpp>
 #include <universal/number/posit/attributes.hpp>
 
+///////////////////////////////////////////////////////////////////////////////////////
+/// batched conversions between arrays of IEEE-754 floating-point values and posits
+#include <universal/number/posit/array_conversion.hpp>
+
 ///////////////////////////////////////////////////////////////////////////////////////
 /// the quire that enables user-controlled rounding
 #include <universal/number/quire/exceptions.hpp>
@@ -4,6 +4,7 @@
 // Copyright (C) 2017 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <bit>
 #include <cmath>
 #include <cassert>
 #include <iostream>
@@ -19,6 +20,13 @@
 #endif
 #endif
 
+#ifdef POSIT_FAST_SPECIALIZATION
+#define POSIT_NATIVE_ARITHMETIC 1
+#endif
+#ifndef POSIT_NATIVE_ARITHMETIC
+#define POSIT_NATIVE_ARITHMETIC 0
+#endif
+
 // calling environment should define behavioral flags
 // typically set in the library aggregation include file <posit>
 // but can be set by individual programs when including posit.hpp
@@ -108,6 +116,14 @@ bool check_inward_projection_range(int scale) {
 // scale  = useed ^ k * 2^e = k*(2 ^ es) + e 
 template<unsigned nbits>
 int decode_regime(const internal::bitblock<nbits>& raw_bits) {
+	if constexpr (nbits <= 64) {
+		// drop the sign bit and left-align the regime, so that its run-length is a count of leading ones or zeros
+		constexpr int regimeBits = static_cast<int>(nbits) - 1;
+		uint64_t field = raw_bits.to_ullong() << (65u - nbits);
+		if (field & (1ull << 63)) return std::countl_one(field) - 1;   // a run of m 1's yields k = m - 1
+		int m = std::countl_zero(field);
+		return -(m < regimeBits ? m : regimeBits);                      // a run of m 0's yields k = -m
+	}
 	// let m be the number of identical bits in the regime
 	int m = 0;   // regime runlength counter
 	int k = 0;   // converted regime scale
@@ -143,6 +159,38 @@ int decode_regime(const internal::bitblock<nbits>& raw_bits) {
 // extract_fields takes a raw posit encoding and extracts the sign, regime, exponent, and fraction components
 template<unsigned nbits, unsigned es, unsigned fbits>
 void extract_fields(const bitblock<nbits>& raw_bits, bool& _sign, regime<nbits, es>& _regime, exponent<nbits, es>& _exponent, fraction<fbits>& _fraction) {
+	if constexpr (nbits <= 64 && fbits <= 64) {
+		// the fields are extracted from a native word that is shifted left as each field is consumed
+		constexpr uint64_t mask = (nbits == 64 ? ~0ull : (1ull << nbits) - 1ull);
+		uint64_t raw = raw_bits.to_ullong();
+		if (raw == 0 || raw == (1ull << (nbits - 1))) {  // zero or NaR
+			_sign = (raw != 0);
+			_regime.setzero();
+			_exponent.setzero();
+			_fraction.setzero();
+			return;
+		}
+		_sign = (raw >> (nbits - 1)) & 1u;
+		if (_sign) raw = (~raw + 1ull) & mask;
+		bitblock<nbits> tmp;
+		tmp = raw;
+		unsigned nrRegimeBits = _regime.assign_regime_pattern(decode_regime(tmp));
+		uint64_t field = (raw << (65u - nbits)) << nrRegimeBits;  // drop the sign and the regime
+		unsigned remainingBits = nbits - 1u - nrRegimeBits;
+		if constexpr (es > 0) {
+			unsigned nrExponentBits = (remainingBits < es ? remainingBits : es);
+			bitblock<es> _exp;
+			_exp = (field >> (64u - es));  // a truncated exponent is left-aligned
+			_exponent.set(_exp, nrExponentBits);
+			field <<= es;
+			remainingBits -= nrExponentBits;
+		}
+		// the msb of the fraction represents 2^-1, and the fraction is right extended with 0's
+		bitblock<fbits> _frac;
+		if constexpr (fbits > 0) _frac = (field >> (64u - fbits));
+		_fraction.set(_frac, remainingBits);
+		return;
+	}
 	// check special cases
 	bitblock<nbits> nar;
 	nar[nbits - 1] = true;
@@ -242,6 +290,180 @@ void decode(const bitblock<nbits>& raw_bits, bool& _sign, regime<nbits, es>& _re
 	// so no need to transform back via 2's complement of regime/exponent/fraction
 }
 
+// encode_bits rounds (sign, scale, fraction) to the nbits encoding of a posit on a native word.
+// The regime, exponent, and fraction fields are appended to a window of nbits bits, the posit without
+// its sign plus a guard bit, and the bits that fall off the end of the window collapse into a sticky bit.
+// The fraction is left aligned in a 64-bit word, without the hidden bit, and fraction_sticky
+// carries any fraction bits beyond those 64.
+// The scale must be in the range that check_inward_projection_range accepts.
+template<unsigned nbits, unsigned es>
+inline uint64_t encode_bits(bool _sign, int _scale, uint64_t fraction, bool fraction_sticky) {
+	static_assert(nbits <= 64, "encode_bits requires the posit to fit in a native word");
+	uint64_t window{ 0 };
+	unsigned room = nbits;
+	bool sticky{ fraction_sticky };
+	auto append = [&](uint64_t field, unsigned width) {   // width <= 64 and field < 2^width
+		if (width <= room) {
+			window = (width < 64 ? (window << width) : 0ull) | field;
+			room -= width;
+		}
+		else {
+			unsigned dropped = width - room;
+			window = (room > 0 ? (window << room) | (field >> dropped) : window);
+			sticky = sticky || (field & (dropped < 64 ? (1ull << dropped) - 1ull : ~0ull)) != 0;
+			room = 0;
+		}
+	};
+
+	// a run of identical bits, terminated by the opposite bit, cannot be longer than nbits - 1
+	bool r = (_scale >= 0);
+	unsigned run = static_cast<unsigned>(r ? 1 + (_scale >> es) : -(_scale >> es));
+	append(r ? ((1ull << run) - 1ull) << 1 : 1ull, run + 1);
+	if constexpr (es > 0) append(static_cast<uint64_t>(static_cast<unsigned>(_scale) & ((1u << es) - 1u)), es);
+	if (room > 0) {
+		unsigned nf = room;                              // nf < 64: the regime occupies at least one bit
+		append(fraction >> (64u - nf), nf);
+		sticky = sticky || (fraction << nf) != 0;
+	}
+	else {
+		sticky = sticky || fraction != 0;
+	}
+
+	// round to nearest, ties to even, on the guard bit
+	bool guard = (window & 1ull) != 0;
+	uint64_t bits = window >> 1;
+	if (guard && (sticky || (bits & 1ull))) ++bits;
+	if (_sign) bits = ~bits + 1ull;
+	return (nbits == 64 ? bits : bits & ((1ull << nbits) - 1ull));
+}
+
+template<unsigned nbits, unsigned es, unsigned fbits>
+inline uint64_t encode_bits(bool _sign, int _scale, const bitblock<fbits>& fraction_in) {
+	if constexpr (fbits == 0) {
+		return encode_bits<nbits, es>(_sign, _scale, 0ull, false);
+	}
+	else if constexpr (fbits <= 64) {
+		return encode_bits<nbits, es>(_sign, _scale, fraction_in.to_ullong() << (64u - fbits), false);
+	}
+	else {
+		return encode_bits<nbits, es>(_sign, _scale, (fraction_in >> (fbits - 64u)).to_ullong(), (fraction_in << 64u).any());
+	}
+}
+
+// decode_bits returns the scale of the magnitude of a posit encoding that is not zero or NaR, with its fraction
+// left aligned in a 64-bit word, without the hidden bit. The regime run length is a count of leading ones or zeros.
+template<unsigned nbits, unsigned es>
+inline int decode_bits(uint64_t magnitude, uint64_t& fraction) noexcept {
+	static_assert(nbits <= 64, "decode_bits requires the posit to fit in a native word");
+	uint64_t field = magnitude << (65u - nbits);   // the bits after the sign bit, left aligned
+	int k{ 0 };
+	unsigned run{ 0 };
+	if (field >> 63) {
+		run = static_cast<unsigned>(std::countl_one(field));
+		k = static_cast<int>(run) - 1;
+	}
+	else {
+		run = static_cast<unsigned>(std::countl_zero(field));
+		k = -static_cast<int>(run);
+	}
+	field = (run < 63u ? field << (run + 1u) : 0ull);   // skip the regime and its terminating bit
+	int e{ 0 };
+	if constexpr (es > 0) {
+		e = static_cast<int>(field >> (64u - es));     // a truncated exponent is right extended with 0's
+		field <<= es;
+	}
+	fraction = field;
+	return k * (1 << es) + e;
+}
+
+// ieee754_to_posit_bits rounds a float or double to the nearest posit encoding on a native word. The IEEE-754
+// fields are taken apart with integer operations, subnormals are normalized with a count of leading zeros,
+// and encode_bits rounds once.
+template<unsigned nbits, unsigned es, typename Real>
+inline uint64_t ieee754_to_posit_bits(Real rhs) noexcept {
+	static_assert(std::is_same_v<Real, float> || std::is_same_v<Real, double>, "ieee754_to_posit_bits requires float or double");
+	using Word = std::conditional_t<sizeof(Real) == 4, uint32_t, uint64_t>;
+	constexpr int ieee_fbits = std::numeric_limits<Real>::digits - 1;
+	constexpr int ieee_ebits = static_cast<int>(8 * sizeof(Real)) - 1 - ieee_fbits;
+	constexpr int bias = (1 << (ieee_ebits - 1)) - 1;
+	constexpr uint64_t mask = (nbits == 64 ? ~0ull : (1ull << nbits) - 1ull);
+	constexpr uint64_t nar = (1ull << (nbits - 1));
+	Word raw = std::bit_cast<Word>(rhs);
+	bool sign = ((raw >> (8 * sizeof(Real) - 1)) & 1u) != 0;
+	int biased = static_cast<int>((raw >> ieee_fbits) & ((Word(1) << ieee_ebits) - 1u));
+	uint64_t mantissa = static_cast<uint64_t>(raw & ((Word(1) << ieee_fbits) - 1u));
+	if (biased == (1 << ieee_ebits) - 1) return nar;   // posit encode for FP_INFINITE and NaN as NaR (Not a Real)
+	int scale{ 0 };
+	uint64_t fraction{ 0 };
+	if (biased == 0) {
+		if (mantissa == 0) return 0;
+		int msb = 63 - std::countl_zero(mantissa);
+		scale = msb + 1 - bias - ieee_fbits;
+		fraction = (msb > 0 ? mantissa << (64 - msb) : 0ull);
+	}
+	else {
+		scale = biased - bias;
+		fraction = mantissa << (64 - ieee_fbits);
+	}
+	if (check_inward_projection_range<nbits, es>(scale)) {   // project onto minpos or maxpos
+		uint64_t magnitude = (scale < 0 ? 1ull : nar - 1ull);
+		return (sign ? (~magnitude + 1ull) & mask : magnitude);
+	}
+	return encode_bits<nbits, es>(sign, scale, fraction, false);
+}
+
+// integer_to_posit_bits rounds the magnitude of an integer to the nearest posit encoding on a native word
+template<unsigned nbits, unsigned es>
+inline uint64_t integer_to_posit_bits(bool sign, uint64_t magnitude) noexcept {
+	constexpr uint64_t mask = (nbits == 64 ? ~0ull : (1ull << nbits) - 1ull);
+	if (magnitude == 0) return 0;
+	int scale = 63 - std::countl_zero(magnitude);
+	if (check_inward_projection_range<nbits, es>(scale)) {   // project onto maxpos
+		uint64_t maxpos = (1ull << (nbits - 1)) - 1ull;
+		return (sign ? (~maxpos + 1ull) & mask : maxpos);
+	}
+	return encode_bits<nbits, es>(sign, scale, (scale > 0 ? magnitude << (64 - scale) : 0ull), false);
+}
+
+// posit_bits_to_ieee754 rounds a posit encoding on a native word to the nearest float or double, to nearest even.
+// Posits with an es that takes them beyond the exponent range of Real round into the subnormals or to infinity.
+template<typename Real, unsigned nbits, unsigned es>
+inline Real posit_bits_to_ieee754(uint64_t raw) noexcept {
+	static_assert(std::is_same_v<Real, float> || std::is_same_v<Real, double>, "posit_bits_to_ieee754 requires float or double");
+	using Word = std::conditional_t<sizeof(Real) == 4, uint32_t, uint64_t>;
+	constexpr int ieee_fbits = std::numeric_limits<Real>::digits - 1;
+	constexpr int ieee_ebits = static_cast<int>(8 * sizeof(Real)) - 1 - ieee_fbits;
+	constexpr int bias = (1 << (ieee_ebits - 1)) - 1;
+	constexpr uint64_t mask = (nbits == 64 ? ~0ull : (1ull << nbits) - 1ull);
+	constexpr uint64_t nar = (1ull << (nbits - 1));
+	raw &= mask;
+	if (raw == 0) return Real(0);
+	if (raw == nar) return std::numeric_limits<Real>::quiet_NaN();
+	bool sign = (raw & nar) != 0;
+	uint64_t fraction{ 0 };
+	int scale = decode_bits<nbits, es>(sign ? (~raw + 1ull) & mask : raw, fraction);
+	Word bits{ 0 };
+	if (scale > bias) {
+		bits = Word((Word(1) << ieee_ebits) - 1u) << ieee_fbits;   // infinity
+	}
+	else {
+		// the significand has its hidden bit at position 63, and the shift aligns it with the IEEE-754
+		// hidden bit, or below it for a subnormal
+		uint64_t significand = (1ull << 63) | (fraction >> 1);
+		int shift = (63 - ieee_fbits) + (scale < 1 - bias ? 1 - bias - scale : 0);
+		uint64_t mantissa{ 0 };
+		if (shift <= 64) {
+			mantissa = (shift < 64 ? significand >> shift : 0ull);
+			bool guard = ((significand >> (shift - 1)) & 1u) != 0;
+			bool sticky = (significand & ((1ull << (shift - 1)) - 1ull)) != 0 || (fraction & 1u) != 0;
+			if (guard && (sticky || (mantissa & 1u))) ++mantissa;   // a carry moves into the exponent field
+		}
+		bits = (scale < 1 - bias ? Word(mantissa) : (Word(scale + bias - 1) << ieee_fbits) + Word(mantissa));
+	}
+	if (sign) bits |= Word(1) << (8 * sizeof(Real) - 1);
+	return std::bit_cast<Real>(bits);
+}
+
 // needed to avoid double rounding situations during arithmetic: TODO: does that mean the condensed version below should be removed?
 template<unsigned nbits, unsigned es, unsigned fbits>
 inline bitblock<nbits>& convert_to_bb(bool _sign, int _scale, const bitblock<fbits>& fraction_in, bitblock<nbits>& ptt) {
@@ -259,6 +481,9 @@ inline bitblock<nbits>& convert_to_bb(bool _sign, int _scale, const bitblock<fbi
 		// we are done
 		if (_trace_rounding) std::cout << "projection  rounding ";
 	}
+	else if constexpr (nbits <= 64) {
+		ptt = encode_bits<nbits, es, fbits>(_sign, _scale, fraction_in);
+	}
 	else {
 		const unsigned pt_len = nbits + 3 + es;
 		bitblock<pt_len> pt_bits;
@@ -330,6 +555,11 @@ inline posit<nbits, es>& convert_(bool _sign, int _scale, const bitblock<fbits>&
 		// we are done
 		if (_trace_rounding) std::cout << "projection  rounding ";
 	}
+	else if constexpr (nbits <= 64) {
+		bitblock<nbits> ptt;
+		ptt = encode_bits<nbits, es, fbits>(_sign, _scale, fraction_in);
+		p.setBitblock(ptt);
+	}
 	else {
 		constexpr unsigned pt_len = nbits + 3 + es;
 		bitblock<pt_len> pt_bits;
@@ -489,6 +719,8 @@ public:
 	static constexpr unsigned mbits   = 2 * fhbits;                 // size of the multiplier output
 	static constexpr unsigned divbits = 3 * fhbits + 4;             // size of the divider output
 
+	static constexpr bool     nativeArithmetic = (POSIT_NATIVE_ARITHMETIC != 0) && (nbits <= 32);  // integer fast paths of native_arithmetic.hpp
+
 	// constexpr posit() { setzero();  }
 	constexpr posit() : _bits{} {}
 	
@@ -550,6 +782,7 @@ public:
 
 	// assignment operators for native types
 	posit& operator=(signed char rhs) noexcept {
+		if constexpr (nbits <= 64) return convert_integer(rhs);
 		internal::value<8*sizeof(signed char)-1> v(rhs);
 		if (v.iszero()) {
 			setzero();
@@ -561,6 +794,7 @@ public:
 		return *this;
 	}
 	posit& operator=(short rhs) noexcept {
+		if constexpr (nbits <= 64) return convert_integer(rhs);
 		internal::value<8*sizeof(short)-1> v(rhs);
 		if (v.iszero()) {
 			setzero();
@@ -572,6 +806,7 @@ public:
 		return *this;
 	}
 	posit& operator=(int rhs) noexcept {
+		if constexpr (nbits <= 64) return convert_integer(rhs);
 		internal::value<8*sizeof(int)-1> v(rhs);
 		if (v.iszero()) {
 			setzero();
@@ -583,6 +818,7 @@ public:
 		return *this;
 	}
 	posit& operator=(long rhs) noexcept {
+		if constexpr (nbits <= 64) return convert_integer(rhs);
 		internal::value<8*sizeof(long)> v(rhs);
 		if (v.iszero()) {
 			setzero();
@@ -594,6 +830,7 @@ public:
 		return *this;
 	}
 	posit& operator=(long long rhs) noexcept {
+		if constexpr (nbits <= 64) return convert_integer(rhs);
 		internal::value<8*sizeof(long long)-1> v(rhs);
 		if (v.iszero()) {
 			setzero();
@@ -605,6 +842,7 @@ public:
 		return *this;
 	}
 	posit& operator=(char rhs) noexcept {
+		if constexpr (nbits <= 64) return convert_integer(rhs);
 		internal::value<8*sizeof(char)> v(rhs);
 		if (v.iszero()) {
 			setzero();
@@ -616,6 +854,7 @@ public:
 		return *this;
 	}
 	posit& operator=(unsigned short rhs) noexcept {
+		if constexpr (nbits <= 64) return convert_integer(rhs);
 		internal::value<8*sizeof(unsigned short)> v(rhs);
 		if (v.iszero()) {
 			setzero();
@@ -627,6 +866,7 @@ public:
 		return *this;
 	}
 	posit& operator=(unsigned int rhs) noexcept {
+		if constexpr (nbits <= 64) return convert_integer(rhs);
 		internal::value<8*sizeof(unsigned int)> v(rhs);
 		if (v.iszero()) {
 			setzero();
@@ -638,6 +878,7 @@ public:
 		return *this;
 	}
 	posit& operator=(unsigned long rhs) noexcept {
+		if constexpr (nbits <= 64) return convert_integer(rhs);
 		internal::value<8*sizeof(unsigned long)> v(rhs);
 		if (v.iszero()) {
 			setzero();
@@ -649,6 +890,7 @@ public:
 		return *this;
 	}
 	posit& operator=(unsigned long long rhs) noexcept {
+		if constexpr (nbits <= 64) return convert_integer(rhs);
 		internal::value<8*sizeof(unsigned long long)> v(rhs);
 		if (v.iszero()) {
 			setzero();
@@ -739,6 +981,10 @@ public:
 			return *this;
 		}
 		if (rhs.iszero()) return *this;
+		if constexpr (nativeArithmetic) {
+			posit_native_add(*this, rhs, *this);
+			return *this;
+		}
 
 		// arithmetic operation
 		internal::value<abits + 1> sum;
@@ -781,6 +1027,10 @@ public:
 			return *this;
 		}
 		if (rhs.iszero()) return *this;
+		if constexpr (nativeArithmetic) {
+			posit_native_add(*this, -rhs, *this);
+			return *this;
+		}
 
 		// arithmetic operation
 		internal::value<abits + 1> difference;
@@ -823,6 +1073,10 @@ public:
 			setzero();
 			return *this;
 		}
+		if constexpr (nativeArithmetic) {
+			posit_native_mul(*this, rhs, *this);
+			return *this;
+		}
 
 		// arithmetic operation
 		internal::value<mbits> product;
@@ -877,6 +1131,11 @@ public:
 			return *this;
 		}
 #endif
+		if constexpr (nativeArithmetic) {
+			posit_native_div(*this, rhs, *this);
+			return *this;
+		}
+
 		internal::value<divbits> ratio;
 		internal::value<fbits> a, b;
 		// transform the inputs into (sign,scale,fraction) triples
@@ -1073,14 +1332,7 @@ public:
 	}
 	// Set the raw bits of the posit given an unsigned value starting from the lsb. Handy for enumerating a posit state space
 	constexpr posit<nbits, es>& setbits(uint64_t value) noexcept {
-		clear();
-		bitblock<nbits> raw_bits;
-		uint64_t mask = 1;
-		for (unsigned i = 0; i < nbits; i++) {
-			raw_bits.set(i, (value & mask));
-			mask <<= 1;
-		}
-		_bits = raw_bits;
+		_bits = value;   // bits beyond nbits are masked off
 		return *this;
 	}
 	constexpr posit<nbits, es>& setbit(unsigned bitIndex, bool value = true) noexcept {
@@ -1202,9 +1454,11 @@ private:
 	unsigned long long to_ulong_long() const { return (unsigned long long)(to_long_double()); }
 #endif
 	float to_float() const {
+		if constexpr (nbits <= 64) return posit_bits_to_ieee754<float, nbits, es>(bits());
 		return (float)to_double();
 	}
 	double to_double() const {
+		if constexpr (nbits <= 64) return posit_bits_to_ieee754<double, nbits, es>(bits());
 		if (iszero())	return 0.0;
 		if (isnar())	return std::numeric_limits<double>::quiet_NaN();
 		bool		     	 _sign{ false };
@@ -1232,8 +1486,22 @@ private:
 		long double f = (1.0l + _fraction.value());
 		return s * r * e * f;
 	}
+	template <typename Integer>
+	posit<nbits, es>& convert_integer(Integer rhs) noexcept {
+		if constexpr (std::is_signed_v<Integer>) {
+			bool sign = (rhs < 0);
+			uint64_t magnitude = static_cast<uint64_t>(static_cast<long long>(rhs));
+			return setbits(integer_to_posit_bits<nbits, es>(sign, sign ? 0ull - magnitude : magnitude));
+		}
+		else {
+			return setbits(integer_to_posit_bits<nbits, es>(false, static_cast<uint64_t>(rhs)));
+		}
+	}
 	template <typename T>
 	constexpr posit<nbits, es>& convert_ieee754(const T& rhs) {
+		if constexpr (nbits <= 64 && (std::is_same_v<T, float> || std::is_same_v<T, double>)) {
+			return setbits(ieee754_to_posit_bits<nbits, es>(rhs));
+		}
 		constexpr int dfbits = std::numeric_limits<T>::digits - 1;
 		internal::value<dfbits> v(static_cast<T>(rhs));
 
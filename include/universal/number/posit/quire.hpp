@@ -4,7 +4,12 @@
 // Copyright (C) 2017 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <bit>
+#include <bitset>
+#include <string>
 #include <universal/utility/boolean_logic_operators.hpp>
+#include <universal/native/limb_arithmetic.hpp>
 #include <universal/number/quire/exceptions.hpp>
 
 namespace sw { namespace universal {
@@ -89,14 +94,20 @@ inline int min_scale() {
 	return -int(half_range); 
 }
 
-/* 
+/*
  quire: template class representing a quire associated with a posit configuration
- nbits and es are the same as the posit configuration, 
+ nbits and es are the same as the posit configuration,
  capacity indicates the power of 2 number of accumulations of maxpos^2 the quire can support
 
  All values in and out of the quire are normalized (sign, scale, fraction) triplets.
  Even though a quire is very strongly coupled to a posit configuration via the dynamic range
  a particular posit configuration exhibits, the class is designed to NOT depend on the posit<nbits,es> class definition.
+
+ The accumulator is kept in sign-magnitude form in a contiguous array of 64-bit limbs:
+ bits [0, half_range) are the lower accumulator, the radix point sits at bit half_range,
+ followed by the upper_range bits of the upper accumulator and the capacity bits.
+ A normalized value is added by aligning its significand to the limbs it overlaps
+ and propagating the carry, so an accumulation costs a handful of word operations.
  */
 template<unsigned nbits, unsigned es, unsigned capacity = 30>
 class quire {
@@ -108,9 +119,14 @@ public:
 	// the upper is 1 bit bigger than the lower because maxpos^2 has that scale
 	static constexpr unsigned upper_range = half_range + 1;     // size of the upper accumulator
 	static constexpr unsigned qbits = range + capacity;		  // size of the quire minus the sign bit: we are managing the sign explicitly
-	
+	// limb organization of the accumulator: lower + upper + capacity = qbits + 1 bits
+	static constexpr unsigned bitsInLimb = 64;
+	static constexpr unsigned nrLimbs = (qbits + 1 + bitsInLimb - 1) / bitsInLimb;
+	static constexpr unsigned MSU = nrLimbs - 1;
+	static constexpr std::uint64_t MSU_MASK = (~std::uint64_t(0)) >> (nrLimbs * bitsInLimb - (qbits + 1));
+
 	// Constructors
-	quire() : _sign(false) { _capacity.reset(); _upper.reset(); _lower.reset(); }
+	quire() : _sign(false), _accu{ 0 } {}
 
 	quire(int8_t initial_value)   { *this = initial_value; }
 	quire(int16_t initial_value)  { *this = initial_value; }
@@ -135,38 +151,13 @@ public:
 
 		int scale = rhs.scale();
 		// TODO: we are clamping the values of the RHS to be within the dynamic range of the posit
-		// TODO: however, on the upper side we also have the capacity bits, which gives us the opportunity 
+		// TODO: however, on the upper side we also have the capacity bits, which gives us the opportunity
 		// TODO: to accept larger scale values than the dynamic range of the posit.
 		// TODO: When you are assigning the sum of quires you could hit this condition.
 		if (scale >  int(half_range)) 	throw operand_too_large_for_quire{};
 		if (scale < -int(half_range)) 	throw operand_too_small_for_quire{};
 
-		int i, f; // running bit pointers, i for the quire, f for the incoming fraction
-		sw::universal::bitblock<fbits+1> fraction = rhs.get_fixed_point();
-		// divide bits between upper and lower accumulator
-		if (scale - int(fbits) >= 0) {
-			// all upper accumulator
-			for (i = scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_upper[static_cast<unsigned>(i)] = fraction[static_cast<unsigned>(f)];
-			}
-		}
-		else if (scale < 0) {
-			// all lower accumulator
-			for (i = int(half_range) + scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_lower[static_cast<unsigned>(i)] = fraction[static_cast<unsigned>(f)];
-			}
-		}
-		else {
-			// part upper, and part lower accumulator
-			// first assign the bits in the upper accumulator
-			for (i = scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_upper[static_cast<unsigned>(i)] = fraction[static_cast<unsigned>(f)];
-			}
-			// next assign the bits in the lower accumulator
-			for (i = int(half_range) - 1; i >= 0 && f >= 0; i--, f--) {
-				_lower[static_cast<unsigned>(i)] = fraction[static_cast<unsigned>(f)];
-			}
-		}
+		add_value(rhs);  // adding to a cleared accumulator places the significand
 		return *this;
 	}
 	quire& operator=(const posit<nbits, es>& rhs) {
@@ -188,51 +179,14 @@ public:
 	quire& operator=(int64_t rhs) {
 		clear();
 		// transform to sign-magnitude
-		_sign = rhs & 0x8000000000000000;
-		unsigned long long magnitude;
-		magnitude = static_cast<unsigned long long>(_sign ? -rhs : rhs);
-		unsigned msb = find_msb(magnitude);
-		if (msb > half_range + capacity) {
-			throw operand_too_large_for_quire{};
-		}
-		else {
-			// copy the value into the quire
-			uint32_t i;
-			uint64_t mask = uint64_t(1);
-			for (i = 0; i < msb && i < half_range; i++) {
-				_upper[i] = magnitude & mask;
-				mask <<= 1;
-			}
-			if (msb >= half_range) {
-				uint32_t c;
-				for (i = half_range, c = 0; i < msb && i < half_range + capacity; i++, c++) {
-					_capacity[c] = magnitude & mask;
-					mask <<= 1;
-				}
-			}
-		}
+		_sign = rhs < 0;
+		std::uint64_t magnitude = _sign ? (~static_cast<std::uint64_t>(rhs) + 1ull) : static_cast<std::uint64_t>(rhs);
+		load_integer(magnitude);
 		return *this;
 	}
 	quire& operator=(unsigned long long rhs) {
 		reset();
-		unsigned msb = find_msb(rhs);
-		if (msb > half_range + capacity) {
-			throw operand_too_large_for_quire{};
-		}
-		else {
-			// copy the value into the quire
-			uint64_t mask = uint64_t(1);
-			for (unsigned i = 0; i < msb && i < half_range; i++) {
-				_upper[i] = rhs & mask;
-				mask <<= 1;
-			}
-			if (msb >= half_range) {
-				for (unsigned i = half_range, c = 0; i < msb && i < half_range + capacity; i++, c++) {
-					_capacity[c] = rhs & mask;
-					mask <<= 1;
-				}
-			}
-		}
+		load_integer(rhs);
 		return *this;
 	}
 	quire& operator=(float rhs) {
@@ -253,7 +207,7 @@ public:
 
 	// All values in (and out) of the quire are normalized (sign, scale, fraction) triplets.
 
-	// Add a normalized value to the quire value. 
+	// Add a normalized value to the quire value.
 	template<unsigned fbits>
 	quire& operator+=(const internal::value<fbits>& rhs) {
 		if (rhs.iszero()) return *this;
@@ -279,10 +233,7 @@ public:
 			// subtract magnitudes
 			int cmp = CompareMagnitude(rhs);
 			if (cmp < 0) {
-				// TODO: is there a way to NOT have to swap the whole quire?
-				internal::value<qbits> subtractend = this->to_value();
-				*this = rhs;
-				subtract_value(subtractend);
+				subtract_from_value(rhs);
 				_sign = rhs.sign();
 			}
 			else if (cmp > 0) {
@@ -301,7 +252,7 @@ public:
 	quire& operator-=(const internal::value<fbits>& rhs) {
 		return *this += -rhs;
 	}
-	
+
 	// add a posit directly (syntactic sugar)
 	quire& operator+=(const posit<nbits, es>& rhs) {
 		return operator+=(rhs.to_value());
@@ -313,18 +264,18 @@ public:
 
 	// add two quires
 	quire& operator+=(const quire& q) {
-		return operator+=(q.to_value());
+		accumulate(q, q._sign);
+		return *this;
 	}
 	// subtract two quires
 	quire& operator-=(const quire& q) {
-		return operator-=(q.to_value());
+		accumulate(q, !q._sign);
+		return *this;
 	}
-	
+
 	// bit addressing operator
 	bool operator[](int index) const {
-		if (index < int(radix_point)) return _lower[static_cast<unsigned>(index)];
-		if (index < int(radix_point + upper_range)) return _upper[static_cast<unsigned>(index) - radix_point];
-		if (index < int(radix_point + upper_range + capacity)) return _capacity[static_cast<unsigned>(index) - radix_point - upper_range];
+		if (index >= 0 && index <= int(qbits)) return at(static_cast<unsigned>(index));
 		throw "index out of range";
 	}
 
@@ -334,9 +285,7 @@ public:
 	// reset the state of a quire to zero
 	void reset() {
 		_sign = false;
-		_lower.reset();
-		_upper.reset();
-		_capacity.reset();
+		for (unsigned i = 0; i < nrLimbs; ++i) _accu[i] = 0;
 	}
 	// semantic sugar: clear the state of a quire to zero
 	void clear() { reset(); }
@@ -374,56 +323,46 @@ public:
 				if (msb_u != -1) return false; // fail, incorrect format
 				segment = 2;
 			}
-			else if (*it == '1') {
-				switch (segment) {
-				case 0:
-					_capacity.set(msb_c--);
-					break;
-				case 1:
-					_upper.set(msb_u--);
-					break;
-				case 2:
-					if (msb_l < 0) return false; // fail, incorrect format
-					_lower.set(msb_l--);
-					break;
-				default:
-					return false; // fail, incorrect state
-				}
-			}
 			else {
+				int bitIndex;
 				switch (segment) {
 				case 0:
-					_capacity.reset(msb_c--);
+					if (msb_c < 0) return false; // fail, incorrect format
+					bitIndex = int(radix_point + upper_range) + msb_c--;
 					break;
 				case 1:
-					_upper.reset(msb_u--);
+					if (msb_u < 0) return false; // fail, incorrect format
+					bitIndex = int(radix_point) + msb_u--;
 					break;
 				case 2:
 					if (msb_l < 0) return false; // fail, incorrect format
-					_lower.reset(msb_l--);
+					bitIndex = msb_l--;
 					break;
 				default:
 					return false; // fail, incorrect state
 				}
+				setbit(static_cast<unsigned>(bitIndex), *it == '1');
 			}
 		}
 		return true;
 	}
 
 // Selectors
-	
+
 	// Compare magnitudes between quire and value: returns -1 if q < v, 0 if q == v, and 1 if q > v
+	// fraction bits of v below the lsb of the quire do not participate, as they are truncated on accumulation
 	template<unsigned fbits>
-	int CompareMagnitude(const internal::value<fbits>& v) {
-		// inefficient as we are copying a whole quire just to reset the sign bit, but we are leveraging the comparison logic
-		quire<nbits, es, capacity> absq = abs(*this);
-		//value<qbits> absq = abs(*this);
-		internal::value<fbits> absv = abs(v);
-		if (absq < absv) {
-			return -1;
-		}
-		else if (absq > absv) {
-			return 1;
+	int CompareMagnitude(const internal::value<fbits>& v) const {
+		if (v.iszero()) return iszero() ? 0 : 1;
+		if (v.scale() > int(qbits - radix_point)) return -1;
+		if (v.scale() < -int(radix_point)) return iszero() ? -1 : 1;
+		constexpr unsigned nrSignificandLimbs = significand_limbs<fbits>();
+		std::uint64_t significand[nrSignificandLimbs];
+		load_significand(v, significand);
+		int lsb = int(radix_point) + v.scale() - int(fbits);
+		for (int i = int(MSU); i >= 0; --i) {
+			std::uint64_t operand = extract(significand, nrSignificandLimbs, i * int(bitsInLimb) - lsb);
+			if (_accu[i] != operand) return (_accu[i] < operand ? -1 : 1);
 		}
 		return 0;
 	}
@@ -435,84 +374,42 @@ public:
 	inline unsigned total_bits() const { return qbits + 1; }
 	inline bool isneg() const { return _sign; }
 	inline bool ispos() const { return _sign; }
-	inline bool iszero() const { return _capacity.none() && _upper.none() && _lower.none(); }
+	inline bool iszero() const {
+		for (unsigned i = 0; i < nrLimbs; ++i) if (_accu[i]) return false;
+		return true;
+	}
 	int scale() const {
-		int msb = int(capacity)-1; // indicative of no bits set
-		for (; msb >= 0; msb--) {
-			if (_capacity.test(static_cast<unsigned>(msb))) break;
-		}
-		if (msb >= 0) return msb + int(upper_range);
-		for (msb = int(upper_range) - 1; msb >= 0; msb--) {
-			if (_upper.test(static_cast<unsigned>(msb))) break;
+		for (int i = int(MSU); i >= 0; --i) {
+			if (_accu[i]) return i * int(bitsInLimb) + int(bitsInLimb) - 1 - std::countl_zero(_accu[i]) - int(radix_point);
 		}
-		if (msb >= 0) return msb;
-		for (int i = int(half_range) - 1; i >= 0; i--, msb--) {
-			if (_lower.test(static_cast<unsigned>(i))) break;
-		}
-		return msb;
+		return -1 - int(half_range); // indicative of no bits set
 	}
 
 	// Return value of the sign bit: true indicates a negative number, false a positive number or zero
 	inline bool sign() const { return _sign; }
 	inline float sign_value() const {	return (_sign ? -1.0 : 1.0); }
 	internal::bitblock<qbits+1> get() const {
-		internal::bitblock<qbits+1> q;
-		int msb = 0;
-		for (int i = 0; i < half_range; i++) {
-			q[msb] = _lower[i];
-			msb++;
-		}
-		for (int i = 0; i < upper_range; i++) {
-			q[msb] = _upper[i];
-			msb++;
-		}
-		for (int i = 0; i < capacity; i++) {
-			q[msb] = _capacity[i];
-			msb++;
+		internal::bitblock<qbits+1> q, limb;
+		for (unsigned i = 0; i < nrLimbs; ++i) {
+			limb = _accu[i];
+			q |= limb << (i * bitsInLimb);
 		}
 		return q;
 	}
 	internal::value<qbits> to_value() const {
 		// find the MSB and build the fraction
-		internal::bitblock<qbits> fraction;
-		bool isZero = false;
-		bool isNaR = false;   // TODO
-		int i;
-		int qbit = int(qbits);
-		int fbit = qbit - 1;
-		int scale = qbits;
-		for (i = int(capacity) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_capacity.test(static_cast<unsigned>(i))) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[static_cast<unsigned>(fbit)] = _capacity[static_cast<unsigned>(i)];
-				--fbit;
-			}
-		}
-		for (i = int(upper_range) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_upper.test(static_cast<unsigned>(i))) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[static_cast<unsigned>(fbit)] = _upper[static_cast<unsigned>(i)];
-				--fbit;
-			}
-		}
-		for (i = int(half_range) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_lower.test(static_cast<unsigned>(i))) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[static_cast<unsigned>(fbit)] = _lower[static_cast<unsigned>(i)];
-				--fbit;
-			}
-		}
-		if (scale == qbits) {
-			isZero = true;
-			scale = 0;
-		}
-		return internal::value<qbits>(_sign, scale, fraction, isZero, isNaR);
+		internal::bitblock<qbits> fraction, segment;
+		if (iszero()) return internal::value<qbits>(_sign, 0, fraction, true, false);
+		int scale = this->scale();
+		int msb = int(radix_point) + scale;
+		// the fraction are the qbits below the msb, aligned to the top of the fraction
+		for (unsigned f = 0; f < qbits; f += bitsInLimb) {
+			std::uint64_t bits = extract(_accu, nrLimbs, msb - int(qbits) + int(f));
+			if (qbits - f < bitsInLimb) bits &= (std::uint64_t(1) << (qbits - f)) - 1;  // remove the hidden bit
+			segment = bits;
+			fraction |= segment << f;
+		}
+		return internal::value<qbits>(_sign, scale, fraction, false, false);
 	}
 	template <typename ToValue>
 	ToValue convert_to() const {
@@ -520,245 +417,159 @@ public:
             convert(to_value(), v);
             return v;
         }
+	// any bit set in [0, index]
 	bool anyAfter(int index) const {
-		for (int i = index; i >= 0; i--) {
-			if (this->operator[](i)) return true;
-		}
-		return false;
+		if (index < 0) return false;
+		unsigned msb = (index > int(qbits)) ? qbits : static_cast<unsigned>(index);
+		unsigned limb = msb / bitsInLimb;
+		for (unsigned i = 0; i < limb; ++i) if (_accu[i]) return true;
+		unsigned shift = bitsInLimb - 1 - msb % bitsInLimb;
+		return (_accu[limb] << shift) != 0;
 	}
 
 private:
 	bool				   _sign;
-	// segmented accumulator to demonstrate potential hw concurrency for high performance quires
-	bitblock<half_range>   _lower;
-	bitblock<upper_range>  _upper;
-	bitblock<capacity>     _capacity;
+	// contiguous limbs: lower accumulator, upper accumulator, and capacity segment
+	std::uint64_t          _accu[nrLimbs];
+
+	bool at(unsigned bitIndex) const {
+		return (_accu[bitIndex / bitsInLimb] >> (bitIndex % bitsInLimb)) & 0x1;
+	}
+	void setbit(unsigned bitIndex, bool v = true) {
+		std::uint64_t mask = std::uint64_t(1) << (bitIndex % bitsInLimb);
+		if (v) _accu[bitIndex / bitsInLimb] |= mask; else _accu[bitIndex / bitsInLimb] &= ~mask;
+	}
+
+	// 64 bits of the limbs a[0, n) starting at bit position pos, which can be negative
+	static constexpr std::uint64_t extract(const std::uint64_t* a, unsigned n, int pos) noexcept {
+		if (pos <= -int(bitsInLimb) || pos >= int(n * bitsInLimb)) return 0;
+		if (pos < 0) return a[0] << -pos;
+		unsigned limb = static_cast<unsigned>(pos) / bitsInLimb;
+		unsigned shift = static_cast<unsigned>(pos) % bitsInLimb;
+		std::uint64_t bits = a[limb] >> shift;
+		if (shift > 0 && limb + 1 < n) bits |= a[limb + 1] << (bitsInLimb - shift);
+		return bits;
+	}
 
-	// add a value to the quire
 	template<unsigned fbits>
-	void add_value(const internal::value<fbits>& v) {
-		if (v.iszero()) return;
-		// scale is the location of the msb in the fixed point representation
-		// so scale  =  0 is the hidden bit at location 0, scale 1 = bit 1, etc.
-		// and scale = -1 is the first bit of the fraction
-		// we manage scale >= 0 in the _upper accumulator, and scale < 0 in the _lower accumulator
-		int lsb = v.scale() - static_cast<int>(fbits);
-		bool carry = false;
-		bitblock<fbits + 1> fraction = v.get_fixed_point();
-		int i, f;  // bit pointers, i pointing to the quire bits, f pointing to the fraction bits of rhs
-		// divide bits between upper and lower accumulator
-		if (v.scale() < 0) {		// all lower accumulator
-			lsb = int(half_range) + v.scale() - int(fbits); /// TODO: double check this fix works
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _lower[static_cast<unsigned>(i)];
-				bool _b = fraction[static_cast<unsigned>(f)];
-				_lower[static_cast<unsigned>(i)] = _a ^ _b ^ carry;
-				carry = (_a && _b) || (carry && (_a ^ _b));
-			}
-			// propagate any carries to the end of the lower accumulator
-			while (carry && i < int(half_range)) {
-				bool _a = _lower[static_cast<unsigned>(i)];
-				_lower[static_cast<unsigned>(i)] = _a ^ carry;
-				carry = carry && _a;
-				i++;
-			}
-			if (carry) {  // carry propagate to the _upper accumulator
-						  // need to increment the _upper
-				i = 0;
-				while (carry && i < int(upper_range)) {
-					bool _a = _upper[static_cast<unsigned>(i)];
-					_upper[static_cast<unsigned>(i)] = _a ^ carry;
-					carry = carry && _a;
-					i++;
-				}
-				if (carry) {
-					// next add the bits to the capacity segment
-					i = 0;
-					while (carry && i < int(capacity)) {
-						bool _a = _capacity[static_cast<unsigned>(i)];
-						_capacity[static_cast<unsigned>(i)] = _a ^ carry;
-						carry = carry && _a;
-						i++;
-					}
-				}
-			}
+	static constexpr unsigned significand_limbs() { return (fbits + 1 + bitsInLimb - 1) / bitsInLimb; }
+
+	// gather the fixed-point significand 1.fraction of v into limbs
+	template<unsigned fbits>
+	static void load_significand(const internal::value<fbits>& v, std::uint64_t* significand) {
+		constexpr unsigned nrSignificandLimbs = significand_limbs<fbits>();
+		for (unsigned i = 0; i < nrSignificandLimbs; ++i) significand[i] = 0;
+		if constexpr (fbits <= bitsInLimb) {
+			significand[0] = v.fraction().to_ullong();
 		}
-		else if (lsb >= 0) {	// all upper accumulator
-			int upper_bound = v.scale();
-			for (i = lsb, f = 0; i <= upper_bound && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _upper[static_cast<unsigned>(i)];
-				bool _b = fraction[static_cast<unsigned>(f)];
-				_upper[static_cast<unsigned>(i)] = _a ^ _b ^ carry;
-				carry = (_a && _b) || (carry && (_a ^ _b));
-			}
-			while (carry && i < int(upper_range)) {
-				bool _a = _upper[static_cast<unsigned>(i)];
-				_upper[static_cast<unsigned>(i)] = _a ^ carry;
-				carry = carry && _a;
-				i++;
-			}
-			if (carry) {
-				// next add the bits to the capacity segment
-				i = 0;
-				while (carry && i < int(capacity)) {
-					bool _a = _capacity[static_cast<unsigned>(i)];
-					_capacity[static_cast<unsigned>(i)] = _a ^ carry;
-					carry = carry && _a;
-					i++;
-				}
+		else {
+			const internal::bitblock<fbits> fraction = v.fraction();
+			for (unsigned i = 0; i * bitsInLimb < fbits; ++i) {
+				significand[i] = fraction.block(i);
 			}
 		}
-		else {  // lsb < 0 && scale > 0
-				// part upper, and part lower accumulator
-				// first add the lower accumulator component
-			lsb = int(half_range) + lsb; // remember lsb is negative in this block
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _lower[static_cast<unsigned>(i)];
-				bool _b = fraction[static_cast<unsigned>(f)];
-				_lower[static_cast<unsigned>(i)] = _a ^ _b ^ carry;
-				carry = (_a && _b) || (carry && (_a ^ _b));
-			}
-			// next add the bits in the upper accumulator
-			for (i = 0; i <= v.scale() && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _upper[static_cast<unsigned>(i)];
-				bool _b = fraction[static_cast<unsigned>(f)];
-				_upper[static_cast<unsigned>(i)] = _a ^ _b ^ carry;
-				carry = (_a && _b) || (carry && (_a ^ _b));
-			}
-			// propagate any carries to the end of the upper accumulator
-			while (carry && i < int(upper_range)) {
-				bool _a = _upper[static_cast<unsigned>(i)];
-				_upper[static_cast<unsigned>(i)] = _a ^ carry;
-				carry = carry && _a;
-				i++;
-			}
-			// next add the bits to the capacity segment
-			if (carry) {
-				i = 0;
-				while (carry && i < int(capacity)) {
-					bool _a = _capacity[static_cast<unsigned>(i)];
-					_capacity[static_cast<unsigned>(i)] = _a ^ carry;
-					carry = carry && _a;
-					i++;
-				}
-			}
+		significand[fbits / bitsInLimb] |= std::uint64_t(1) << (fbits % bitsInLimb);  // hidden bit
+	}
+
+	// place an integer magnitude at the radix point
+	void load_integer(std::uint64_t magnitude) {
+		unsigned msb = find_msb(magnitude);
+		if (msb > half_range + capacity) {
+			throw operand_too_large_for_quire{};
 		}
+		unsigned limb = radix_point / bitsInLimb;
+		unsigned shift = radix_point % bitsInLimb;
+		_accu[limb] = magnitude << shift;
+		if (shift > 0 && limb < MSU) _accu[limb + 1] = magnitude >> (bitsInLimb - shift);
 	}
 
-	// subtract a value from the quire
+	// add the magnitude of a value to the quire
+	// the significand only touches the limbs it overlaps, after which the carry ripples up
+	// bits below the lsb of the quire are truncated, and a carry out of the capacity segment wraps
+	template<unsigned fbits>
+	void add_value(const internal::value<fbits>& v) {
+		if (v.iszero()) return;
+		constexpr unsigned nrSignificandLimbs = significand_limbs<fbits>();
+		std::uint64_t significand[nrSignificandLimbs];
+		load_significand(v, significand);
+		// lsb in the quire of the lowest bit of the fixed point value including the hidden bit of the fraction
+		int lsb = int(radix_point) + v.scale() - int(fbits);
+		unsigned first = (lsb < 0) ? 0u : static_cast<unsigned>(lsb) / bitsInLimb;
+		unsigned last = static_cast<unsigned>(lsb + int(fbits)) / bitsInLimb;
+		if (last > MSU) last = MSU;
+		bool carry{ false };
+		unsigned i = first;
+		for (; i <= last; ++i) {
+			_accu[i] = addcarry(_accu[i], extract(significand, nrSignificandLimbs, int(i * bitsInLimb) - lsb), carry);
+		}
+		for (; carry && i < nrLimbs; ++i) {
+			_accu[i] = addcarry(_accu[i], std::uint64_t(0), carry);
+		}
+		_accu[MSU] &= MSU_MASK;
+	}
+
+	// subtract the magnitude of a value from the quire: requires |q| >= |v|
 	template<unsigned fbits>
 	void subtract_value(const internal::value<fbits>& v) {
 		if (v.iszero()) return;
-		// lsb in the quire of the lowest bit of the explicit fixed point value including the hidden bit of the fraction
-		int lsb = v.scale() - static_cast<int>(fbits);
-		bool borrow = false;
-		bitblock<fbits + 1> fraction = v.get_fixed_point();
-		int i, f;  // bit pointers, i pointing to the quire bits, f pointing to the fraction bits of rhs
-		// divide bits between upper and lower accumulator
-		if (v.scale() < 0) {		// all lower accumulator
-			lsb = int(half_range) + v.scale() - static_cast<int>(fbits);
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _lower[unsigned(i)];
-				bool _b = fraction[unsigned(f)];
-				_lower[unsigned(i)] = _a ^ _b ^ borrow;
-				borrow = (!_a && _b) || (bxnor(!_a, !_b) && borrow);
-			}
-			// propagate any borrows to the end of the lower accumulator
-			while (borrow && i < int(half_range)) {
-				bool _a = _lower[unsigned(i)];
-				_lower[unsigned(i)] = _a ^ borrow;
-				borrow = borrow && !_a;
-				i++;
-			}
-			if (borrow) { // borrow propagate to the _upper accumulator
-						  // need to decrement the _upper
-				i = 0;
-				while (borrow && i < int(upper_range)) {
-					bool _a = _upper[unsigned(i)];
-					_upper[unsigned(i)] = _a ^ borrow;
-					borrow = borrow && !_a;
-					i++;
-				}
-				if (borrow) {
-					// propagate the borrow into the capacity segment
-					i = 0;
-					while (borrow && i < int(capacity)) {
-						bool _a = _capacity[unsigned(i)];
-						_capacity[unsigned(i)] = _a ^ borrow;
-						borrow = borrow && !_a;
-						i++;
-					}
-				}
-			}
+		constexpr unsigned nrSignificandLimbs = significand_limbs<fbits>();
+		std::uint64_t significand[nrSignificandLimbs];
+		load_significand(v, significand);
+		int lsb = int(radix_point) + v.scale() - int(fbits);
+		unsigned first = (lsb < 0) ? 0u : static_cast<unsigned>(lsb) / bitsInLimb;
+		unsigned last = static_cast<unsigned>(lsb + int(fbits)) / bitsInLimb;
+		if (last > MSU) last = MSU;
+		bool borrow{ false };
+		unsigned i = first;
+		for (; i <= last; ++i) {
+			_accu[i] = subborrow(_accu[i], extract(significand, nrSignificandLimbs, int(i * bitsInLimb) - lsb), borrow);
 		}
-		else if (lsb >= 0) {	// all upper accumulator
-			int upper_bound = v.scale();
-			for (i = lsb, f = 0; i <= upper_bound && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _upper[unsigned(i)];
-				bool _b = fraction[unsigned(f)];
-				_upper[unsigned(i)] = _a ^ _b ^ borrow;
-				borrow = (!_a && _b) || (bxnor(!_a, !_b) && borrow);
-			}
-			// propagate any borrows to the end of the upper accumulator
-			while (borrow && i < int(upper_range)) {
-				bool _a = _upper[unsigned(i)];
-				_upper[unsigned(i)] = _a ^ borrow;
-				borrow = borrow && !_a;
-				i++;
-			}
-			if (borrow) {
-				// propagate the borrow into the capacity segment
-				i = 0;
-				while (borrow && i < int(capacity)) {
-					bool _a = _capacity[unsigned(i)];
-					_capacity[unsigned(i)] = _a ^ borrow;
-					borrow = borrow && !_a;
-					i++;
-				}
-			}
+		for (; borrow && i < nrLimbs; ++i) {
+			_accu[i] = subborrow(_accu[i], std::uint64_t(0), borrow);
 		}
-		else {   // lsb < 0 && scale >= 0
-				 // part upper, and part lower accumulator
-				 // first add the lower accumulator component
-			lsb = int(half_range) + lsb; // remember lsb is negative in this block
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _lower[unsigned(i)];
-				bool _b = fraction[unsigned(f)];
-				_lower[unsigned(i)] = _a ^ _b ^ borrow;
-				borrow = (!_a && _b) || (bxnor(!_a, !_b) && borrow);
-			}
-			// next add the bits in the upper accumulator
-			for (i = 0; i <= v.scale() && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _upper[unsigned(i)];
-				bool _b = fraction[unsigned(f)];
-				_upper[unsigned(i)] = _a ^ _b ^ borrow;
-				borrow = (!_a && _b) || (bxnor(!_a, !_b) && borrow);
-			}
-			// propagate any borrows to the end of the upper accumulator
-			while (borrow && i < int(upper_range)) {
-				bool _a = _upper[unsigned(i)];
-				_upper[unsigned(i)] = _a ^ borrow;
-				borrow = borrow && !_a;
-				i++;
-			}
-			if (borrow) {
-				// propagate the borrow into the capacity segment
-				i = 0;
-				while (borrow && i < int(capacity)) {
-					bool _a = _capacity[unsigned(i)];
-					_capacity[unsigned(i)] = _a ^ borrow;
-					borrow = borrow && !_a;
-					i++;
-				}
-			}
+		_accu[MSU] &= MSU_MASK;
+	}
+
+	// replace the quire magnitude with |v| - |q|: requires |q| < |v|
+	template<unsigned fbits>
+	void subtract_from_value(const internal::value<fbits>& v) {
+		constexpr unsigned nrSignificandLimbs = significand_limbs<fbits>();
+		std::uint64_t significand[nrSignificandLimbs];
+		load_significand(v, significand);
+		int lsb = int(radix_point) + v.scale() - int(fbits);
+		bool borrow{ false };
+		for (unsigned i = 0; i < nrLimbs; ++i) {
+			_accu[i] = subborrow(extract(significand, nrSignificandLimbs, int(i * bitsInLimb) - lsb), _accu[i], borrow);
+		}
+		_accu[MSU] &= MSU_MASK;
+	}
+
+	// returns -1 if |a| < |b|, 0 if |a| == |b|, and 1 if |a| > |b|
+	static int compare_magnitude(const quire& a, const quire& b) {
+		for (int i = int(MSU); i >= 0; --i) {
+			if (a._accu[i] != b._accu[i]) return (a._accu[i] < b._accu[i] ? -1 : 1);
+		}
+		return 0;
+	}
+
+	// add the magnitude of q to the quire with the sign rhsSign
+	void accumulate(const quire& q, bool rhsSign) {
+		if (q.iszero()) return;
+		if (_sign == rhsSign) {
+			bool carry{ false };
+			for (unsigned i = 0; i < nrLimbs; ++i) _accu[i] = addcarry(_accu[i], q._accu[i], carry);
+			_accu[MSU] &= MSU_MASK;
+			return;
+		}
+		int cmp = compare_magnitude(*this, q);
+		bool borrow{ false };
+		if (cmp < 0) {
+			for (unsigned i = 0; i < nrLimbs; ++i) _accu[i] = subborrow(q._accu[i], _accu[i], borrow);
+			_sign = rhsSign;
+		}
+		else {
+			for (unsigned i = 0; i < nrLimbs; ++i) _accu[i] = subborrow(_accu[i], q._accu[i], borrow);
+			if (cmp == 0) _sign = false;
 		}
 	}
 
@@ -820,7 +631,15 @@ inline quire<nbits, es, capacity> operator+(const quire<nbits, es, capacity>& lh
 ////////////////// QUIRE stream operators
 template<unsigned nbits, unsigned es, unsigned capacity>
 inline std::ostream& operator<<(std::ostream& ostr, const quire<nbits, es, capacity>& q) {
-	ostr << (q._sign ? "-:" : "+:") << q._capacity << "_" << q._upper << "." << q._lower;
+	using Quire = quire<nbits, es, capacity>;
+	std::string s(q._sign ? "-:" : "+:");
+	s.reserve(Quire::qbits + 5);
+	for (int i = int(Quire::qbits); i >= int(Quire::radix_point + Quire::upper_range); --i) s += (q.at(unsigned(i)) ? '1' : '0');
+	s += '_';
+	for (int i = int(Quire::radix_point + Quire::upper_range) - 1; i >= int(Quire::radix_point); --i) s += (q.at(unsigned(i)) ? '1' : '0');
+	s += '.';
+	for (int i = int(Quire::radix_point) - 1; i >= 0; --i) s += (q.at(unsigned(i)) ? '1' : '0');
+	ostr << s;
 	return ostr;
 }
 
@@ -831,25 +650,17 @@ inline std::istream& operator>> (std::istream& istr, const quire<nbits, es, capa
 }
 
 template<unsigned nbits, unsigned es, unsigned capacity>
-inline bool operator==(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return lhs._sign == rhs._sign && lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower == rhs._lower; }
+inline bool operator==(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return lhs._sign == rhs._sign && quire<nbits, es, capacity>::compare_magnitude(lhs, rhs) == 0; }
 template<unsigned nbits, unsigned es, unsigned capacity>
 inline bool operator!=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator==(lhs, rhs); }
 template<unsigned nbits, unsigned es, unsigned capacity>
-inline bool operator< (const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { 
+inline bool operator< (const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) {
 	bool bSmaller = false;
 	if (!lhs._sign && rhs._sign) {
 		bSmaller = true;
 	}
 	else if (lhs._sign == rhs._sign) {
-		if (lhs._capacity < rhs._capacity) {
-			bSmaller = true;
-		}
-		else if (lhs._capacity == rhs._capacity && lhs._upper < rhs._upper) {
-			bSmaller = true;
-		}
-		else if (lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower < rhs._lower) {
-			bSmaller = true;
-		}
+		bSmaller = quire<nbits, es, capacity>::compare_magnitude(lhs, rhs) < 0;
 	}
 	return bSmaller;
 }
@@ -873,36 +684,7 @@ inline bool operator< (const quire<nbits, es, capacity>& q, const internal::valu
 		bSmaller = true;
 	}
 	else if (q.sign() == v.sign()) {
-		// compare magnitudes
-		int qscale = q.scale();
-		int vscale = v.scale();
-		if (qscale < vscale) {
-			bSmaller = true;
-		}
-		else if (qscale == vscale) {
-			// got to compare the fraction bits
-			bitblock<fbits + 1> fixed = v.get_fixed_point();
-			int i, f;  // bit pointers, i for the quire, f for the fraction in v
-			bool undecided = true;
-			for (i = int(quire<nbits, es, capacity>::radix_point) + qscale, f = int(fbits); i >= 0 && f >= 0; --i, --f) {
-				if (!q[i] && fixed[static_cast<unsigned>(f)]) {
-					bSmaller = true;
-					undecided = false;
-					break;
-				}
-				else if (q[i] && !fixed[static_cast<unsigned>(f)]) {
-					bSmaller = false;
-					undecided = false;
-					break;
-				}
-			}
-			if (undecided && i >= 0) { // fraction bits have been identical
-				// any bit set will make the quire bigger than the value
-				if (q.anyAfter(i)) {
-					bSmaller = false;
-				}
-			}
-		}
+		bSmaller = q.CompareMagnitude(v) < 0;
 	}
 	return bSmaller;
 }
@@ -913,37 +695,14 @@ inline bool operator> (const quire<nbits, es, capacity>& q, const internal::valu
 		bBigger = true;
 	}
 	else if (q.sign() == v.sign()) {
-		// compare magnitudes
-		int qscale = q.scale();
-		int vscale = v.scale();
-		if (qscale > vscale) {
-			bBigger = true;
-		}
-		else if (qscale == vscale) {
-			// got to compare the fraction bits
-			bitblock<fbits + 1> fixed_point = v.get_fixed_point();
-			int i, f;  // bit pointers, i for the quire, f for the fraction in v
-			bool undecided = true;
-			for (i = int(quire<nbits, es, capacity>::radix_point) + qscale, f = int(fbits); i >= 0 && f >= 0; --i, --f) {
-				if (q[i] && !fixed_point[static_cast<unsigned>(f)]) {
-					bBigger = true;
-					undecided = false;
-					break;
-				}
-			}
-			if (undecided && i >= 0) { // fraction bits have been identical
-									   // any bit set will make the quire bigger
-				if (q.anyAfter(i)) {
-					bBigger = true;
-				}
-			}
-		}
+		bBigger = q.CompareMagnitude(v) > 0;
 	}
 	return bBigger;
 }
 
 
 
+
 // QUIRE OPERATORS
 
 // unrounded posit addition to be added to the quire
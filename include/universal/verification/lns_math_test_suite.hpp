@@ -172,6 +172,15 @@ int VerifyExp2(bool reportTestCases) {
 					firstSofteningNanEvent = false;
 				}
 			}
+			else if (da * TestType::scaling - std::floor(da * TestType::scaling) == 0.5 && std::abs(double(result)) < std::abs(dref)) {
+				// the exponent of 2^a is a tie: the geometric midpoint is closer to the smaller neighbor,
+				// while the reference rounds the logarithm of a libm result on either side of the tie
+				static bool firstTieEvent = true;
+				if (firstTieEvent && reportTestCases) {
+					std::cerr << "filtering ties in the logarithm\n";
+					firstTieEvent = false;
+				}
+			}
 			else {
 				nrOfFailedTests++;
 				if (reportTestCases)	ReportOneInputFunctionError("FAIL", "exp2", a, result, ref);
@@ -184,6 +193,42 @@ int VerifyExp2(bool reportTestCases) {
 	return nrOfFailedTests;
 }
 
+// enumerate all square root cases for the non-negative values of an lns configuration
+template<typename TestType>
+int VerifySqrt(bool reportTestCases) {
+	constexpr unsigned nbits = TestType::nbits;
+	constexpr unsigned NR_TEST_CASES = (1 << (nbits - 1));
+	int nrOfFailedTests = 0;
+	TestType a, result, ref;
+
+	for (unsigned i = 0; i < NR_TEST_CASES; ++i) {
+		a.setbits(i);
+		result = sw::universal::sqrt(a);
+		// generate reference
+		double da = double(a);
+		ref = std::sqrt(da);
+		if (result != ref) {
+			if (!a.iszero() && (a.exponent_bits() & 1) && result.exponent_bits() == (a.exponent_bits() >> 1)) {
+				// half of an odd exponent is a tie: the geometric midpoint is closer to the smaller neighbor,
+				// while the reference rounds the logarithm of a libm result on either side of the tie
+				static bool firstTieEvent = true;
+				if (firstTieEvent && reportTestCases) {
+					std::cerr << "filtering ties in the logarithm\n";
+					firstTieEvent = false;
+				}
+			}
+			else {
+				nrOfFailedTests++;
+				if (reportTestCases)	ReportOneInputFunctionError("FAIL", "sqrt", a, result, ref);
+			}
+		}
+		else {
+			//if (reportTestCases) ReportOneInputFunctionSuccess("aSS", "sqrt", a, result, ref);
+		}
+	}
+	return nrOfFailedTests;
+}
+
 // enumerate all power method cases for an lns configuration
 template<typename TestType>
 int VerifyPowerFunction(bool reportTestCases, unsigned int maxSamples = 10000) {
@@ -0,0 +1,176 @@
+// storage.cpp : test suite for the right-sized storage of bitblocks
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <bitset>
+#include <random>
+#include <universal/internal/bitblock/bitblock.hpp>
+#include <universal/verification/test_status.hpp>
+#include <universal/verification/test_reporters.hpp>
+
+namespace sw { namespace universal {
+
+	// a bitblock is stored in the smallest native unsigned integer that holds nbits, and in 64-bit limbs beyond
+	int VerifyStorageSize(bool reportTestCases) {
+		using namespace sw::universal::internal;
+		int nrOfFailedTestCases = 0;
+		auto check = [&](std::size_t size, std::size_t expected, unsigned nbits) {
+			if (size != expected) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: sizeof(bitblock<" << nbits << ">) = " << size << " expected " << expected << '\n';
+			}
+		};
+		check(sizeof(bitblock<  1>),  1,   1);
+		check(sizeof(bitblock<  8>),  1,   8);
+		check(sizeof(bitblock< 12>),  2,  12);
+		check(sizeof(bitblock< 16>),  2,  16);
+		check(sizeof(bitblock< 24>),  4,  24);
+		check(sizeof(bitblock< 32>),  4,  32);
+		check(sizeof(bitblock< 40>),  8,  40);
+		check(sizeof(bitblock< 64>),  8,  64);
+		check(sizeof(bitblock< 80>), 16,  80);
+		check(sizeof(bitblock<128>), 16, 128);
+		check(sizeof(bitblock<130>), 24, 130);
+		return nrOfFailedTestCases;
+	}
+
+	template<unsigned nbits>
+	internal::bitblock<nbits> to_bitblock(const std::bitset<nbits>& bs) {
+		internal::bitblock<nbits> bb;
+		for (unsigned i = 0; i < nbits; ++i) bb[i] = bs[i];
+		return bb;
+	}
+
+	// compare the logic, shift, and increment operators of a bitblock to those of a std::bitset on random bit patterns
+	template<unsigned nbits>
+	int VerifyOperatorsAgainstBitset(bool reportTestCases, unsigned nrRandoms) {
+		using namespace sw::universal::internal;
+		std::mt19937_64 generator(nbits);
+		int nrOfFailedTestCases = 0;
+		auto report = [&](const char* op, const bitblock<nbits>& result, const std::bitset<nbits>& ref) {
+			if (result.to_string() != ref.to_string()) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: bitblock<" << nbits << "> " << op << " : " << result << " != " << ref << '\n';
+			}
+		};
+		for (unsigned t = 0; t < nrRandoms; ++t) {
+			std::bitset<nbits> ra, rb;
+			for (unsigned i = 0; i < nbits; ++i) {
+				ra[i] = (generator() & 1u) != 0;
+				rb[i] = (generator() & 1u) != 0;
+			}
+			if (t == 1) ra.set();    // the carry and borrow cases of increment and decrement
+			if (t == 2) ra.reset();
+			bitblock<nbits> a = to_bitblock<nbits>(ra), b = to_bitblock<nbits>(rb);
+			report("&", a & b, ra & rb);
+			report("|", a | b, ra | rb);
+			report("^", a ^ b, ra ^ rb);
+			report("~", ~a, ~ra);
+			for (unsigned shift = 0; shift <= nbits + 1; ++shift) {
+				report("<<", a << shift, ra << shift);
+				report(">>", a >> shift, ra >> shift);
+			}
+			if (a.count() != ra.count() || a.any() != ra.any() || a.all() != ra.all()) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: bitblock<" << nbits << "> count/any/all of " << a << '\n';
+			}
+			if ((a == b) != (ra == rb) || (a < b) != (ra.to_string() < rb.to_string())) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: bitblock<" << nbits << "> comparison of " << a << " and " << b << '\n';
+			}
+
+			// increment and decrement against the ripple carry on the bitset
+			std::bitset<nbits> rinc(ra), rdec(ra);
+			bool carry = true, borrow = true;
+			for (unsigned i = 0; i < nbits && carry; ++i) { carry = rinc[i]; rinc.flip(i); }
+			for (unsigned i = 0; i < nbits && borrow; ++i) { borrow = !rdec[i]; rdec.flip(i); }
+			bitblock<nbits> inc(a), dec(a);
+			if (increment_bitset(inc) != carry || decrement_bitset(dec) != borrow) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: bitblock<" << nbits << "> carry/borrow of " << a << '\n';
+			}
+			report("++", inc, rinc);
+			report("--", dec, rdec);
+		}
+		return nrOfFailedTestCases;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "bitblock storage verification";
+	std::string test_tag    = "storage";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyOperatorsAgainstBitset<130>(reportTestCases, 10), "bitblock<130>", test_tag);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyStorageSize(reportTestCases), "sizeof", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyOperatorsAgainstBitset<  5>(reportTestCases, 100), "bitblock<5>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyOperatorsAgainstBitset<  8>(reportTestCases, 100), "bitblock<8>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyOperatorsAgainstBitset< 12>(reportTestCases, 100), "bitblock<12>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyOperatorsAgainstBitset< 32>(reportTestCases, 100), "bitblock<32>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyOperatorsAgainstBitset< 33>(reportTestCases, 100), "bitblock<33>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyOperatorsAgainstBitset< 64>(reportTestCases, 100), "bitblock<64>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyOperatorsAgainstBitset< 65>(reportTestCases, 100), "bitblock<65>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyOperatorsAgainstBitset<128>(reportTestCases, 100), "bitblock<128>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyOperatorsAgainstBitset<130>(reportTestCases, 100), "bitblock<130>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyOperatorsAgainstBitset<200>(reportTestCases, 1000), "bitblock<200>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
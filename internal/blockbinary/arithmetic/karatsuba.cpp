@@ -0,0 +1,169 @@
+// karatsuba.cpp: functional tests for the Karatsuba multiplication kernels used by blockbinary and integer
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <universal/utility/long_double.hpp>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <typeinfo>
+#include <vector>
+
+#include <universal/internal/blockbinary/blockbinary.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	template<typename Limb>
+	void randomize(std::vector<Limb>& v, std::mt19937_64& generator, unsigned pattern) {
+		for (auto& limb : v) {
+			switch (pattern % 3) {
+			case 0: limb = static_cast<Limb>(generator()); break;
+			case 1: limb = static_cast<Limb>(~Limb(0)); break;   // all ones stresses the carry and borrow chains
+			case 2: limb = static_cast<Limb>((generator() & 0x3) ? 0 : generator()); break; // sparse
+			}
+		}
+	}
+
+	// compare the Karatsuba kernels with a low threshold against the schoolbook kernels
+	template<typename Limb, unsigned threshold>
+	int VerifyKaratsubaKernels(unsigned maxLimbs, bool reportTestCases) {
+		std::mt19937_64 generator(maxLimbs);
+		int nrOfFailedTests = 0;
+		for (unsigned n = 1; n <= maxLimbs; ++n) {
+			for (unsigned pattern = 0; pattern < 6; ++pattern) {
+				std::vector<Limb> a(n), b(n), ref(2 * n), full(2 * n), reflo(n), lo(n);
+				randomize(a, generator, pattern);
+				randomize(b, generator, pattern / 3 + pattern);
+				std::vector<Limb> scratch(karatsuba_scratch_size<threshold>(n) + 1);
+				std::vector<Limb> loscratch(mullo_scratch_size<threshold>(n) + 1);
+				limb_mul_schoolbook(a.data(), n, b.data(), n, ref.data());
+				limb_mul_karatsuba<threshold>(a.data(), b.data(), n, full.data(), scratch.data());
+				limb_mullo_schoolbook(a.data(), b.data(), n, reflo.data());
+				limb_mullo<threshold>(a.data(), b.data(), n, lo.data(), loscratch.data());
+				if (full != ref) {
+					++nrOfFailedTests;
+					if (reportTestCases) std::cerr << "FAIL: full product of " << n << " limbs of " << typeid(Limb).name() << '\n';
+				}
+				if (lo != reflo) {
+					++nrOfFailedTests;
+					if (reportTestCases) std::cerr << "FAIL: truncated product of " << n << " limbs of " << typeid(Limb).name() << '\n';
+				}
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// compare the blockbinary modular product against the product of its 2's complement magnitudes
+	template<unsigned nbits, typename BlockType>
+	int VerifyWideMultiplication(unsigned nrRandoms, bool reportTestCases) {
+		using BlockBinary = blockbinary<nbits, BlockType>;
+		std::mt19937_64 generator(nbits);
+		int nrOfFailedTests = 0;
+		for (unsigned t = 0; t < nrRandoms; ++t) {
+			BlockBinary a, b;
+			for (unsigned i = 0; i < a.nrBlocks; ++i) {
+				a.setblock(i, static_cast<BlockType>(generator()));
+				b.setblock(i, static_cast<BlockType>(generator()));
+			}
+			a.setblock(a.MSU, static_cast<BlockType>(a.block(a.MSU) & a.MSU_MASK));
+			b.setblock(b.MSU, static_cast<BlockType>(b.block(b.MSU) & b.MSU_MASK));
+			BlockBinary c = a * b;
+
+			// reference: (-a) * (-b) == a * b, and a * (-b) == -(a * b) in modular arithmetic
+			BlockBinary na(-a), nb(-b);
+			BlockBinary c1 = na * nb;
+			BlockBinary c2 = -(a * nb);
+			// reference: shift and add on the bits of b
+			BlockBinary c3(0), multiplicant(a);
+			for (unsigned i = 0; i < nbits; ++i) {
+				if (b.test(i)) c3 += multiplicant;
+				multiplicant <<= 1;
+			}
+			if (c != c1 || c != c2 || c != c3) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << to_hex(a) << " * " << to_hex(b) << " = " << to_hex(c) << " reference " << to_hex(c3) << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "Karatsuba multiplication kernel validation";
+	std::string test_tag    = "karatsuba";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	std::cout << test_suite << '\n';
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyKaratsubaKernels<uint32_t, 4>(20, reportTestCases), "uint32_t limbs, threshold 4", test_tag);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyKaratsubaKernels<uint8_t, 4>(64, reportTestCases), "uint8_t  limbs, threshold 4", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyKaratsubaKernels<uint32_t, 4>(64, reportTestCases), "uint32_t limbs, threshold 4", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyKaratsubaKernels<uint64_t, 4>(64, reportTestCases), "uint64_t limbs, threshold 4", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyKaratsubaKernels<uint32_t, LIMB_KARATSUBA_THRESHOLD>(limb_mullo_threshold<> + LIMB_KARATSUBA_THRESHOLD, reportTestCases), "uint32_t limbs, default threshold", test_tag);
+
+	nrOfFailedTestCases += ReportTestResult(VerifyWideMultiplication<1024, uint32_t>(20, reportTestCases), "blockbinary<1024,uint32_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyWideMultiplication<2048, uint32_t>(10, reportTestCases), "blockbinary<2048,uint32_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyWideMultiplication<2500, uint64_t>(10, reportTestCases), "blockbinary<2500,uint64_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyWideMultiplication<4096, uint32_t>(5, reportTestCases), "blockbinary<4096,uint32_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyKaratsubaKernels<uint16_t, 5>(128, reportTestCases), "uint16_t limbs, threshold 5", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyWideMultiplication<8192, uint64_t>(5, reportTestCases), "blockbinary<8192,uint64_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyKaratsubaKernels<uint64_t, 8>(256, reportTestCases), "uint64_t limbs, threshold 8", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,206 @@
+// limbs.cpp: functional tests for multi-limb blockbinary arithmetic with uint64_t limbs
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <universal/utility/long_double.hpp>
+#include <iostream>
+#include <iomanip>
+#include <random>
+
+#include <universal/internal/blockbinary/blockbinary.hpp>
+#include <universal/verification/test_suite.hpp>
+#include <universal/verification/blockbinary_test_status.hpp>
+
+// the uint32_t limb configuration is the reference: the uint64_t limb configuration must produce identical bits
+namespace sw { namespace universal {
+
+	// copy the bits of one blockbinary into a blockbinary with a different BlockType
+	template<unsigned nbits, typename TargetBlockType, typename SourceBlockType, BinaryNumberType NumberType>
+	blockbinary<nbits, TargetBlockType, NumberType> convert_limbs(const blockbinary<nbits, SourceBlockType, NumberType>& src) {
+		blockbinary<nbits, TargetBlockType, NumberType> tgt;
+		tgt.clear();
+		for (unsigned i = 0; i < nbits; ++i) {
+			tgt.setbit(i, src.test(i));
+		}
+		return tgt;
+	}
+
+	template<unsigned nbits, typename BlockType, BinaryNumberType NumberType>
+	void randomize(blockbinary<nbits, BlockType, NumberType>& v, std::mt19937_64& generator) {
+		v.clear();
+		for (unsigned i = 0; i < v.nrBlocks; ++i) {
+			v.setblock(i, static_cast<BlockType>(generator()));
+		}
+		// enforce the nulling of the bits outside of nbits
+		v.setblock(v.MSU, static_cast<BlockType>(v.block(v.MSU) & v.MSU_MASK));
+	}
+
+	enum class LimbOp { ADD, SUB, MUL, DIV, REM, SHL, SHR };
+
+	template<unsigned nbits, BinaryNumberType NumberType = BinaryNumberType::Signed>
+	int VerifyLimbArithmetic(LimbOp op, unsigned nrRandoms, bool bReportIndividualTestCases) {
+		using Ref = blockbinary<nbits, uint32_t, NumberType>;
+		using Uut = blockbinary<nbits, uint64_t, NumberType>;
+		std::mt19937_64 generator(nbits);
+		int nrOfFailedTests = 0;
+		for (unsigned t = 0; t < nrRandoms; ++t) {
+			Ref a, b, c;
+			randomize(a, generator);
+			randomize(b, generator);
+			if (t % 4 == 1) b >>= static_cast<int>(generator() % nbits);  // exercise unequal operand magnitudes
+			if (t % 4 == 2) a.flip();                                       // exercise carry chains of all ones
+			Uut ua = convert_limbs<nbits, uint64_t>(a);
+			Uut ub = convert_limbs<nbits, uint64_t>(b);
+			Uut uc;
+			int shift = static_cast<int>(generator() % nbits);
+			switch (op) {
+			case LimbOp::ADD: c = a + b; uc = ua + ub; break;
+			case LimbOp::SUB: c = a - b; uc = ua - ub; break;
+			case LimbOp::MUL: c = a * b; uc = ua * ub; break;
+			case LimbOp::DIV: if (b.iszero()) continue; c = a / b; uc = ua / ub; break;
+			case LimbOp::REM: if (b.iszero()) continue; c = a % b; uc = ua % ub; break;
+			case LimbOp::SHL: c = a << shift; uc = ua << shift; break;
+			case LimbOp::SHR: c = a >> shift; uc = ua >> shift; break;
+			}
+			if (convert_limbs<nbits, uint32_t>(uc) != c) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) {
+					std::cerr << "FAIL " << to_hex(ua) << " op " << to_hex(ub) << " = " << to_hex(uc) << " reference " << to_hex(c) << '\n';
+				}
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	template<unsigned nbits, BinaryNumberType NumberType = BinaryNumberType::Signed>
+	int VerifyLimbConfiguration(unsigned nrRandoms, bool bReportIndividualTestCases) {
+		int nrOfFailedTests = 0;
+		nrOfFailedTests += VerifyLimbArithmetic<nbits, NumberType>(LimbOp::ADD, nrRandoms, bReportIndividualTestCases);
+		nrOfFailedTests += VerifyLimbArithmetic<nbits, NumberType>(LimbOp::SUB, nrRandoms, bReportIndividualTestCases);
+		nrOfFailedTests += VerifyLimbArithmetic<nbits, NumberType>(LimbOp::MUL, nrRandoms, bReportIndividualTestCases);
+		nrOfFailedTests += VerifyLimbArithmetic<nbits, NumberType>(LimbOp::DIV, nrRandoms / 16, bReportIndividualTestCases);
+		nrOfFailedTests += VerifyLimbArithmetic<nbits, NumberType>(LimbOp::REM, nrRandoms / 16, bReportIndividualTestCases);
+		nrOfFailedTests += VerifyLimbArithmetic<nbits, NumberType>(LimbOp::SHL, nrRandoms, bReportIndividualTestCases);
+		nrOfFailedTests += VerifyLimbArithmetic<nbits, NumberType>(LimbOp::SHR, nrRandoms, bReportIndividualTestCases);
+		return nrOfFailedTests;
+	}
+
+	// verify the limb primitives against the native uint64_t promotion for a 32-bit limb
+	int VerifyLimbPrimitives(unsigned nrRandoms, bool bReportIndividualTestCases) {
+		std::mt19937_64 generator(0);
+		int nrOfFailedTests = 0;
+		for (unsigned t = 0; t < nrRandoms; ++t) {
+			uint64_t a = generator(), b = generator(), addend = generator(), carry = generator();
+			if (t % 3 == 0) { a = ~0ull; b = ~0ull; addend = ~0ull; carry = ~0ull; }
+			// reference: schoolbook on 32-bit halves
+			uint32_t ah = uint32_t(a >> 32), al = uint32_t(a), bh = uint32_t(b >> 32), bl = uint32_t(b);
+			uint32_t r[4] = { 0, 0, 0, 0 };
+			uint32_t av[2] = { al, ah }, bv[2] = { bl, bh };
+			for (unsigned i = 0; i < 2; ++i) {
+				uint32_t c{ 0 };
+				for (unsigned j = 0; j < 2; ++j) r[i + j] = muladd(av[i], bv[j], r[i + j], c);
+				r[i + 2] = c;
+			}
+			bool cy{ false };
+			uint32_t add[4] = { uint32_t(addend), uint32_t(addend >> 32), 0, 0 };
+			for (unsigned i = 0; i < 4; ++i) r[i] = addcarry(r[i], add[i], cy);
+			cy = false;
+			uint32_t cin[4] = { uint32_t(carry), uint32_t(carry >> 32), 0, 0 };
+			for (unsigned i = 0; i < 4; ++i) r[i] = addcarry(r[i], cin[i], cy);
+			uint64_t refLo = (uint64_t(r[1]) << 32) | r[0];
+			uint64_t refHi = (uint64_t(r[3]) << 32) | r[2];
+
+			uint64_t hi = carry;
+			uint64_t lo = muladd(a, b, addend, hi);
+			if (lo != refLo || hi != refHi) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cerr << "FAIL muladd " << std::hex << a << " * " << b << " + " << addend << " + " << carry << std::dec << '\n';
+			}
+			// subtract with borrow must undo add with carry
+			bool c{ false }, borrow{ false };
+			uint64_t s = addcarry(a, b, c);
+			uint64_t d = subborrow(s, b, borrow);
+			if (d != a || c != borrow) {
+				++nrOfFailedTests;
+				if (bReportIndividualTestCases) std::cerr << "FAIL addcarry/subborrow " << std::hex << a << " , " << b << std::dec << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "blockbinary uint64_t limb arithmetic validation";
+	std::string test_tag    = "uint64_t limbs";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	std::cout << test_suite << '\n';
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbConfiguration<128>(100, reportTestCases), "blockbinary<128,uint64_t>", test_tag);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbPrimitives(1000, reportTestCases), "addcarry/subborrow/muladd", test_tag);
+
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbConfiguration< 65>(1000, reportTestCases), "blockbinary<  65,uint64_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbConfiguration<100>(1000, reportTestCases), "blockbinary< 100,uint64_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbConfiguration<128>(1000, reportTestCases), "blockbinary< 128,uint64_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbConfiguration<256>(1000, reportTestCases), "blockbinary< 256,uint64_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbConfiguration<200>(1000, reportTestCases), "blockbinary< 200,uint64_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbConfiguration<1024>(100, reportTestCases), "blockbinary<1024,uint64_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbConfiguration<1024>(1000, reportTestCases), "blockbinary<1024,uint64_t>", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,177 @@
+// longdivision.cpp: functional tests for the limb-based division kernels used by blockbinary
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <universal/utility/long_double.hpp>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <typeinfo>
+#include <vector>
+
+#include <universal/internal/blockbinary/blockbinary.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	template<typename Limb>
+	void randomize(std::vector<Limb>& v, unsigned n, std::mt19937_64& generator, unsigned pattern) {
+		for (unsigned i = 0; i < n; ++i) {
+			switch (pattern % 4) {
+			case 0: v[i] = static_cast<Limb>(generator()); break;
+			case 1: v[i] = static_cast<Limb>(~Limb(0)); break;                                   // all ones: qhat estimates of B - 1
+			case 2: v[i] = static_cast<Limb>((generator() & 0x3) ? 0 : generator()); break;      // sparse
+			case 3: v[i] = static_cast<Limb>((i + 1 == n) ? (Limb(1) << (sizeof(Limb) * 8 - 1)) : generator() & 0x1); break; // normalized, add back cases
+			}
+		}
+	}
+
+	// verify u == q * v + r and r < v
+	template<typename Limb>
+	bool CheckDivision(const std::vector<Limb>& u, const std::vector<Limb>& v, const std::vector<Limb>& q, const std::vector<Limb>& r) {
+		unsigned m = static_cast<unsigned>(u.size()), n = static_cast<unsigned>(v.size());
+		if (limb_compare(r.data(), v.data(), n) >= 0) return false;
+		std::vector<Limb> qv(m + n);
+		limb_mul_schoolbook(q.data(), m, v.data(), n, qv.data());
+		limb_add(qv.data(), m + n, r.data(), n);
+		for (unsigned i = 0; i < m; ++i) if (qv[i] != u[i]) return false;
+		for (unsigned i = m; i < m + n; ++i) if (qv[i] != Limb(0)) return false;
+		return true;
+	}
+
+	// exercise limb_divmod for all dividend and divisor lengths up to maxLimbs
+	template<typename Limb, unsigned newtonThreshold, unsigned karatsubaThreshold = LIMB_KARATSUBA_THRESHOLD>
+	int VerifyLimbDivision(unsigned maxLimbs, bool reportTestCases) {
+		std::mt19937_64 generator(maxLimbs);
+		int nrOfFailedTests = 0;
+		for (unsigned m = 1; m <= maxLimbs; ++m) {
+			for (unsigned n = 1; n <= m; ++n) {
+				for (unsigned pattern = 0; pattern < 8; ++pattern) {
+					std::vector<Limb> u(m), v(n), q(m), r(n), scratch(divmod_scratch_size(m, n));
+					randomize(u, m, generator, pattern);
+					randomize(v, n, generator, pattern / 4 + pattern);
+					if (v[n - 1] == 0) v[n - 1] = Limb(1);
+					limb_divmod<newtonThreshold, karatsubaThreshold>(u.data(), m, v.data(), n, q.data(), r.data(), scratch.data());
+					if (!CheckDivision(u, v, q, r)) {
+						++nrOfFailedTests;
+						if (reportTestCases) std::cerr << "FAIL: " << m << " limbs / " << n << " limbs of " << typeid(Limb).name() << " pattern " << pattern << '\n';
+					}
+				}
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// verify a / b and a % b of wide blockbinary numbers: a == (a / b) * b + a % b, |a % b| < |b|, and sign(a % b) == sign(a)
+	template<unsigned nbits, typename BlockType>
+	int VerifyWideDivision(unsigned nrRandoms, bool reportTestCases) {
+		using BlockBinary = blockbinary<nbits, BlockType>;
+		std::mt19937_64 generator(nbits);
+		int nrOfFailedTests = 0;
+		for (unsigned t = 0; t < nrRandoms; ++t) {
+			BlockBinary a, b;
+			for (unsigned i = 0; i < a.nrBlocks; ++i) {
+				a.setblock(i, static_cast<BlockType>(generator()));
+				b.setblock(i, static_cast<BlockType>(generator()));
+			}
+			a.setblock(a.MSU, static_cast<BlockType>(a.block(a.MSU) & a.MSU_MASK));
+			b.setblock(b.MSU, static_cast<BlockType>(b.block(b.MSU) & b.MSU_MASK));
+			b >>= static_cast<int>(generator() % (nbits - 1));  // exercise all divisor lengths
+			if (t & 0x1) b = -b;
+			if (b.iszero()) continue;
+			BlockBinary q = a / b;
+			BlockBinary r = a % b;
+			BlockBinary absr = r.isneg() ? -r : r;
+			BlockBinary absb = b.isneg() ? -b : b;
+			if (q * b + r != a || !(absr < absb) || (!r.iszero() && r.isneg() != a.isneg())) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << to_hex(a) << " / " << to_hex(b) << " = " << to_hex(q) << " rem " << to_hex(r) << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "limb-based long division validation";
+	std::string test_tag    = "longdivision";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	std::cout << test_suite << '\n';
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbDivision<uint8_t, LIMB_NEWTON_THRESHOLD>(8, reportTestCases), "uint8_t limbs, Algorithm D", test_tag);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	// Algorithm D
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbDivision<uint8_t , LIMB_NEWTON_THRESHOLD>(16, reportTestCases), "uint8_t  limbs, Algorithm D", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbDivision<uint16_t, LIMB_NEWTON_THRESHOLD>(16, reportTestCases), "uint16_t limbs, Algorithm D", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbDivision<uint32_t, LIMB_NEWTON_THRESHOLD>(16, reportTestCases), "uint32_t limbs, Algorithm D", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbDivision<uint64_t, LIMB_NEWTON_THRESHOLD>(16, reportTestCases), "uint64_t limbs, Algorithm D", test_tag);
+	// Newton-Raphson reciprocal with recursive precision doubling and Karatsuba products
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbDivision<uint8_t , 2, 4>(40, reportTestCases), "uint8_t  limbs, Newton-Raphson", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbDivision<uint32_t, 2, 4>(40, reportTestCases), "uint32_t limbs, Newton-Raphson", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbDivision<uint64_t, 2, 4>(40, reportTestCases), "uint64_t limbs, Newton-Raphson", test_tag);
+
+	nrOfFailedTestCases += ReportTestResult(VerifyWideDivision< 128, uint8_t >(1000, reportTestCases), "blockbinary< 128,uint8_t >", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyWideDivision< 100, uint32_t>(1000, reportTestCases), "blockbinary< 100,uint32_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyWideDivision< 256, uint64_t>(1000, reportTestCases), "blockbinary< 256,uint64_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyWideDivision<1024, uint32_t>( 100, reportTestCases), "blockbinary<1024,uint32_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyLimbDivision<uint16_t, 3, 5>(64, reportTestCases), "uint16_t limbs, Newton-Raphson", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyWideDivision<4096, uint64_t>(100, reportTestCases), "blockbinary<4096,uint64_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyWideDivision<LIMB_NEWTON_THRESHOLD * 64 + 64, uint64_t>(10, reportTestCases), "blockbinary<Newton-Raphson,uint64_t>", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
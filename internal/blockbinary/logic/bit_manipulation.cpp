@@ -0,0 +1,221 @@
+// bit_manipulation.cpp: functional tests for the limb-parallel bit manipulation of block binary numbers
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <universal/utility/long_double.hpp>
+#include <iostream>
+#include <iomanip>
+#include <random>
+
+#include <universal/internal/blockbinary/blockbinary.hpp>
+#include <universal/verification/test_suite.hpp>
+
+// the reference implementations work one bit at a time through test() and setbit()
+namespace sw { namespace universal {
+
+	template<unsigned nbits, typename BlockType>
+	void randomize(blockbinary<nbits, BlockType>& v, std::mt19937_64& generator) {
+		for (unsigned i = 0; i < v.nrBlocks; ++i) v.setblock(i, static_cast<BlockType>(generator()));
+		v.setblock(v.MSU, static_cast<BlockType>(v.block(v.MSU) & v.MSU_MASK));
+		// sparse patterns exercise the msb/lsb scans across empty limbs
+		unsigned pattern = static_cast<unsigned>(generator() % 4);
+		if (pattern == 1) v >>= static_cast<int>(generator() % nbits);
+		if (pattern == 2) v <<= static_cast<int>(generator() % nbits);
+	}
+
+	template<unsigned nbits, typename BlockType>
+	int VerifyShifts(unsigned nrRandoms, bool reportTestCases) {
+		using BlockBinary = blockbinary<nbits, BlockType>;
+		std::mt19937_64 generator(nbits);
+		int nrOfFailedTests = 0;
+		for (unsigned t = 0; t < nrRandoms; ++t) {
+			BlockBinary a;
+			randomize(a, generator);
+			for (int shift = -static_cast<int>(nbits) - 1; shift <= static_cast<int>(nbits) + 1; ++shift) {
+				BlockBinary left(a), right(a), refLeft, refRight;
+				left <<= shift;
+				right >>= shift;
+				refLeft.clear();
+				refRight.clear();
+				for (int i = 0; i < static_cast<int>(nbits); ++i) {
+					// left shift by a negative amount is a right shift, and vice versa
+					int lsrc = i - shift;
+					int rsrc = i + shift;
+					if (shift > static_cast<int>(nbits)) lsrc = -1;               // all bits shifted out
+					if (-shift >= static_cast<int>(nbits)) lsrc = -1;
+					if (shift >= static_cast<int>(nbits)) rsrc = -1;
+					if (-shift > static_cast<int>(nbits)) rsrc = -1;
+					bool lbit = (lsrc >= 0 && lsrc < static_cast<int>(nbits)) ? a.test(static_cast<unsigned>(lsrc)) : (lsrc >= static_cast<int>(nbits) && a.sign());
+					bool rbit = (rsrc >= 0 && rsrc < static_cast<int>(nbits)) ? a.test(static_cast<unsigned>(rsrc)) : (rsrc >= static_cast<int>(nbits) && a.sign());
+					refLeft.setbit(static_cast<unsigned>(i), lbit);
+					refRight.setbit(static_cast<unsigned>(i), rbit);
+				}
+				if (left != refLeft || right != refRight) {
+					++nrOfFailedTests;
+					if (reportTestCases) std::cerr << "FAIL: " << to_binary(a) << " shift " << shift << " : " << to_binary(left) << " vs " << to_binary(refLeft) << " : " << to_binary(right) << " vs " << to_binary(refRight) << '\n';
+				}
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	template<unsigned srcbits, unsigned tgtbits, typename BlockType>
+	int VerifyTruncateAndAssign(unsigned nrRandoms, bool reportTestCases) {
+		std::mt19937_64 generator(srcbits * tgtbits);
+		int nrOfFailedTests = 0;
+		for (unsigned t = 0; t < nrRandoms; ++t) {
+			blockbinary<srcbits, BlockType> wide;
+			blockbinary<tgtbits, BlockType> narrow, refNarrow;
+			randomize(wide, generator);
+			truncate(wide, narrow);
+			refNarrow.clear();
+			for (unsigned i = 0; i < tgtbits; ++i) refNarrow.setbit(i, wide.test(i + srcbits - tgtbits));
+			if (narrow != refNarrow) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: truncate " << to_binary(wide) << " : " << to_binary(narrow) << " vs " << to_binary(refNarrow) << '\n';
+			}
+
+			// sign extension of the narrow value into the wide value
+			randomize(narrow, generator);
+			blockbinary<srcbits, BlockType> extended, refExtended;
+			extended.assign(narrow);
+			refExtended.clear();
+			for (unsigned i = 0; i < srcbits; ++i) refExtended.setbit(i, (i < tgtbits) ? narrow.test(i) : narrow.sign());
+			if (extended != refExtended) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: assign " << to_binary(narrow) << " : " << to_binary(extended) << " vs " << to_binary(refExtended) << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	template<unsigned nbits, typename BlockType>
+	int VerifyScans(unsigned nrRandoms, bool reportTestCases) {
+		using BlockBinary = blockbinary<nbits, BlockType>;
+		std::mt19937_64 generator(nbits + 1);
+		int nrOfFailedTests = 0;
+		for (unsigned t = 0; t < nrRandoms; ++t) {
+			BlockBinary a;
+			randomize(a, generator);
+			if (t == 0) a.clear();
+			int refMsb{ -1 }, refLsb{ -1 };
+			unsigned refCount{ 0 };
+			for (unsigned i = 0; i < nbits; ++i) {
+				if (a.test(i)) {
+					if (refLsb < 0) refLsb = static_cast<int>(i);
+					refMsb = static_cast<int>(i);
+					++refCount;
+				}
+			}
+			bool fail = (a.msb() != refMsb) || (a.lsb() != refLsb) || (a.count() != refCount);
+			for (unsigned i = 0; i < nbits; ++i) {
+				bool refAnyAfter = (refLsb >= 0 && refLsb < static_cast<int>(i));
+				if (a.anyAfter(i) != refAnyAfter) fail = true;
+			}
+			// setrange
+			unsigned lsb = static_cast<unsigned>(generator() % nbits);
+			unsigned msbPlusOne = lsb + static_cast<unsigned>(generator() % (nbits - lsb + 1));
+			bool v = (generator() & 0x1);
+			BlockBinary b(a), refB(a);
+			b.setrange(lsb, msbPlusOne, v);
+			for (unsigned i = lsb; i < msbPlusOne; ++i) refB.setbit(i, v);
+			if (b != refB) fail = true;
+			if (fail) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << to_binary(a) << " msb " << a.msb() << " lsb " << a.lsb() << " count " << a.count() << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	template<unsigned nbits, typename BlockType>
+	int VerifyBitManipulation(unsigned nrRandoms, bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		nrOfFailedTests += VerifyShifts<nbits, BlockType>(nrRandoms, reportTestCases);
+		nrOfFailedTests += VerifyScans<nbits, BlockType>(nrRandoms * 4, reportTestCases);
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "blockbinary limb-parallel bit manipulation";
+	std::string test_tag    = "bit manipulation";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	std::cout << test_suite << '\n';
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyBitManipulation<12, uint8_t>(10, reportTestCases), "blockbinary<12,uint8_t>", test_tag);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyBitManipulation<  5, uint8_t >(20, reportTestCases), "blockbinary<  5,uint8_t >", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyBitManipulation<  8, uint8_t >(20, reportTestCases), "blockbinary<  8,uint8_t >", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyBitManipulation< 37, uint8_t >(20, reportTestCases), "blockbinary< 37,uint8_t >", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyBitManipulation< 48, uint16_t>(20, reportTestCases), "blockbinary< 48,uint16_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyBitManipulation< 71, uint32_t>(20, reportTestCases), "blockbinary< 71,uint32_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyBitManipulation< 64, uint64_t>(20, reportTestCases), "blockbinary< 64,uint64_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyBitManipulation<130, uint64_t>(20, reportTestCases), "blockbinary<130,uint64_t>", test_tag);
+
+	nrOfFailedTestCases += ReportTestResult(VerifyTruncateAndAssign< 16,  8, uint8_t >(100, reportTestCases), "truncate/assign 16 <->  8, uint8_t ", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyTruncateAndAssign< 37, 11, uint8_t >(100, reportTestCases), "truncate/assign 37 <-> 11, uint8_t ", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyTruncateAndAssign< 67, 33, uint16_t>(100, reportTestCases), "truncate/assign 67 <-> 33, uint16_t", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyTruncateAndAssign<100, 64, uint32_t>(100, reportTestCases), "truncate/assign 100 <-> 64, uint32_t", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyTruncateAndAssign<200, 65, uint64_t>(100, reportTestCases), "truncate/assign 200 <-> 65, uint64_t", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyBitManipulation<256, uint32_t>(20, reportTestCases), "blockbinary<256,uint32_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyBitManipulation<1000, uint64_t>(10, reportTestCases), "blockbinary<1000,uint64_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyTruncateAndAssign<1024, 1000, uint8_t>(100, reportTestCases), "truncate/assign 1024 <-> 1000, uint8_t", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
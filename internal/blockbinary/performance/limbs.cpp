@@ -0,0 +1,273 @@
+//  limbs.cpp : performance benchmarking of the limb primitives that drive block binary arithmetic
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <universal/utility/long_double.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <universal/internal/blockbinary/blockbinary.hpp>
+#include <universal/benchmark/performance_runner.hpp>
+
+namespace sw::universal::bb {
+
+	// workloads for the single-limb primitives of limb_arithmetic.hpp
+	// each workload chains its results so that the optimizer cannot hoist the primitive out of the loop
+
+	template<typename Limb>
+	void AddCarryWorkload(size_t NR_OPS) {
+		Limb a = static_cast<Limb>(0x9E37'79B9'7F4A'7C15ull), b = static_cast<Limb>(0xBF58'476D'1CE4'E5B9ull);
+		bool carry{ false };
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			a = addcarry(a, b, carry);
+			b = static_cast<Limb>(b ^ a);
+		}
+		if (a == b && carry) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	template<typename Limb>
+	void SubBorrowWorkload(size_t NR_OPS) {
+		Limb a = static_cast<Limb>(0x9E37'79B9'7F4A'7C15ull), b = static_cast<Limb>(0xBF58'476D'1CE4'E5B9ull);
+		bool borrow{ false };
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			a = subborrow(a, b, borrow);
+			b = static_cast<Limb>(b ^ a);
+		}
+		if (a == b && borrow) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	template<typename Limb>
+	void MulWideWorkload(size_t NR_OPS) {
+		Limb a = static_cast<Limb>(0x9E37'79B9'7F4A'7C15ull), hi{ 0 };
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			Limb lo = mulwide(a, static_cast<Limb>(a | 1u), hi);
+			a = static_cast<Limb>(lo ^ hi);
+		}
+		if (a == hi) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	template<typename Limb>
+	void MulAddWorkload(size_t NR_OPS) {
+		Limb a = static_cast<Limb>(0x9E37'79B9'7F4A'7C15ull), carry{ 0 };
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			a = muladd(a, static_cast<Limb>(a | 1u), a, carry);
+		}
+		if (a == carry) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	template<typename Limb>
+	void DivWideWorkload(size_t NR_OPS) {
+		constexpr Limb d = static_cast<Limb>(~Limb(0) - Limb(0x35));
+		Limb hi = static_cast<Limb>(0x1234'5678'9ABC'DEF0ull % d), lo = static_cast<Limb>(0x0FED'CBA9'8765'4321ull), rem{ 0 };
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			Limb q = divwide(hi, lo, d, rem);
+			hi = rem;
+			lo = static_cast<Limb>(lo ^ q);
+		}
+		if (hi == lo) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	// workloads for the multi-limb kernels of limb_multiplication.hpp and limb_division.hpp
+
+	template<typename Limb, unsigned nrLimbs>
+	void LimbAddWorkload(size_t NR_OPS) {
+		std::vector<Limb> a(nrLimbs, static_cast<Limb>(0x5555'5555'5555'5555ull)), b(nrLimbs, static_cast<Limb>(0x3333'3333'3333'3333ull));
+		Limb carry{ 0 };
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			carry = static_cast<Limb>(carry + limb_add(a.data(), nrLimbs, b.data(), nrLimbs));
+		}
+		if (a[0] == carry) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	template<typename Limb, unsigned nrLimbs>
+	void LimbMulloWorkload(size_t NR_OPS) {
+		std::vector<Limb> a(nrLimbs, static_cast<Limb>(0x5555'5555'5555'5555ull)), b(nrLimbs, static_cast<Limb>(0x3333'3333'3333'3333ull)), r(nrLimbs);
+		std::vector<Limb> scratch(mullo_scratch_size<LIMB_KARATSUBA_THRESHOLD>(nrLimbs) + 1);
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			limb_mullo(a.data(), b.data(), nrLimbs, r.data(), scratch.data());
+			a[0] = static_cast<Limb>(r[0] | 1u);
+		}
+		if (a[0] == b[0]) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	template<typename Limb, unsigned nrLimbs>
+	void LimbDivModWorkload(size_t NR_OPS) {
+		constexpr unsigned m = 2 * nrLimbs, n = nrLimbs;
+		std::vector<Limb> u(m, static_cast<Limb>(0x5555'5555'5555'5555ull)), v(n, static_cast<Limb>(0x3333'3333'3333'3333ull)), q(m), r(n);
+		std::vector<Limb> scratch(divmod_scratch_size(m, n));
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			limb_divmod(u.data(), m, v.data(), n, q.data(), r.data(), scratch.data());
+			u[0] = static_cast<Limb>(u[0] ^ r[0]);
+		}
+		if (q[0] == r[0]) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	// workloads for the word-parallel bit manipulation of blockbinary
+
+	template<typename BlockbinaryConfiguration>
+	void MsbWorkload(size_t NR_OPS) {
+		BlockbinaryConfiguration a{ 0 };
+		a.setbit(0);
+		int sum{ 0 };
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			sum += a.msb() + a.lsb();
+			unsigned bit = static_cast<unsigned>(i % a.nbits);
+			a.setbit(bit, !a.test(bit));
+		}
+		if (sum == 0) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	template<typename BlockbinaryConfiguration>
+	void SignExtensionWorkload(size_t NR_OPS) {
+		constexpr unsigned srcbits = BlockbinaryConfiguration::nbits;
+		using Wide = blockbinary<2 * srcbits + 3, typename BlockbinaryConfiguration::BlockType>;
+		BlockbinaryConfiguration a{ 0 };
+		a.setbits(0xFFFF'FFFF'FFFF'FFFFull);
+		Wide b{ 0 };
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			b.assign(a);
+			unsigned bit = static_cast<unsigned>(i % srcbits);
+			a.setbit(bit, !a.test(bit));
+		}
+		if (b.iszero()) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	template<typename BlockbinaryConfiguration>
+	void TruncateWorkload(size_t NR_OPS) {
+		constexpr unsigned srcbits = BlockbinaryConfiguration::nbits;
+		using Narrow = blockbinary<srcbits / 2 + 3, typename BlockbinaryConfiguration::BlockType>;
+		BlockbinaryConfiguration a{ 0 };
+		a.setbits(0xFFFF'FFFF'FFFF'FFFFull);
+		a <<= static_cast<int>(srcbits / 2);
+		Narrow b{ 0 };
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			truncate(a, b);
+			unsigned bit = static_cast<unsigned>(i % srcbits);
+			a.setbit(bit, !a.test(bit));
+		}
+		if (b.iszero()) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+	template<typename BlockbinaryConfiguration>
+	void ShiftWorkload(size_t NR_OPS) {
+		BlockbinaryConfiguration a{ 0 };
+		a.setbits(0xFFFF'FFFF'FFFF'FFFFull);
+		uint64_t sum{ 0 };
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			a <<= static_cast<int>(i % 67);
+			a >>= static_cast<int>(i % 61);
+			a.setbit(0);
+			sum += a.block(0);
+		}
+		if (sum == 0) std::cout << "dummy case to fool the optimizer\n";
+	}
+
+} // namespace sw::universal::bb
+
+void TestSingleLimbPrimitives() {
+	using namespace sw::universal;
+	std::cout << "\nSingle limb primitives\n";
+
+	constexpr size_t NR_OPS = 1024ull * 1024ull * 4ull;
+
+	PerformanceRunner("addcarry<uint8>                 ", bb::AddCarryWorkload<uint8_t>, NR_OPS);
+	PerformanceRunner("addcarry<uint32>                ", bb::AddCarryWorkload<uint32_t>, NR_OPS);
+	PerformanceRunner("addcarry<uint64>                ", bb::AddCarryWorkload<uint64_t>, NR_OPS);
+	PerformanceRunner("subborrow<uint8>                ", bb::SubBorrowWorkload<uint8_t>, NR_OPS);
+	PerformanceRunner("subborrow<uint32>               ", bb::SubBorrowWorkload<uint32_t>, NR_OPS);
+	PerformanceRunner("subborrow<uint64>               ", bb::SubBorrowWorkload<uint64_t>, NR_OPS);
+	PerformanceRunner("mulwide<uint32>                 ", bb::MulWideWorkload<uint32_t>, NR_OPS);
+	PerformanceRunner("mulwide<uint64>                 ", bb::MulWideWorkload<uint64_t>, NR_OPS);
+	PerformanceRunner("muladd<uint32>                  ", bb::MulAddWorkload<uint32_t>, NR_OPS);
+	PerformanceRunner("muladd<uint64>                  ", bb::MulAddWorkload<uint64_t>, NR_OPS);
+	PerformanceRunner("divwide<uint32>                 ", bb::DivWideWorkload<uint32_t>, NR_OPS);
+	PerformanceRunner("divwide<uint64>                 ", bb::DivWideWorkload<uint64_t>, NR_OPS);
+}
+
+void TestMultiLimbKernels() {
+	using namespace sw::universal;
+	std::cout << "\nMulti limb kernels\n";
+
+	constexpr size_t NR_OPS = 1024ull * 256ull;
+
+	PerformanceRunner("limb_add<uint32,    8>          ", bb::LimbAddWorkload<uint32_t, 8>, NR_OPS);
+	PerformanceRunner("limb_add<uint64,    8>          ", bb::LimbAddWorkload<uint64_t, 8>, NR_OPS);
+	PerformanceRunner("limb_add<uint64,   64>          ", bb::LimbAddWorkload<uint64_t, 64>, NR_OPS / 8);
+	PerformanceRunner("limb_mullo<uint32,  8>          ", bb::LimbMulloWorkload<uint32_t, 8>, NR_OPS / 4);
+	PerformanceRunner("limb_mullo<uint64,  8>          ", bb::LimbMulloWorkload<uint64_t, 8>, NR_OPS / 4);
+	PerformanceRunner("limb_mullo<uint64, 64>          ", bb::LimbMulloWorkload<uint64_t, 64>, NR_OPS / 256);
+	PerformanceRunner("limb_divmod<uint32, 8>          ", bb::LimbDivModWorkload<uint32_t, 8>, NR_OPS / 8);
+	PerformanceRunner("limb_divmod<uint64, 8>          ", bb::LimbDivModWorkload<uint64_t, 8>, NR_OPS / 8);
+	PerformanceRunner("limb_divmod<uint64,64>          ", bb::LimbDivModWorkload<uint64_t, 64>, NR_OPS / 512);
+}
+
+void TestBitManipulation() {
+	using namespace sw::universal;
+	std::cout << "\nWord-parallel bit manipulation\n";
+
+	constexpr size_t NR_OPS = 1024ull * 1024ull;
+
+	PerformanceRunner("blockbinary<64,uint8>    msb/lsb", bb::MsbWorkload< blockbinary<64, uint8_t> >, NR_OPS);
+	PerformanceRunner("blockbinary<64,uint64>   msb/lsb", bb::MsbWorkload< blockbinary<64, uint64_t> >, NR_OPS);
+	PerformanceRunner("blockbinary<256,uint32>  msb/lsb", bb::MsbWorkload< blockbinary<256, uint32_t> >, NR_OPS);
+	PerformanceRunner("blockbinary<1024,uint64> msb/lsb", bb::MsbWorkload< blockbinary<1024, uint64_t> >, NR_OPS / 4);
+
+	PerformanceRunner("blockbinary<64,uint8>    signext", bb::SignExtensionWorkload< blockbinary<64, uint8_t> >, NR_OPS);
+	PerformanceRunner("blockbinary<64,uint32>   signext", bb::SignExtensionWorkload< blockbinary<64, uint32_t> >, NR_OPS);
+	PerformanceRunner("blockbinary<256,uint64>  signext", bb::SignExtensionWorkload< blockbinary<256, uint64_t> >, NR_OPS / 4);
+
+	PerformanceRunner("blockbinary<64,uint8>    trunc  ", bb::TruncateWorkload< blockbinary<64, uint8_t> >, NR_OPS);
+	PerformanceRunner("blockbinary<64,uint32>   trunc  ", bb::TruncateWorkload< blockbinary<64, uint32_t> >, NR_OPS);
+	PerformanceRunner("blockbinary<256,uint64>  trunc  ", bb::TruncateWorkload< blockbinary<256, uint64_t> >, NR_OPS / 4);
+
+	PerformanceRunner("blockbinary<64,uint8>    shifts ", bb::ShiftWorkload< blockbinary<64, uint8_t> >, NR_OPS);
+	PerformanceRunner("blockbinary<64,uint64>   shifts ", bb::ShiftWorkload< blockbinary<64, uint64_t> >, NR_OPS);
+	PerformanceRunner("blockbinary<256,uint32>  shifts ", bb::ShiftWorkload< blockbinary<256, uint32_t> >, NR_OPS / 4);
+	PerformanceRunner("blockbinary<1024,uint64> shifts ", bb::ShiftWorkload< blockbinary<1024, uint64_t> >, NR_OPS / 16);
+}
+
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string tag = "limb primitive performance benchmarking";
+
+#if MANUAL_TESTING
+
+	PerformanceRunner("blockbinary<1024,uint64> msb/lsb", bb::MsbWorkload< blockbinary<1024, uint64_t> >, 1024 * 1024);
+
+	std::cout << "done" << std::endl;
+
+	return EXIT_SUCCESS;
+#else
+	std::cout << tag << std::endl;
+
+	TestSingleLimbPrimitives();
+	TestMultiLimbKernels();
+	TestBitManipulation();
+
+#if STRESS_TESTING
+
+#endif // STRESS_TESTING
+	return EXIT_SUCCESS;
+
+#endif // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << '\n';
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
@@ -333,6 +333,33 @@ void TestBlockPerformanceOnMul() {
 	PerformanceRunner("blockbinary<1024,uint32>  mul   ", bb::MultiplicationWorkload< blockbinary<1024, uint32_t> >, NR_OPS / 256);
 }
 
+void TestLimbSizePerformance() {
+	using namespace sw::universal;
+	std::cout << "\nLIMBS: blockbinary arithmetic performance of uint32_t versus uint64_t limbs\n";
+
+	constexpr size_t NR_OPS = 1024ull * 1024;
+	PerformanceRunner("blockbinary<128,uint32>   add   ", bb::AdditionSubtractionWorkload< blockbinary<128, uint32_t> >, NR_OPS);
+	PerformanceRunner("blockbinary<128,uint64>   add   ", bb::AdditionSubtractionWorkload< blockbinary<128, uint64_t> >, NR_OPS);
+	PerformanceRunner("blockbinary<256,uint32>   add   ", bb::AdditionSubtractionWorkload< blockbinary<256, uint32_t> >, NR_OPS / 2);
+	PerformanceRunner("blockbinary<256,uint64>   add   ", bb::AdditionSubtractionWorkload< blockbinary<256, uint64_t> >, NR_OPS / 2);
+	PerformanceRunner("blockbinary<1024,uint32>  add   ", bb::AdditionSubtractionWorkload< blockbinary<1024, uint32_t> >, NR_OPS / 8);
+	PerformanceRunner("blockbinary<1024,uint64>  add   ", bb::AdditionSubtractionWorkload< blockbinary<1024, uint64_t> >, NR_OPS / 8);
+
+	PerformanceRunner("blockbinary<128,uint32>   mul   ", bb::MultiplicationWorkload< blockbinary<128, uint32_t> >, NR_OPS / 2);
+	PerformanceRunner("blockbinary<128,uint64>   mul   ", bb::MultiplicationWorkload< blockbinary<128, uint64_t> >, NR_OPS / 2);
+	PerformanceRunner("blockbinary<256,uint32>   mul   ", bb::MultiplicationWorkload< blockbinary<256, uint32_t> >, NR_OPS / 4);
+	PerformanceRunner("blockbinary<256,uint64>   mul   ", bb::MultiplicationWorkload< blockbinary<256, uint64_t> >, NR_OPS / 4);
+	PerformanceRunner("blockbinary<1024,uint32>  mul   ", bb::MultiplicationWorkload< blockbinary<1024, uint32_t> >, NR_OPS / 256);
+	PerformanceRunner("blockbinary<1024,uint64>  mul   ", bb::MultiplicationWorkload< blockbinary<1024, uint64_t> >, NR_OPS / 256);
+
+	PerformanceRunner("blockbinary<128,uint32>   shifts", bb::ShiftPerformanceWorkload< blockbinary<128, uint32_t> >, NR_OPS);
+	PerformanceRunner("blockbinary<128,uint64>   shifts", bb::ShiftPerformanceWorkload< blockbinary<128, uint64_t> >, NR_OPS);
+	PerformanceRunner("blockbinary<256,uint32>   shifts", bb::ShiftPerformanceWorkload< blockbinary<256, uint32_t> >, NR_OPS / 2);
+	PerformanceRunner("blockbinary<256,uint64>   shifts", bb::ShiftPerformanceWorkload< blockbinary<256, uint64_t> >, NR_OPS / 2);
+	PerformanceRunner("blockbinary<1024,uint32>  shifts", bb::ShiftPerformanceWorkload< blockbinary<1024, uint32_t> >, NR_OPS / 8);
+	PerformanceRunner("blockbinary<1024,uint64>  shifts", bb::ShiftPerformanceWorkload< blockbinary<1024, uint64_t> >, NR_OPS / 8);
+}
+
 #define MANUAL_TESTING 0
 #define STRESS_TESTING 0
 
@@ -368,6 +395,7 @@ try {
 	TestBlockPerformanceOnMul();
 	TestBlockPerformanceOnDiv();
 	TestBlockPerformanceOnRem();
+	TestLimbSizePerformance();
 
 #if STRESS_TESTING
 
@@ -0,0 +1,273 @@
+// quire.cpp: verify the cfloat super-accumulator and fused dot product
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/internal/blockbinary/blockbinary.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// a random finite cfloat
+	template<typename Cfloat>
+	Cfloat RandomFinite(std::mt19937_64& generator) {
+		Cfloat v;
+		do {
+			v.setbits(generator());
+		} while (v.isnan() || v.isinf());
+		return v;
+	}
+
+	// place a double that is an integer multiple of 2^-radix_point in a fixed-point reference
+	template<typename Quire, typename Reference>
+	Reference ReferenceFixedPoint(double v) {
+		Reference r(0);
+		if (v == 0.0) return r;
+		int exponent{ 0 };
+		double significand = std::frexp(std::fabs(v), &exponent);
+		long long mantissa = static_cast<long long>(std::ldexp(significand, 53));
+		int shift = exponent - 53 + int(Quire::radix_point);
+		r = mantissa;
+		if (shift >= 0) r <<= shift; else r >>= -shift;
+		return (v < 0.0 ? -r : r);
+	}
+
+	template<typename Quire, typename Reference>
+	bool SameAccumulation(const Quire& q, const Reference& reference) {
+		for (unsigned i = 0; i < Quire::nrLimbs; ++i) {
+			if (q.limb(i) != reference.block(i)) return false;
+		}
+		return true;
+	}
+
+	// accumulate random products and values, and compare the limbs with a fixed-point reference.
+	// the products of the cfloats under test are exact in double precision.
+	template<typename Cfloat, unsigned capacity>
+	int VerifyQuireAccumulation(unsigned nrOfRuns, unsigned nrOfTerms, bool reportTestCases) {
+		using Quire = cfloat_quire<Cfloat, capacity>;
+		using Reference = blockbinary<Quire::nrLimbs * 64, uint64_t>;
+		static_assert(2 * (Cfloat::fbits + 1) <= 53, "products must be exact in double precision");
+		std::mt19937_64 generator(Cfloat::nbits * 7 + Cfloat::es);
+		int nrOfFailedTests = 0;
+		for (unsigned run = 0; run < nrOfRuns; ++run) {
+			Quire q, partial;
+			Reference reference(0), partialReference(0);
+			for (unsigned t = 0; t < nrOfTerms; ++t) {
+				Cfloat a = RandomFinite<Cfloat>(generator);
+				Cfloat b = RandomFinite<Cfloat>(generator);
+				Reference term = ReferenceFixedPoint<Quire, Reference>(double(a) * double(b));
+				switch (generator() % 5) {
+				case 0:
+					q.add_product(a, b);
+					reference += term;
+					break;
+				case 1:
+					q += quire_mul(a, b);
+					reference += term;
+					break;
+				case 2:
+					q -= quire_mul(a, b);
+					reference -= term;
+					break;
+				case 3:
+					q += a;
+					reference += ReferenceFixedPoint<Quire, Reference>(double(a));
+					break;
+				case 4:
+					partial.add_product(a, b);
+					partialReference += term;
+					if (generator() & 0x1) {
+						q += partial;
+						reference += partialReference;
+					}
+					else {
+						q -= partial;
+						reference -= partialReference;
+					}
+					break;
+				}
+				if (!SameAccumulation(q, reference)) {
+					++nrOfFailedTests;
+					if (reportTestCases) std::cerr << "FAIL: " << q << " after accumulating " << a << " * " << b << '\n';
+					break;
+				}
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// the quire does not track the sign of zero, so -0 and +0 are considered equal
+	template<typename Cfloat, typename Native>
+	int VerifyRoundingOfSingleTerm(const Cfloat& a, const Cfloat& b, bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		cfloat_quire<Cfloat, 2> q;
+		Cfloat result, reference;
+
+		// the product of two values has a single rounding step
+		q.add_product(a, b);
+		convert(q, result);
+		reference = Native(a) * Native(b);
+		if (result != reference && !(result.isnan() && reference.isnan()) && !(result.iszero() && reference.iszero())) {
+			++nrOfFailedTests;
+			if (reportTestCases) ReportBinaryArithmeticError("FAIL", "fdp", a, b, result, reference);
+		}
+
+		// the sum of two values has a single rounding step
+		q = a;
+		q += b;
+		convert(q, result);
+		reference = Native(a) + Native(b);
+		if (result != reference && !(result.isnan() && reference.isnan()) && !(result.iszero() && reference.iszero())) {
+			++nrOfFailedTests;
+			if (reportTestCases) ReportBinaryArithmeticError("FAIL", "sum", a, b, result, reference);
+		}
+		return nrOfFailedTests;
+	}
+
+	// the rounding of the quire is compared to a native type that computes products and sums with
+	// enough precision to make the conversion to the cfloat the only rounding step
+	template<typename Cfloat, typename Native>
+	int VerifyQuireRounding(bool reportTestCases) {
+		constexpr unsigned NR_VALUES = (1u << Cfloat::nbits);
+		int nrOfFailedTests = 0;
+		Cfloat a, b;
+		for (unsigned i = 0; i < NR_VALUES; ++i) {
+			a.setbits(i);
+			for (unsigned j = 0; j < NR_VALUES; ++j) {
+				b.setbits(j);
+				nrOfFailedTests += VerifyRoundingOfSingleTerm<Cfloat, Native>(a, b, reportTestCases);
+				if (nrOfFailedTests > 24) return nrOfFailedTests;
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	template<typename Cfloat, typename Native>
+	int VerifyRandomQuireRounding(unsigned nrOfRandoms, bool reportTestCases) {
+		std::mt19937_64 generator(Cfloat::nbits * 13 + Cfloat::es);
+		int nrOfFailedTests = 0;
+		for (unsigned i = 0; i < nrOfRandoms; ++i) {
+			Cfloat a = RandomFinite<Cfloat>(generator);
+			Cfloat b = RandomFinite<Cfloat>(generator);
+			nrOfFailedTests += VerifyRoundingOfSingleTerm<Cfloat, Native>(a, b, reportTestCases);
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+		return nrOfFailedTests;
+	}
+
+	// catastrophic cancellation is absorbed by the quire
+	template<typename Cfloat>
+	int VerifyFusedDotProduct(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		Cfloat big(SpecificValue::maxpos), one(1.0f), minpos(SpecificValue::minpos);
+		std::vector<Cfloat> x = { big, one, minpos, -big }, y = { big, one, one, big };
+		Cfloat result = fdp(x, y);
+		Cfloat reference = one + minpos;
+		if (result != reference) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: fdp " << result << " != " << reference << '\n';
+		}
+		result = fdp_stride(4, x, 2, y, 2);
+		if (result != big * big) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: fdp_stride " << result << " != " << big * big << '\n';
+		}
+		cfloat_quire<Cfloat, 10> q;
+		fdp_qc(q, 4, x, 1, y, 1);
+		fdp_qc(q, 4, x, 1, y, 1);
+		convert(q, result);
+		reference = Cfloat(2.0f) + Cfloat(2.0f) * minpos;
+		if (result != reference) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: fdp_qc " << result << " != " << reference << '\n';
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "cfloat quire and fused dot product";
+	std::string test_tag    = "quire";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	std::cout << cfloat_quire_properties<single>() << '\n';
+	nrOfFailedTestCases += ReportTestResult(VerifyQuireAccumulation<quarter, 2>(10, 100, reportTestCases), "cfloat_quire<fp8>", test_tag);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyQuireRounding<quarter, double>(reportTestCases), "rounding fp8", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyQuireRounding<cfloat<8, 4, uint8_t, true, false, false>, double>(reportTestCases), "rounding cfloat<8,4>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomQuireRounding<single, double>(10000, reportTestCases), "rounding single", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomQuireRounding<duble, double>(10000, reportTestCases), "rounding double", test_tag);
+
+	nrOfFailedTestCases += ReportTestResult(VerifyQuireAccumulation<quarter, 2>(20, 200, reportTestCases), "cfloat_quire<fp8,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyQuireAccumulation<half, 10>(20, 200, reportTestCases), "cfloat_quire<fp16,10>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyQuireAccumulation<single, 30>(10, 200, reportTestCases), "cfloat_quire<fp32,30>", test_tag);
+
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedDotProduct<half>(reportTestCases), "fdp fp16", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedDotProduct<single>(reportTestCases), "fdp fp32", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedDotProduct<duble>(reportTestCases), "fdp fp64", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyQuireRounding<cfloat<10, 3, uint16_t, true, false, false>, double>(reportTestCases), "rounding cfloat<10,3>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomQuireRounding<half, double>(100000, reportTestCases), "rounding half", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyQuireAccumulation<bfloat_t, 30>(20, 1000, reportTestCases), "cfloat_quire<bfloat16,30>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyQuireAccumulation<single, 30>(100, 1000, reportTestCases), "cfloat_quire<fp32,30>", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
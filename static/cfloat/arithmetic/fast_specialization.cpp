@@ -0,0 +1,127 @@
+// fast_specialization.cpp: test suite runner for the cfloat operators with the native integer fast paths enabled
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <iomanip>
+// enable the native integer arithmetic of cfloats with nbits <= 64
+#define CFLOAT_FAST_SPECIALIZATION
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/verification/test_status.hpp>
+#include <universal/verification/test_case.hpp>
+#include <universal/verification/test_suite_random.hpp>
+#include <universal/verification/cfloat_test_suite.hpp>
+
+// run the enumerating arithmetic test suites of a small cfloat configuration
+template<typename Cfloat>
+int VerifyArithmetic(bool reportTestCases, const std::string& tag) {
+	using namespace sw::universal;
+	int nrOfFailedTestCases = 0;
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatAddition<Cfloat>(reportTestCases), tag, "addition      ");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSubtraction<Cfloat>(reportTestCases), tag, "subtraction   ");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatMultiplication<Cfloat>(reportTestCases), tag, "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatDivision<Cfloat>(reportTestCases), tag, "division      ");
+	return nrOfFailedTestCases;
+}
+
+// run the randomized arithmetic test suites of a large cfloat configuration
+template<typename Cfloat>
+int Randoms(bool reportTestCases, const std::string& tag, size_t nrTests) {
+	using namespace sw::universal;
+	int nrOfFailedTestCases = 0;
+	nrOfFailedTestCases += ReportTestResult(VerifyBinaryOperatorThroughRandoms<Cfloat>(reportTestCases, RandomsOp::OPCODE_ADD, nrTests), tag, "addition      ");
+	nrOfFailedTestCases += ReportTestResult(VerifyBinaryOperatorThroughRandoms<Cfloat>(reportTestCases, RandomsOp::OPCODE_SUB, nrTests), tag, "subtraction   ");
+	nrOfFailedTestCases += ReportTestResult(VerifyBinaryOperatorThroughRandoms<Cfloat>(reportTestCases, RandomsOp::OPCODE_MUL, nrTests), tag, "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyBinaryOperatorThroughRandoms<Cfloat>(reportTestCases, RandomsOp::OPCODE_DIV, nrTests), tag, "division      ");
+	return nrOfFailedTestCases;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "cfloat arithmetic validation with CFLOAT_FAST_SPECIALIZATION";
+	std::string test_tag    = "fast specialization";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	static_assert(cfloat<32, 8, uint32_t, true, false, false>::nativeArithmetic, "CFLOAT_FAST_SPECIALIZATION must enable the native arithmetic");
+	static_assert(!cfloat<80, 11, uint32_t, true, false, false>::nativeArithmetic, "configurations with nbits > 64 use the blocktriple path");
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += VerifyArithmetic< cfloat<8, 2, uint8_t, true, false, false> >(true, "cfloat< 8,2,uint8_t,t,f,f>");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += VerifyArithmetic< cfloat<8, 2, uint8_t, false, false, false> >(reportTestCases, "cfloat< 8,2,uint8_t,f,f,f>");
+	nrOfFailedTestCases += VerifyArithmetic< cfloat<8, 2, uint8_t, true,  false, false> >(reportTestCases, "cfloat< 8,2,uint8_t,t,f,f>");
+	nrOfFailedTestCases += VerifyArithmetic< cfloat<8, 2, uint8_t, true,  true,  false> >(reportTestCases, "cfloat< 8,2,uint8_t,t,t,f>");
+	nrOfFailedTestCases += VerifyArithmetic< cfloat<8, 4, uint8_t, true,  true,  false> >(reportTestCases, "cfloat< 8,4,uint8_t,t,t,f>");
+	nrOfFailedTestCases += VerifyArithmetic< cfloat<8, 4, uint8_t, true,  true,  true > >(reportTestCases, "cfloat< 8,4,uint8_t,t,t,t>");
+
+	nrOfFailedTestCases += Randoms< cfloat<32, 8, uint32_t, true, false, false> >(reportTestCases, "cfloat<32,8,uint32_t,t,f,f>", 10000);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += VerifyArithmetic< cfloat<8, 3, uint8_t, true,  false, false> >(reportTestCases, "cfloat< 8,3,uint8_t,t,f,f>");
+	nrOfFailedTestCases += VerifyArithmetic< cfloat<8, 5, uint8_t, true,  true,  false> >(reportTestCases, "cfloat< 8,5,uint8_t,t,t,f>");
+	nrOfFailedTestCases += VerifyArithmetic< cfloat<10, 4, uint16_t, true, false, false> >(reportTestCases, "cfloat<10,4,uint16_t,t,f,f>");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += Randoms< cfloat<16, 5, uint16_t, true, false, false> >(reportTestCases, "cfloat<16,5,uint16_t,t,f,f>", 10000);
+	nrOfFailedTestCases += Randoms< cfloat<16, 8, uint16_t, true, false, false> >(reportTestCases, "cfloat<16,8,uint16_t,t,f,f>", 10000);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += VerifyArithmetic< cfloat<12, 5, uint16_t, true, false, false> >(reportTestCases, "cfloat<12,5,uint16_t,t,f,f>");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
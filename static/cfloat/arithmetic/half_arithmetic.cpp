@@ -0,0 +1,240 @@
+// half_arithmetic.cpp: test suite runner for half-precision cfloat arithmetic computed in float
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <cmath>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/cfloat/mathlib.hpp>
+#include <universal/verification/test_status.hpp>
+#include <universal/verification/test_reporters.hpp>
+
+namespace sw { namespace universal {
+
+	// The sum, product, and quotient of two halfs, and the square root of a half, are computed in double and
+	// rounded once by the generic double to cfloat conversion. Sums and products are exact in double, and double
+	// has more than 2p+2 bits of precision for the quotient and square root, so this is the correctly rounded result.
+	template<typename Half>
+	int VerifyHalfCase(bool reportTestCases, const char* op, const Half& a, const Half& b, const Half& result, double reference) {
+		Half ref(reference);
+		if (ref.isnan()) {
+			if (result.isnan()) return 0;
+		}
+		else {
+			if (result == ref) return 0;
+		}
+		if (reportTestCases) {
+			std::cerr << "FAIL " << to_binary(a) << ' ' << op << ' ' << to_binary(b) << " = " << to_binary(result) << " : " << result
+				<< " != " << to_binary(ref) << " : " << ref << '\n';
+		}
+		return 1;
+	}
+
+	template<typename Half>
+	int VerifyHalfOperands(bool reportTestCases, const Half& a, const Half& b) {
+		double x = double(a), y = double(b);
+		int nrOfFailedTests = 0;
+		nrOfFailedTests += VerifyHalfCase(reportTestCases, "+", a, b, Half(a + b), x + y);
+		nrOfFailedTests += VerifyHalfCase(reportTestCases, "-", a, b, Half(a - b), x - y);
+		nrOfFailedTests += VerifyHalfCase(reportTestCases, "*", a, b, Half(a * b), x * y);
+		if (!b.iszero()) nrOfFailedTests += VerifyHalfCase(reportTestCases, "/", a, b, Half(a / b), x / y);
+		if ((a < b) != (x < y) || (a >= b) != (x >= y)) {
+			if (reportTestCases) std::cerr << "FAIL " << to_binary(a) << " <=> " << to_binary(b) << '\n';
+			++nrOfFailedTests;
+		}
+		return nrOfFailedTests;
+	}
+
+	// all encodings against the special values, random pairs, and pairs of similar magnitude
+	template<typename Half>
+	int VerifyHalfArithmetic(bool reportTestCases, size_t nrOfRandoms) {
+		static_assert(Half::isBinary16, "configuration is not computed in float");
+		std::mt19937_64 engine(0xf16);
+		int nrOfFailedTests = 0;
+
+		Half specials[] = {
+			Half(0), -Half(0), Half(1), Half(-1),
+			Half(SpecificValue::infpos), Half(SpecificValue::infneg), Half(SpecificValue::qnan),
+			Half(SpecificValue::maxpos), Half(SpecificValue::maxneg), Half(SpecificValue::minpos), Half(SpecificValue::minneg)
+		};
+		Half a{}, b{};
+		for (unsigned i = 0; i < 0x10000u; ++i) {
+			a.setbits(i);
+			for (const Half& s : specials) {
+				nrOfFailedTests += VerifyHalfOperands(reportTestCases, a, s);
+				nrOfFailedTests += VerifyHalfOperands(reportTestCases, s, a);
+			}
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+		for (size_t n = 0; n < nrOfRandoms; ++n) {
+			a.setbits(engine() & 0xFFFFu);
+			b.setbits(engine() & 0xFFFFu);
+			nrOfFailedTests += VerifyHalfOperands(reportTestCases, a, b);
+			b.setbits((engine() & 0xFFu) ^ cfloat_native_bits(a));
+			nrOfFailedTests += VerifyHalfOperands(reportTestCases, a, b);
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+		return nrOfFailedTests;
+	}
+
+	// all positive encodings through sqrt
+	template<typename Half>
+	int VerifyHalfSqrt(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		Half a{};
+		for (unsigned i = 0; i < 0x8000u; ++i) {
+			a.setbits(i);
+			nrOfFailedTests += VerifyHalfCase(reportTestCases, "sqrt", a, a, sqrt(a), std::sqrt(double(a)));
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+		return nrOfFailedTests;
+	}
+
+	// all encodings through the scalar and batched conversions: the portable and native binary16 conversions
+	// must agree, and the batched cfloat conversions must agree with the scalar cfloat conversions
+	template<typename Half>
+	int VerifyHalfConversion(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		std::vector<Half> h(0x10000u);
+		for (unsigned i = 0; i < 0x10000u; ++i) {
+			h[i].setbits(i);
+			float f = binary16_to_float(std::uint16_t(i));
+			float p = binary16_to_float_portable(std::uint16_t(i));
+			if (sw::bit_cast<std::uint32_t>(f) != sw::bit_cast<std::uint32_t>(p) && !(std::isnan(f) && std::isnan(p))) {
+				if (reportTestCases) std::cerr << "FAIL binary16 to float " << to_hex(i) << " : " << f << " != " << p << '\n';
+				++nrOfFailedTests;
+			}
+			if (!std::isnan(f) && float_to_binary16_portable(f) != i) {
+				if (reportTestCases) std::cerr << "FAIL float to binary16 " << f << " : " << to_hex(float_to_binary16_portable(f)) << " != " << to_hex(i) << '\n';
+				++nrOfFailedTests;
+			}
+		}
+
+		std::vector<float> f;
+		half_to_float(h, f);
+		for (unsigned i = 0; i < 0x10000u; ++i) {
+			float ref = float(h[i]);
+			if (f[i] != ref && !(std::isnan(f[i]) && std::isnan(ref))) {
+				if (reportTestCases) std::cerr << "FAIL half_to_float " << to_binary(h[i]) << " : " << f[i] << " != " << ref << '\n';
+				++nrOfFailedTests;
+			}
+		}
+		// round trip, and the rounding of the values between consecutive halfs
+		std::vector<Half> r;
+		float_to_half(f, r);
+		for (unsigned i = 0; i < 0x10000u; ++i) {
+			if (!(r[i] == h[i]) && !(r[i].isnan() && h[i].isnan())) {
+				if (reportTestCases) std::cerr << "FAIL float_to_half " << f[i] << " : " << to_binary(r[i]) << " != " << to_binary(h[i]) << '\n';
+				++nrOfFailedTests;
+			}
+		}
+		for (unsigned i = 0; i < 0x10000u; ++i) f[i] = std::nextafter(f[i], 0.0f) * 1.0004f;
+		float_to_half(f, r);
+		for (unsigned i = 0; i < 0x10000u; ++i) {
+			Half ref(f[i]);
+			if (!(r[i] == ref) && !(r[i].isnan() && ref.isnan())) {
+				if (reportTestCases) std::cerr << "FAIL float_to_half " << f[i] << " : " << to_binary(r[i]) << " != " << to_binary(ref) << '\n';
+				++nrOfFailedTests;
+			}
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "cfloat half-precision arithmetic in float";
+	std::string test_tag    = "half arithmetic";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	std::cout << "binary16 conversions : " << (UNIVERSAL_NATIVE_F16C ? "F16C" : (UNIVERSAL_NATIVE_FLOAT16 ? "_Float16" : "portable")) << '\n';
+
+	// only the IEEE-754 binary16 equivalent configuration is computed in float
+	static_assert(cfloat<16, 5, uint16_t, true, false, false>::isBinary16, "half is not computed in float");
+	static_assert(cfloat<16, 5, uint8_t, true, false, false>::isBinary16, "half with uint8_t blocks is not computed in float");
+	static_assert(!cfloat<16, 5, uint16_t, false, false, false>::isBinary16, "half without subnormals is computed in float");
+	static_assert(!cfloat<16, 5, uint16_t, true, true, false>::isBinary16, "half with supernormals is computed in float");
+	static_assert(!cfloat<16, 8, uint16_t, true, false, false>::isBinary16, "cfloat<16,8> is computed in float");
+
+#if MANUAL_TESTING
+
+	using Half = cfloat<16, 5, uint16_t, true, false, false>;
+	Half a(1.0f), b(3.0f);
+	std::cout << to_binary(a / b) << " : " << (a / b) << '\n';
+	std::cout << to_binary(Half(1.0 / 3.0)) << " : " << Half(1.0 / 3.0) << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyHalfConversion< cfloat<16, 5, uint16_t, true, false, false> >(reportTestCases), "cfloat<16,5,uint16_t> tff", "conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyHalfSqrt< cfloat<16, 5, uint16_t, true, false, false> >(reportTestCases), "cfloat<16,5,uint16_t> tff", "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyHalfArithmetic< cfloat<16, 5, uint16_t, true, false, false> >(reportTestCases, 10000), "cfloat<16,5,uint16_t> tff", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyHalfConversion< cfloat<16, 5, uint8_t, true, false, false> >(reportTestCases), "cfloat<16,5,uint8_t> tff", "conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyHalfArithmetic< cfloat<16, 5, uint8_t, true, false, false> >(reportTestCases, 10000), "cfloat<16,5,uint8_t> tff", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyHalfArithmetic< cfloat<16, 5, uint16_t, true, false, false> >(reportTestCases, 100000), "cfloat<16,5,uint16_t> tff", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyHalfArithmetic< cfloat<16, 5, uint32_t, true, false, false> >(reportTestCases, 1000000), "cfloat<16,5,uint32_t> tff", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,184 @@
+// ieee754_delegation.cpp: test suite runner for the hardware delegation of IEEE-754 equivalent cfloat configurations
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <cmath>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/cfloat/mathlib.hpp>
+#include <universal/verification/test_status.hpp>
+#include <universal/verification/test_reporters.hpp>
+
+namespace sw { namespace universal {
+
+	// a cfloat result must have the value of the hardware result, and a NaN must stay a NaN
+	template<typename Cfloat>
+	int VerifyDelegatedCase(bool reportTestCases, const char* op, const Cfloat& a, const Cfloat& b, const Cfloat& result, typename Cfloat::Ieee754Type reference) {
+		if (std::isnan(reference)) {
+			if (result.isnan()) return 0;
+		}
+		else {
+			if (result.to_ieee754() == reference && result.sign() == std::signbit(reference)) return 0;
+		}
+		if (reportTestCases) {
+			std::cerr << "FAIL " << to_binary(a) << ' ' << op << ' ' << to_binary(b) << " = " << to_binary(result) << " : " << result
+				<< " != " << to_binary(reference) << " : " << reference << '\n';
+		}
+		return 1;
+	}
+
+	template<typename Cfloat>
+	int VerifyDelegatedComparison(bool reportTestCases, const char* op, const Cfloat& a, const Cfloat& b, bool result, bool reference) {
+		if (result == reference) return 0;
+		if (reportTestCases) {
+			std::cerr << "FAIL " << to_binary(a) << ' ' << op << ' ' << to_binary(b) << " = " << result << " != " << reference << '\n';
+		}
+		return 1;
+	}
+
+	template<typename Cfloat>
+	int VerifyDelegatedOperands(bool reportTestCases, const Cfloat& a, const Cfloat& b, const Cfloat& c) {
+		using Native = typename Cfloat::Ieee754Type;
+		Native x = a.to_ieee754(), y = b.to_ieee754(), z = c.to_ieee754();
+		int nrOfFailedTests = 0;
+		nrOfFailedTests += VerifyDelegatedCase(reportTestCases, "+", a, b, Cfloat(a + b), x + y);
+		nrOfFailedTests += VerifyDelegatedCase(reportTestCases, "-", a, b, Cfloat(a - b), x - y);
+		nrOfFailedTests += VerifyDelegatedCase(reportTestCases, "*", a, b, Cfloat(a * b), x * y);
+		if (!b.iszero()) nrOfFailedTests += VerifyDelegatedCase(reportTestCases, "/", a, b, Cfloat(a / b), x / y);
+		nrOfFailedTests += VerifyDelegatedCase(reportTestCases, "fma", a, b, fma(a, b, c), std::fma(x, y, z));
+		if (!a.isneg()) nrOfFailedTests += VerifyDelegatedCase(reportTestCases, "sqrt", a, a, sqrt(a), std::sqrt(x));
+		nrOfFailedTests += VerifyDelegatedComparison(reportTestCases, "<",  a, b, a <  b, x <  y);
+		nrOfFailedTests += VerifyDelegatedComparison(reportTestCases, ">",  a, b, a >  b, x >  y);
+		nrOfFailedTests += VerifyDelegatedComparison(reportTestCases, "<=", a, b, a <= b, x <= y);
+		nrOfFailedTests += VerifyDelegatedComparison(reportTestCases, ">=", a, b, a >= b, x >= y);
+		return nrOfFailedTests;
+	}
+
+	// sample random encodings, including operands of similar magnitude, and the special values
+	template<typename Cfloat>
+	int VerifyHardwareDelegation(bool reportTestCases, size_t nrOfRandoms) {
+		static_assert(Cfloat::isIeee754, "configuration is not delegated to the hardware");
+		std::mt19937_64 engine(0x1eee754);
+		constexpr uint64_t mask = (Cfloat::nbits == 64 ? ~0ull : ((1ull << Cfloat::nbits) - 1ull));
+		int nrOfFailedTests = 0;
+
+		Cfloat specials[] = {
+			Cfloat(0), -Cfloat(0), Cfloat(1), Cfloat(-1),
+			Cfloat(SpecificValue::infpos), Cfloat(SpecificValue::infneg), Cfloat(SpecificValue::qnan),
+			Cfloat(SpecificValue::maxpos), Cfloat(SpecificValue::maxneg), Cfloat(SpecificValue::minpos), Cfloat(SpecificValue::minneg)
+		};
+		for (const Cfloat& a : specials) {
+			for (const Cfloat& b : specials) {
+				nrOfFailedTests += VerifyDelegatedOperands(reportTestCases, a, b, b);
+			}
+		}
+
+		Cfloat a{}, b{}, c{};
+		for (size_t n = 0; n < nrOfRandoms; ++n) {
+			a.setbits(engine() & mask);
+			b.setbits(engine() & mask);
+			c.setbits(engine() & mask);
+			nrOfFailedTests += VerifyDelegatedOperands(reportTestCases, a, b, c);
+			b.setbits((engine() & 0xFFull) ^ cfloat_native_bits(a));
+			nrOfFailedTests += VerifyDelegatedOperands(reportTestCases, a, b, -a);
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "cfloat hardware delegation of IEEE-754 equivalent configurations";
+	std::string test_tag    = "hardware delegation";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	// only the IEEE-754 equivalent configurations are delegated
+	static_assert(cfloat<32, 8, uint32_t, true, false, false>::isIeee754, "binary32 equivalent is not delegated");
+	static_assert(cfloat<64, 11, uint8_t, true, false, false>::isIeee754, "binary64 equivalent is not delegated");
+	static_assert(!cfloat<32, 8, uint32_t, false, false, false>::isIeee754, "cfloat without subnormals is delegated");
+	static_assert(!cfloat<32, 8, uint32_t, true, true, false>::isIeee754, "cfloat with supernormals is delegated");
+	static_assert(!cfloat<32, 8, uint32_t, true, false, true>::isIeee754, "saturating cfloat is delegated");
+	static_assert(!cfloat<32, 9, uint32_t, true, false, false>::isIeee754, "cfloat<32,9> is delegated");
+
+#if MANUAL_TESTING
+
+	using Cfloat = cfloat<32, 8, uint32_t, true, false, false>;
+	Cfloat a(1.5f), b(-0.0f);
+	std::cout << to_binary(a + b) << " : " << (a + b) << '\n';
+	std::cout << to_binary(a.to_ieee754() + b.to_ieee754()) << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyHardwareDelegation< cfloat<32, 8, uint32_t, true, false, false> >(reportTestCases, 10000), "cfloat<32,8,uint32_t> tff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyHardwareDelegation< cfloat<64, 11, uint64_t, true, false, false> >(reportTestCases, 10000), "cfloat<64,11,uint64_t> tff", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyHardwareDelegation< cfloat<32, 8, uint8_t, true, false, false> >(reportTestCases, 10000), "cfloat<32,8,uint8_t> tff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyHardwareDelegation< cfloat<64, 11, uint32_t, true, false, false> >(reportTestCases, 10000), "cfloat<64,11,uint32_t> tff", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyHardwareDelegation< cfloat<32, 8, uint16_t, true, false, false> >(reportTestCases, 100000), "cfloat<32,8,uint16_t> tff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyHardwareDelegation< cfloat<64, 11, uint16_t, true, false, false> >(reportTestCases, 100000), "cfloat<64,11,uint16_t> tff", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyHardwareDelegation< cfloat<32, 8, uint32_t, true, false, false> >(reportTestCases, 1000000), "cfloat<32,8,uint32_t> tff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyHardwareDelegation< cfloat<64, 11, uint64_t, true, false, false> >(reportTestCases, 1000000), "cfloat<64,11,uint64_t> tff", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,217 @@
+// native_arithmetic.cpp: test suite runner for the native integer arithmetic of cfloats with nbits <= 64
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <iomanip>
+#include <random>
+// the operators of this test suite use the blocktriple path, which is the reference for the native kernels
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/verification/test_status.hpp>
+#include <universal/verification/test_reporters.hpp>
+
+namespace sw { namespace universal {
+
+	// compare one native kernel result with the blocktriple path
+	template<typename Cfloat, typename Kernel>
+	int VerifyNativeCase(bool reportTestCases, const char* op, const Cfloat& a, const Cfloat& b, const Cfloat& reference, Kernel kernel) {
+		Cfloat result{};
+		if (!kernel(a, b, result)) return 0; // configuration or encoding not covered by the kernel
+		if (result.isnan() && reference.isnan()) return 0;
+		if (result == reference && result.sign() == reference.sign()) return 0;
+		if (reportTestCases) {
+			std::cerr << "FAIL " << to_binary(a) << ' ' << op << ' ' << to_binary(b) << " = " << to_binary(result) << " : " << result
+				<< " != " << to_binary(reference) << " : " << reference << '\n';
+		}
+		return 1;
+	}
+
+	// the reference is the blocktriple path of Cfloat, or the hardware arithmetic of an IEEE-754 type
+	// of at least twice the precision, for which the double rounding is innocuous
+	template<typename Cfloat, typename Reference>
+	Cfloat ReferenceResult(const Cfloat& a, const Cfloat& b, char op) {
+		if constexpr (std::is_same_v<Cfloat, Reference>) {
+			switch (op) {
+			case '+': return a + b;
+			case '-': return a - b;
+			case '*': return a * b;
+			default:  return a / b;
+			}
+		}
+		else {
+			Reference x = Reference(a), y = Reference(b);
+			switch (op) {
+			case '+': return Cfloat(x + y);
+			case '-': return Cfloat(x - y);
+			case '*': return Cfloat(x * y);
+			default:  return Cfloat(x / y);
+			}
+		}
+	}
+
+	template<typename Cfloat, typename Reference = Cfloat>
+	int VerifyNativeOperands(bool reportTestCases, const Cfloat& a, const Cfloat& b) {
+		if (a.isnan() || a.isinf() || a.iszero() || b.isnan() || b.isinf() || b.iszero()) return 0;
+		int nrOfFailedTests = 0;
+		nrOfFailedTests += VerifyNativeCase(reportTestCases, "+", a, b, ReferenceResult<Cfloat, Reference>(a, b, '+'), [](const Cfloat& x, const Cfloat& y, Cfloat& z) { return cfloat_native_add(x, y, z); });
+		nrOfFailedTests += VerifyNativeCase(reportTestCases, "-", a, b, ReferenceResult<Cfloat, Reference>(a, b, '-'), [](const Cfloat& x, const Cfloat& y, Cfloat& z) { return cfloat_native_add(x, Cfloat(-y), z); });
+		nrOfFailedTests += VerifyNativeCase(reportTestCases, "*", a, b, ReferenceResult<Cfloat, Reference>(a, b, '*'), [](const Cfloat& x, const Cfloat& y, Cfloat& z) { return cfloat_native_mul(x, y, z); });
+		nrOfFailedTests += VerifyNativeCase(reportTestCases, "/", a, b, ReferenceResult<Cfloat, Reference>(a, b, '/'), [](const Cfloat& x, const Cfloat& y, Cfloat& z) { return cfloat_native_div(x, y, z); });
+		return nrOfFailedTests;
+	}
+
+	// enumerate all operand pairs of a small cfloat
+	template<typename Cfloat>
+	int VerifyNativeArithmetic(bool reportTestCases) {
+		constexpr size_t NR_VALUES = (size_t(1) << Cfloat::nbits);
+		int nrOfFailedTests = 0;
+		Cfloat a{}, b{};
+		for (size_t i = 0; i < NR_VALUES; ++i) {
+			a.setbits(i);
+			for (size_t j = 0; j < NR_VALUES; ++j) {
+				b.setbits(j);
+				nrOfFailedTests += VerifyNativeOperands(reportTestCases, a, b);
+				if (nrOfFailedTests > 24) return nrOfFailedTests;
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// sample random operand pairs of a large cfloat
+	template<typename Cfloat, typename Reference = Cfloat>
+	int VerifyNativeArithmeticThroughRandoms(bool reportTestCases, size_t nrOfRandoms) {
+		std::mt19937_64 engine(0x5eed);
+		constexpr uint64_t mask = (Cfloat::nbits == 64 ? ~0ull : ((1ull << Cfloat::nbits) - 1ull));
+		int nrOfFailedTests = 0;
+		Cfloat a{}, b{};
+		for (size_t n = 0; n < nrOfRandoms; ++n) {
+			a.setbits(engine() & mask);
+			b.setbits(engine() & mask);
+			nrOfFailedTests += VerifyNativeOperands<Cfloat, Reference>(reportTestCases, a, b);
+			// operands of similar magnitude exercise cancellation and carries
+			b.setbits((a.block(0) ^ (engine() & 0xFFull)) | (cfloat_native_bits(a) & ~0xFFull));
+			nrOfFailedTests += VerifyNativeOperands<Cfloat, Reference>(reportTestCases, a, b);
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+		return nrOfFailedTests;
+	}
+
+	// all combinations of subnormals, supernormals, and saturation of a small configuration
+	template<unsigned nbits, unsigned es, typename bt = std::uint8_t>
+	int VerifyNativeArithmeticEncodings(bool reportTestCases, const std::string& test_tag) {
+		int nrOfFailedTestCases = 0;
+		std::stringstream s;
+		s << "cfloat<" << nbits << ',' << es << '>';
+		if constexpr (es > 1) {
+			nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic< cfloat<nbits, es, bt, false, false, false> >(reportTestCases), s.str() + " fff", test_tag);
+			nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic< cfloat<nbits, es, bt, true,  false, false> >(reportTestCases), s.str() + " tff", test_tag);
+			nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic< cfloat<nbits, es, bt, false, true,  false> >(reportTestCases), s.str() + " ftf", test_tag);
+			nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic< cfloat<nbits, es, bt, false, false, true > >(reportTestCases), s.str() + " fft", test_tag);
+			nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic< cfloat<nbits, es, bt, true,  false, true > >(reportTestCases), s.str() + " tft", test_tag);
+			nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic< cfloat<nbits, es, bt, false, true,  true > >(reportTestCases), s.str() + " ftt", test_tag);
+		}
+		nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic< cfloat<nbits, es, bt, true, true, false> >(reportTestCases), s.str() + " ttf", test_tag);
+		nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic< cfloat<nbits, es, bt, true, true, true > >(reportTestCases), s.str() + " ttt", test_tag);
+		return nrOfFailedTestCases;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "cfloat native integer arithmetic validation against the blocktriple path";
+	std::string test_tag    = "native arithmetic";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	using Cfloat = cfloat<8, 2, uint8_t, true, false, false>;
+	Cfloat a, b, c;
+	a.assign("0b0.00.00011");
+	b.assign("0b0.01.10001");
+	cfloat_native_mul(a, b, c);
+	std::cout << to_binary(a * b) << " : " << (a * b) << '\n';
+	std::cout << to_binary(c) << " : " << c << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += VerifyNativeArithmeticEncodings<6, 1>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyNativeArithmeticEncodings<8, 2>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyNativeArithmeticEncodings<8, 4>(reportTestCases, test_tag);
+
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms< cfloat<16, 5, uint16_t, true, false, false> >(reportTestCases, 10000), "cfloat<16,5> tff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms< cfloat<16, 8, uint16_t, true, false, false> >(reportTestCases, 10000), "cfloat<16,8> tff", test_tag);
+	// the blocktriple path is not correctly rounded for all operands of the larger configurations
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms< cfloat<32, 8, uint32_t, true, false, false>, float >(reportTestCases, 10000), "cfloat<32,8> tff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms< cfloat<64, 11, uint32_t, true, false, false>, double >(reportTestCases, 10000), "cfloat<64,11> tff", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += VerifyNativeArithmeticEncodings<8, 3>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyNativeArithmeticEncodings<8, 5>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyNativeArithmeticEncodings<10, 4, uint16_t>(reportTestCases, test_tag);
+
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms< cfloat<24, 8, uint32_t, true, false, false>, double >(reportTestCases, 10000), "cfloat<24,8> tff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms< cfloat<32, 8, uint8_t, true, false, false>, double >(reportTestCases, 10000), "cfloat<32,8> tff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms< cfloat<64, 11, uint64_t, true, false, false>, double >(reportTestCases, 10000), "cfloat<64,11> tff", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += VerifyNativeArithmeticEncodings<10, 3, uint16_t>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyNativeArithmeticEncodings<10, 5, uint16_t>(reportTestCases, test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += VerifyNativeArithmeticEncodings<12, 5, uint16_t>(reportTestCases, test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -4,6 +4,7 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <universal/utility/directives.hpp>
+#include <random>
 // minimum set of include files to reflect source code dependencies
 //#define ALGORITHM_VERBOSE_OUTPUT
 //#define ALGORITHM_TRACE_DIV
@@ -102,6 +103,45 @@ void ReportIeee754SpecialCases()
 	std::cout << -fa << " / " << -fb << " = " << (-fa / -fb) << " : " << sw::universal::to_binary(-fa / -fb) << '\n';
 }
 
+namespace sw { namespace universal {
+
+	// division of wide cfloats: the product of two 26-bit significands is exact in a double, so the
+	// quotient by either factor must come back exactly, and the quotient of two arbitrary doubles must
+	// leave a residual a - q*b below |b| * ulp(q) / 2, which holds if and only if q is correctly rounded
+	template<typename Cfloat>
+	int VerifyWideDivision(bool reportTestCases, size_t nrOfRandoms) {
+		static_assert(Cfloat::fbits >= 52, "the product of two 26-bit significands does not fit");
+		constexpr int fbits = static_cast<int>(Cfloat::fbits);
+		std::mt19937_64 engine(0xd17);
+		std::uniform_int_distribution<int> scales(-200, 200);
+		int nrOfFailedTests = 0;
+		for (size_t n = 0; n < nrOfRandoms; ++n) {
+			double x = std::ldexp(double((engine() & 0x1FF'FFFFull) | 0x200'0000ull), scales(engine) - 25);
+			double y = std::ldexp(double((engine() & 0x1FF'FFFFull) | 0x200'0000ull), scales(engine) - 25);
+			Cfloat a(x * y), b(y), reference(x);
+			Cfloat result = a / b;
+			if (result != reference) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportBinaryArithmeticError("FAIL", "/", a, b, result, reference);
+			}
+
+			Cfloat c(std::ldexp(double((engine() >> 11) | 0x10'0000'0000'0000ull), scales(engine) - 52));
+			Cfloat d(std::ldexp(double((engine() >> 11) | 0x10'0000'0000'0000ull), scales(engine) - 52));
+			Cfloat q = c / d;
+			// the residual and the bound are exact, so the comparison catches rounding errors near the midpoint
+			Cfloat residual = fma(-q, d, c);
+			Cfloat bound = abs(d) * Cfloat(std::ldexp(1.0, q.scale() - fbits - 1));
+			if (abs(residual) > bound) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportBinaryArithmeticError("FAIL", "/", c, d, q, Cfloat(double(c) / double(d)));
+			}
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
 // Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
 #define MANUAL_TESTING 0
 // REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
@@ -231,6 +271,9 @@ try {
 	nrOfFailedTestCases += ReportTestResult(VerifyBinaryOperatorThroughRandoms< c96  >(reportTestCases, RandomsOp::OPCODE_DIV, nrRandoms), typeid(c96).name(), "division");
 	nrOfFailedTestCases += ReportTestResult(VerifyBinaryOperatorThroughRandoms< c128 >(reportTestCases, RandomsOp::OPCODE_DIV, nrRandoms), typeid(c128).name(), "division");
 
+	nrOfFailedTestCases += ReportTestResult(VerifyWideDivision< c80  >(reportTestCases, 1000), type_tag(c80()), "division");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideDivision< c128 >(reportTestCases, 1000), type_tag(c128()), "division");
+	nrOfFailedTestCases += ReportTestResult(VerifyWideDivision< cfloat<128, 15, uint32_t, true, false, isSaturating> >(reportTestCases, 1000), "cfloat<128,15,uint32_t,t,f,f>", "division");
 #endif
 
 #if REGRESSION_LEVEL_2
@@ -263,6 +306,7 @@ try {
 #endif
 
 #if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyWideDivision< cfloat<256, 19, uint32_t, true, false, isSaturating> >(reportTestCases, 500), "cfloat<256,19,uint32_t,t,f,f>", "division");
 //	nrOfFailedTestCases += ReportTestResult(VerifyCfloatDivision< cfloat<12, 1, uint8_t, hasSubnormals, hasSupernormals, isSaturating> >(reportTestCases), "cfloat<12, 1,uint8_t,f,f,f>", "division");
 	nrOfFailedTestCases += ReportTestResult(VerifyCfloatDivision< cfloat<12, 2, uint8_t, hasSubnormals, hasSupernormals, isSaturating> >(reportTestCases), "cfloat<12, 2,uint8_t,f,f,f>", "division");
 	nrOfFailedTestCases += ReportTestResult(VerifyCfloatDivision< cfloat<12, 3, uint8_t, hasSubnormals, hasSupernormals, isSaturating> >(reportTestCases), "cfloat<12, 3,uint8_t,f,f,f>", "division");
@@ -13,6 +13,112 @@
 #include <universal/verification/test_suite.hpp>
 #include <universal/verification/test_suite_random.hpp>
 #include <universal/verification/cfloat_test_suite.hpp>
+#include <universal/numerics/twosum.hpp>
+
+namespace sw { namespace universal {
+
+	// x*y+z as a double that is rounded to odd. For cfloats with at most 26 significant bits the product
+	// is exact in double precision, and twoSum recovers the rounding error of the sum. The round-to-odd
+	// double has enough bits for the conversion to the cfloat to yield the correctly rounded fma.
+	template<typename Cfloat>
+	double RoundToOddFma(const Cfloat& x, const Cfloat& y, const Cfloat& z) {
+		static_assert(Cfloat::fbits < 26, "product does not fit in a double");
+		double p = double(x) * double(y);
+		double s = p + double(z);
+		if (!std::isfinite(s)) return std::fma(double(x), double(y), double(z));
+		double r{ 0.0 };
+		twoSum(p, double(z), s, r);
+		if (r != 0.0 && (std::bit_cast<uint64_t>(s) & 1ull) == 0) {
+			s = std::nextafter(s, (r > 0.0 ? INFINITY : -INFINITY));
+		}
+		return s;
+	}
+
+	template<typename Cfloat>
+	int VerifyFmaCase(bool reportTestCases, const Cfloat& x, const Cfloat& y, const Cfloat& z, const Cfloat& result, const Cfloat& reference) {
+		if (reference.isnan()) {
+			if (result.isnan()) return 0;
+		}
+		else {
+			if (result == reference && result.sign() == reference.sign()) return 0;
+		}
+		if (reportTestCases) {
+			std::cerr << "FAIL fma(" << x << ", " << y << ", " << z << ") = " << to_binary(result) << " : " << result
+				<< " != " << to_binary(reference) << " : " << reference << '\n';
+		}
+		return 1;
+	}
+
+	// compare fma to the correctly rounded reference: all encodings of x, y, and z when nrOfRandoms is 0
+	template<typename Cfloat>
+	int VerifyFusedMultiplyAdd(bool reportTestCases, size_t nrOfRandoms) {
+		constexpr size_t NR_ENCODINGS = (1ull << (Cfloat::nbits < 16 ? Cfloat::nbits : 16));
+		std::mt19937_64 engine(0xf4a);
+		int nrOfFailedTests = 0;
+		Cfloat x{ 0 }, y{ 0 }, z{ 0 };
+		if (nrOfRandoms == 0) {
+			for (size_t i = 0; i < NR_ENCODINGS; ++i) {
+				x.setbits(i);
+				for (size_t j = 0; j < NR_ENCODINGS; ++j) {
+					y.setbits(j);
+					for (size_t k = 0; k < NR_ENCODINGS; ++k) {
+						z.setbits(k);
+						nrOfFailedTests += VerifyFmaCase(reportTestCases, x, y, z, fma(x, y, z), Cfloat(RoundToOddFma(x, y, z)));
+					}
+				}
+				if (nrOfFailedTests > 24) return nrOfFailedTests;
+			}
+			return nrOfFailedTests;
+		}
+		constexpr uint64_t mask = (Cfloat::nbits < 64 ? ((1ull << Cfloat::nbits) - 1ull) : ~0ull);
+		for (size_t n = 0; n < nrOfRandoms; ++n) {
+			x.setbits(engine() & mask);
+			y.setbits(engine() & mask);
+			z.setbits(engine() & mask);
+			nrOfFailedTests += VerifyFmaCase(reportTestCases, x, y, z, fma(x, y, z), Cfloat(RoundToOddFma(x, y, z)));
+			// an addend close to the negated product exercises the cancellation
+			z = -(x * y);
+			for (uint64_t i = (engine() & 0x3ull); i > 0; --i) ++z;
+			nrOfFailedTests += VerifyFmaCase(reportTestCases, x, y, z, fma(x, y, z), Cfloat(RoundToOddFma(x, y, z)));
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+		return nrOfFailedTests;
+	}
+
+	// random double with a significand of 26 bits and the given scale
+	inline double RandomSignificand26(std::mt19937_64& engine, int scale) {
+		double v = std::ldexp(double((engine() & 0x1FF'FFFFull) | 0x200'0000ull), scale - 25);
+		return (engine() & 1ull) ? -v : v;
+	}
+
+	// fma of wide cfloats on operands with 26-bit significands: x*y+z is exact in a cfloat with at least
+	// 64 fraction bits, and must equal the sum of the twoSum components of the double computation
+	template<typename Cfloat>
+	int VerifyExactFusedMultiplyAdd(bool reportTestCases, size_t nrOfRandoms) {
+		static_assert(Cfloat::fbits >= 64, "the exact result of x*y+z does not fit");
+		std::mt19937_64 engine(0xf4a);
+		std::uniform_int_distribution<int> scales(-60, 60);
+		std::uniform_int_distribution<int> offsets(-8, 8);
+		int nrOfFailedTests = 0;
+		for (size_t n = 0; n < nrOfRandoms; ++n) {
+			int xscale = scales(engine), yscale = scales(engine);
+			double dx = RandomSignificand26(engine, xscale);
+			double dy = RandomSignificand26(engine, yscale);
+			double dz = RandomSignificand26(engine, xscale + yscale + offsets(engine));
+			double s{ 0.0 }, r{ 0.0 };
+			twoSum(dx * dy, dz, s, r);
+			Cfloat x(dx), y(dy), z(dz);
+			Cfloat reference = Cfloat(s) + Cfloat(r);
+			nrOfFailedTests += VerifyFmaCase(reportTestCases, x, y, z, fma(x, y, z), reference);
+			// the addend that cancels the product leaves the rounding error of the double product
+			Cfloat cancel(-(dx * dy));
+			nrOfFailedTests += VerifyFmaCase(reportTestCases, x, y, cancel, fma(x, y, cancel), Cfloat(0));
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
 
 // generate specific test case that you can trace with the trace conditions in posit.hpp
 // for most bugs they are traceable with _trace_conversion and _trace_[add|mul|div]
@@ -48,7 +154,7 @@ void GenerateTestCase(Ty x, Ty y, Ty z) {
 }
 
 // Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
-#define MANUAL_TESTING 1
+#define MANUAL_TESTING 0
 // REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
 // It is the responsibility of the regression test to organize the tests in a quartile progression.
 //#undef REGRESSION_LEVEL_OVERRIDE
@@ -102,19 +208,30 @@ try {
 #else
 
 #if REGRESSION_LEVEL_1
-
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedMultiplyAdd< cfloat< 8, 2, uint8_t, hasSubnormals, hasSupernormals, isSaturating> >(reportTestCases, 10000), "cfloat< 8, 2,uint8_t> fff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedMultiplyAdd< cfloat<16, 5, uint16_t, hasSubnormals, hasSupernormals, isSaturating> >(reportTestCases, 10000), "cfloat<16, 5,uint16_t> fff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedMultiplyAdd< cfloat<16, 5, uint16_t, true, false, false> >(reportTestCases, 10000), "cfloat<16, 5,uint16_t> tff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedMultiplyAdd< cfloat<32, 8, uint32_t, hasSubnormals, hasSupernormals, isSaturating> >(reportTestCases, 10000), "cfloat<32, 8,uint32_t> fff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyExactFusedMultiplyAdd< cfloat<80, 15, uint32_t, hasSubnormals, hasSupernormals, isSaturating> >(reportTestCases, 1000), "cfloat<80,15,uint32_t> fff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyExactFusedMultiplyAdd< cfloat<128, 15, uint32_t, hasSubnormals, hasSupernormals, isSaturating> >(reportTestCases, 1000), "cfloat<128,15,uint32_t> fff", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_2
-
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedMultiplyAdd< cfloat< 8, 2, uint8_t, hasSubnormals, hasSupernormals, isSaturating> >(reportTestCases, 0), "cfloat< 8, 2,uint8_t> fff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedMultiplyAdd< cfloat<24, 8, uint8_t, true, true, false> >(reportTestCases, 10000), "cfloat<24, 8,uint8_t> ttf", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedMultiplyAdd< cfloat<32, 8, uint8_t, true, true, false> >(reportTestCases, 10000), "cfloat<32, 8,uint8_t> ttf", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_3
-
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedMultiplyAdd< cfloat< 8, 3, uint8_t, true, false, false> >(reportTestCases, 0), "cfloat< 8, 3,uint8_t> tff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedMultiplyAdd< cfloat<16, 5, uint16_t, hasSubnormals, hasSupernormals, isSaturating> >(reportTestCases, 1000000), "cfloat<16, 5,uint16_t> fff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyExactFusedMultiplyAdd< cfloat<80, 15, uint8_t, hasSubnormals, hasSupernormals, isSaturating> >(reportTestCases, 10000), "cfloat<80,15,uint8_t> fff", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_4
-
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedMultiplyAdd< cfloat< 8, 2, uint8_t, true, true, false> >(reportTestCases, 0), "cfloat< 8, 2,uint8_t> ttf", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedMultiplyAdd< cfloat<32, 8, uint32_t, hasSubnormals, hasSupernormals, isSaturating> >(reportTestCases, 1000000), "cfloat<32, 8,uint32_t> fff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyExactFusedMultiplyAdd< cfloat<256, 19, uint32_t, hasSubnormals, hasSupernormals, isSaturating> >(reportTestCases, 10000), "cfloat<256,19,uint32_t> fff", test_tag);
 #endif // REGRESSION_LEVEL_4
 
 	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
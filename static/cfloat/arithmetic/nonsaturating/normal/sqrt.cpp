@@ -4,6 +4,7 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <universal/utility/directives.hpp>
+#include <random>
 //#define ALGORITHM_VERBOSE_OUTPUT 1
 //#define ALGORITHM_TRACE_SQRT 1
 #include <universal/number/algorithm/newtons_iteration.hpp>
@@ -61,8 +62,44 @@ void CheckNewtonsIteration(Real value) {
 	std::cout << std::setprecision(precision);
 }
 
+namespace sw { namespace universal {
+
+	// sqrt of wide cfloats: the square of a 26-bit significand is exact in a double, so its root
+	// must come back exactly, and the root of an arbitrary double must leave a residual a - r*r
+	// that is bounded by r * ulp(r) when the root is correctly rounded
+	template<typename Cfloat>
+	int VerifyWideSqrt(bool reportTestCases, size_t nrOfRandoms) {
+		static_assert(Cfloat::fbits >= 52, "the square of a 26-bit significand does not fit");
+		constexpr int fbits = static_cast<int>(Cfloat::fbits);
+		std::mt19937_64 engine(0x5e7);
+		std::uniform_int_distribution<int> scales(-200, 200);
+		int nrOfFailedTests = 0;
+		for (size_t n = 0; n < nrOfRandoms; ++n) {
+			double root = std::ldexp(double((engine() & 0x1FF'FFFFull) | 0x200'0000ull), scales(engine) - 25);
+			Cfloat a(root * root), reference(root);
+			Cfloat result = sqrt(a);
+			if (result != reference) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportUnaryArithmeticError("FAIL", "sqrt", a, result, reference);
+			}
+
+			Cfloat v(std::ldexp(double((engine() >> 11) | 0x10'0000'0000'0000ull), scales(engine) - 52));
+			Cfloat r = sqrt(v);
+			Cfloat residual = fma(-r, r, v);
+			double bound = std::ldexp(1.0, 2 * r.scale() + 1 - fbits);
+			if (std::abs(double(residual)) > bound) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportUnaryArithmeticError("FAIL", "sqrt", v, r, Cfloat(std::sqrt(double(v))));
+			}
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
 // Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
-#define MANUAL_TESTING 1
+#define MANUAL_TESTING 0
 // REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
 // It is the responsibility of the regression test to organize the tests in a quartile progression.
 //#undef REGRESSION_LEVEL_OVERRIDE
@@ -112,21 +149,29 @@ try {
 #else
 
 #if REGRESSION_LEVEL_1
-
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat< 8, 2, uint8_t, hasSubnormals, hasSupernormals, isSaturating> >(reportTestCases), "cfloat< 8,2,uint8_t,fff>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat< 8, 3, uint8_t, true, false, isSaturating> >(reportTestCases), "cfloat< 8,3,uint8_t,tff>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat< 8, 4, uint8_t, true, true, isSaturating> >(reportTestCases), "cfloat< 8,4,uint8_t,ttf>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat<10, 3, uint8_t, true, true, isSaturating> >(reportTestCases), "cfloat<10,3,uint8_t,ttf>", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_2
-
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat<12, 4, uint8_t, true, true, isSaturating> >(reportTestCases), "cfloat<12,4,uint8_t,ttf>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat<16, 5, uint8_t, hasSubnormals, hasSupernormals, isSaturating> >(reportTestCases), "cfloat<16,5,uint8_t,fff>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat<16, 5, uint16_t, true, false, isSaturating> >(reportTestCases), "cfloat<16,5,uint16_t,tff>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyWideSqrt< cfloat< 80, 11, uint32_t, true, false, isSaturating> >(reportTestCases, 1000), "cfloat< 80,11,uint32_t,tff>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyWideSqrt< cfloat<128, 15, uint32_t, true, false, isSaturating> >(reportTestCases, 1000), "cfloat<128,15,uint32_t,tff>", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_3
-
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSqrt< cfloat<18, 5, uint16_t, true, true, isSaturating> >(reportTestCases), "cfloat<18,5,uint16_t,ttf>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyWideSqrt< cfloat<256, 19, uint32_t, true, false, isSaturating> >(reportTestCases, 250), "cfloat<256,19,uint32_t,tff>", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_4
 	using Cfloat64_fff = cfloat<64, 11, uint64_t, hasSubnormals, hasSupernormals, isSaturating>;
 
-	nrOfFailedTestCases += ReportTestResult(VerifyUnaryOperatorThroughRandoms< Cfloat64_fff >(reportTestCases, OPCODE_SQRT, 1000, double(Cfloat64_fff(SpecificValue::minpos))), type_tag(Cfloat64_fff()), "sqrt");
+	nrOfFailedTestCases += ReportTestResult(VerifyUnaryOperatorThroughRandoms< Cfloat64_fff >(reportTestCases, RandomsOp::OPCODE_SQRT, 1000), type_tag(Cfloat64_fff()), "sqrt");
 
 #endif // REGRESSION_LEVEL_4
 
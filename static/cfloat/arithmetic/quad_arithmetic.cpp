@@ -0,0 +1,242 @@
+// quad_arithmetic.cpp: test suite runner for quad-precision cfloat arithmetic computed in __float128
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/cfloat/mathlib.hpp>
+#include <universal/verification/test_status.hpp>
+#include <universal/verification/test_reporters.hpp>
+
+namespace sw { namespace universal {
+
+#if UNIVERSAL_NATIVE_FLOAT128
+	// The reference is the blocktriple emulation of the same encoding: the configuration with supernormals
+	// is not delegated, and shares the encoding of all values below the largest binade with quad.
+	template<typename Quad>
+	using EmulatedQuad = cfloat<128, 15, typename Quad::BlockType, true, true, false>;
+
+	template<typename Cfloat>
+	Cfloat QuadFromBits(native_uint128 raw) {
+		Cfloat v;
+		for (unsigned b = 0; b < Cfloat::nrBlocks; ++b) v.setblock(b, typename Cfloat::BlockType(raw >> (b * Cfloat::bitsInBlock)));
+		return v;
+	}
+
+	template<typename Quad>
+	bool SameEncoding(const Quad& result, const EmulatedQuad<Quad>& reference) {
+		if (reference.isnan()) return result.isnan();
+		for (unsigned b = 0; b < Quad::nrBlocks; ++b) {
+			if (result.block(b) != reference.block(b)) return false;
+		}
+		return true;
+	}
+
+	template<typename Quad>
+	int VerifyQuadCase(bool reportTestCases, const char* op, const Quad& a, const Quad& b, const Quad& result, const EmulatedQuad<Quad>& reference) {
+		// the largest binade of the emulation encodes the supernormals, which are inf and NaN in quad
+		if (reference.issupernormal() || SameEncoding(result, reference)) return 0;
+		if (reportTestCases) {
+			std::cerr << "FAIL " << to_binary(a) << ' ' << op << ' ' << to_binary(b) << "\n   = " << to_binary(result)
+				<< "\n  != " << to_binary(reference) << '\n';
+		}
+		return 1;
+	}
+
+	// a random encoding with an exponent around 1.0, in the subnormal range, or near the extremes of the normal range
+	template<typename Quad>
+	native_uint128 RandomQuadBits(std::mt19937_64& engine) {
+		native_uint128 raw = (native_uint128(engine()) << 64) | engine();
+		native_uint128 fraction = raw & ((native_uint128(1) << 112) - 1);
+		native_uint128 sign = raw & (native_uint128(1) << 127);
+		uint64_t selector = engine() % 8;
+		uint64_t exponent = (selector == 0 ? 0 : (selector == 1 ? 1 + engine() % 64 : (selector == 2 ? 0x7FFE - engine() % 64 : 16383 - 200 + engine() % 400)));
+		return sign | (native_uint128(exponent) << 112) | fraction;
+	}
+
+	template<typename Quad>
+	int VerifyQuadOperands(bool reportTestCases, native_uint128 x, native_uint128 y, native_uint128 z) {
+		using Emulated = EmulatedQuad<Quad>;
+		Quad a = QuadFromBits<Quad>(x), b = QuadFromBits<Quad>(y), c = QuadFromBits<Quad>(z);
+		Emulated ea = QuadFromBits<Emulated>(x), eb = QuadFromBits<Emulated>(y), ec = QuadFromBits<Emulated>(z);
+		int nrOfFailedTests = 0;
+		nrOfFailedTests += VerifyQuadCase(reportTestCases, "+", a, b, Quad(a + b), Emulated(ea + eb));
+		nrOfFailedTests += VerifyQuadCase(reportTestCases, "-", a, b, Quad(a - b), Emulated(ea - eb));
+		nrOfFailedTests += VerifyQuadCase(reportTestCases, "*", a, b, Quad(a * b), Emulated(ea * eb));
+		if (!b.iszero()) nrOfFailedTests += VerifyQuadCase(reportTestCases, "/", a, b, Quad(a / b), Emulated(ea / eb));
+		nrOfFailedTests += VerifyQuadCase(reportTestCases, "fma", a, b, fma(a, b, c), fma(ea, eb, ec));
+		if (!a.sign()) nrOfFailedTests += VerifyQuadCase(reportTestCases, "sqrt", a, a, sqrt(a), sqrt(ea));
+		return nrOfFailedTests;
+	}
+
+	// results that stay below the largest binade, where the delegated and the emulated encodings agree
+	template<typename Quad>
+	int VerifyQuadArithmetic(bool reportTestCases, size_t nrOfRandoms) {
+		static_assert(Quad::isBinary128, "configuration is not computed in __float128");
+		std::mt19937_64 engine(0xf128);
+		int nrOfFailedTests = 0;
+		for (size_t n = 0; n < nrOfRandoms; ++n) {
+			native_uint128 x = RandomQuadBits<Quad>(engine), y = RandomQuadBits<Quad>(engine), z = RandomQuadBits<Quad>(engine);
+			// keep the exponents of the operands of the products and quotients close enough to stay in range
+			if (n % 2) y = (y & ~(native_uint128(0x7FFF) << 112)) | (native_uint128(16383 - 100 + engine() % 200) << 112);
+			nrOfFailedTests += VerifyQuadOperands<Quad>(reportTestCases, x, y, z);
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+		return nrOfFailedTests;
+	}
+
+	// special values follow the cfloat encodings of inf and NaN
+	template<typename Quad>
+	int VerifyQuadSpecialCases(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		Quad zero(0), one(1), inf(SpecificValue::infpos), nan(SpecificValue::qnan);
+		auto check = [&](bool pass, const char* label) {
+			if (!pass) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL " << label << '\n';
+			}
+		};
+		check((one / zero).isinf(), "1 / 0 is inf");
+		check((inf - inf).isnan(), "inf - inf is NaN");
+		check((zero * inf).isnan(), "0 * inf is NaN");
+		check((one + nan).isnan(), "1 + NaN is NaN");
+		check((-inf).isinf() && (-inf).sign(), "-inf");
+		check(Quad(inf + one).isinf(), "inf + 1 is inf");
+		check(sqrt(-one).isnan(), "sqrt(-1) is NaN");
+		check((-zero).iszero() && (-zero).sign(), "-0");
+		check(Quad(SpecificValue::maxpos) + Quad(SpecificValue::maxpos) == inf, "maxpos + maxpos overflows to inf");
+		check(Quad(SpecificValue::minpos) / Quad(2) == zero, "minpos / 2 rounds to zero");
+		return nrOfFailedTests;
+	}
+
+	// conversions from native types are exact, and conversions to double round once
+	template<typename Quad>
+	int VerifyQuadConversion(bool reportTestCases, size_t nrOfRandoms) {
+		using Duble = cfloat<64, 11, uint64_t, true, true, false>;  // the blocktriple rounding of quad to double precision
+		std::mt19937_64 engine(0xd0b1);
+		int nrOfFailedTests = 0;
+		for (size_t n = 0; n < nrOfRandoms; ++n) {
+			double d = sw::bit_cast<double>(engine());
+			if (std::isnan(d)) continue;
+			Quad q(d);
+			if (double(q) != d) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL double round trip " << d << " : " << to_binary(q) << '\n';
+			}
+			float f = float(d);
+			if (!std::isnan(f) && float(Quad(f)) != f) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL float round trip " << f << '\n';
+			}
+			Quad r = QuadFromBits<Quad>(RandomQuadBits<Quad>(engine));
+			Duble reference;
+			convert(r, reference);
+			if (double(r) != double(reference)) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL quad to double " << to_binary(r) << " : " << double(r) << " != " << double(reference) << '\n';
+			}
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+		return nrOfFailedTests;
+	}
+#endif
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "cfloat quad-precision arithmetic in __float128";
+	std::string test_tag    = "quad arithmetic";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if !UNIVERSAL_NATIVE_FLOAT128
+	std::cout << "__float128 is not available: quad is emulated\n";
+	static_assert(!quad::isBinary128, "quad is computed in __float128 without compiler support");
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;
+#else
+	// only the IEEE-754 binary128 equivalent configuration is computed in __float128
+	static_assert(cfloat<128, 15, uint32_t, true, false, false>::isBinary128 == (CFLOAT_FLOAT128_DELEGATION != 0), "quad is not computed in __float128");
+	static_assert(!cfloat<128, 15, uint32_t, true, true, false>::isBinary128, "quad with supernormals is computed in __float128");
+	static_assert(!cfloat<128, 15, uint32_t, false, false, false>::isBinary128, "quad without subnormals is computed in __float128");
+	static_assert(!cfloat<128, 11, uint32_t, true, false, false>::isBinary128, "cfloat<128,11> is computed in __float128");
+
+#if MANUAL_TESTING
+
+	quad a(1.0), b(3.0);
+	std::cout << to_binary(a / b) << " : " << (a / b) << '\n';
+	std::cout << to_binary(EmulatedQuad<quad>(1.0) / EmulatedQuad<quad>(3.0)) << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyQuadSpecialCases< cfloat<128, 15, uint32_t, true, false, false> >(reportTestCases), "cfloat<128,15,uint32_t> tff", "special cases");
+	nrOfFailedTestCases += ReportTestResult(VerifyQuadConversion< cfloat<128, 15, uint32_t, true, false, false> >(reportTestCases, 10000), "cfloat<128,15,uint32_t> tff", "conversion");
+	nrOfFailedTestCases += ReportTestResult(VerifyQuadArithmetic< cfloat<128, 15, uint32_t, true, false, false> >(reportTestCases, 1000), "cfloat<128,15,uint32_t> tff", "arithmetic");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyQuadArithmetic< cfloat<128, 15, uint8_t, true, false, false> >(reportTestCases, 1000), "cfloat<128,15,uint8_t> tff", "arithmetic");
+	nrOfFailedTestCases += ReportTestResult(VerifyQuadArithmetic< cfloat<128, 15, uint64_t, true, false, false> >(reportTestCases, 1000), "cfloat<128,15,uint64_t> tff", "arithmetic");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyQuadArithmetic< cfloat<128, 15, uint32_t, true, false, false> >(reportTestCases, 10000), "cfloat<128,15,uint32_t> tff", "arithmetic");
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyQuadArithmetic< cfloat<128, 15, uint16_t, true, false, false> >(reportTestCases, 100000), "cfloat<128,15,uint16_t> tff", "arithmetic");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+#endif  // UNIVERSAL_NATIVE_FLOAT128
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
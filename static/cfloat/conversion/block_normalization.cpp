@@ -0,0 +1,203 @@
+// block_normalization.cpp: test suite runner for the block-oriented normalization and conversion of multi-block cfloats
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/verification/test_status.hpp>
+#include <universal/verification/test_reporters.hpp>
+
+namespace sw { namespace universal {
+
+	// generate a random finite encoding with a scale in [MIN_EXP_NORMAL - 1, MAX_EXP - 2], a scale of MIN_EXP_NORMAL - 1 yields a subnormal
+	template<typename Cfloat>
+	Cfloat RandomEncoding(std::mt19937_64& engine, bool subnormal = false) {
+		using bt = typename Cfloat::BlockType;
+		Cfloat a;
+		for (unsigned b = 0; b < Cfloat::nrBlocks; ++b) a.setblock(b, bt(engine()));
+		a.setblock(Cfloat::MSU, bt(a.block(Cfloat::MSU) & Cfloat::MSU_MASK));
+		int range = Cfloat::MAX_EXP - Cfloat::MIN_EXP_NORMAL - 1;
+		int scale = (subnormal ? Cfloat::MIN_EXP_NORMAL - 1 : Cfloat::MIN_EXP_NORMAL + static_cast<int>(engine() % static_cast<uint64_t>(range)));
+		a.setexponent(scale);
+		return a;
+	}
+
+	template<typename Cfloat, typename BlockTriple>
+	int VerifyRoundTrip(bool reportTestCases, const char* op, const Cfloat& a, const BlockTriple& b) {
+		Cfloat c;
+		convert(b, c);
+		if (c == a) return 0;
+		if (reportTestCases) std::cerr << "FAIL " << op << " : " << to_binary(a) << " -> " << to_triple(b) << " -> " << to_binary(c) << '\n';
+		return 1;
+	}
+
+	// the normalizations to the blocktriples of the arithmetic operators that are in the form of a result,
+	// and the conversion back, must reproduce the encoding, and the scale of a subnormal must follow from its most significant bit
+	template<typename Cfloat>
+	int VerifyBlockNormalization(bool reportTestCases, size_t nrOfRandoms) {
+		using bt = typename Cfloat::BlockType;
+		constexpr unsigned fbits = Cfloat::fbits;
+		std::mt19937_64 engine(Cfloat::nbits);
+		int nrOfFailedTests = 0;
+		for (size_t n = 0; n < nrOfRandoms; ++n) {
+			Cfloat a = RandomEncoding<Cfloat>(engine, Cfloat::hasSubnormals && (n % 4 == 0));
+			if (a.iszero()) continue;
+			blocktriple<fbits, BlockTripleOperator::REP, bt> rep;
+			blocktriple<fbits, BlockTripleOperator::ADD, bt> add;
+			blocktriple<fbits, BlockTripleOperator::DIV, bt> div;
+			a.normalize(rep);
+			a.normalizeAddition(add);
+			a.normalizeDivision(div);
+			nrOfFailedTests += VerifyRoundTrip(reportTestCases, "REP", a, rep);
+			nrOfFailedTests += VerifyRoundTrip(reportTestCases, "ADD", a, add);
+			nrOfFailedTests += VerifyRoundTrip(reportTestCases, "DIV", a, div);
+			if (a.isdenormal()) {
+				int msb = -1;
+				for (unsigned i = 0; i < fbits; ++i) if (a.test(i)) msb = static_cast<int>(i);
+				if (a.scale() != Cfloat::MIN_EXP_SUBNORMAL + msb || rep.scale() != a.scale()) {
+					++nrOfFailedTests;
+					if (reportTestCases) std::cerr << "FAIL scale of " << to_binary(a) << " : " << a.scale() << " != " << (Cfloat::MIN_EXP_SUBNORMAL + msb) << '\n';
+				}
+			}
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+		return nrOfFailedTests;
+	}
+
+	template<typename Cfloat>
+	int VerifyRoundedCase(bool reportTestCases, const char* op, const Cfloat& a, const Cfloat& b, const Cfloat& result, const Cfloat& reference) {
+		if (result == reference) return 0;
+		if (reportTestCases) {
+			std::cerr << "FAIL " << to_binary(a) << ' ' << op << ' ' << to_binary(b) << "\n   = " << to_binary(result) << "\n  != " << to_binary(reference) << '\n';
+		}
+		return 1;
+	}
+
+	// add half an ulp, just below, and just above half an ulp, to random encodings:
+	// the conversion of the sum must round to nearest, ties to even
+	template<typename Cfloat>
+	int VerifyBlockRounding(bool reportTestCases, size_t nrOfRandoms) {
+		constexpr int fbits = static_cast<int>(Cfloat::fbits);
+		std::mt19937_64 engine(Cfloat::nbits + 1);
+		int nrOfFailedTests = 0;
+		for (size_t n = 0; n < nrOfRandoms; ++n) {
+			Cfloat a = RandomEncoding<Cfloat>(engine);
+			if (a.scale() - fbits - 2 < Cfloat::MIN_EXP_NORMAL) continue;
+			a.setsign(false);
+			Cfloat next(a);
+			++next;
+			Cfloat halfUlp(0), belowHalfUlp(0), aboveHalfUlp(0);
+			halfUlp.setexponent(a.scale() - fbits - 1);
+			aboveHalfUlp.setexponent(a.scale() - fbits - 1);
+			aboveHalfUlp.setbit(0);
+			belowHalfUlp.setexponent(a.scale() - fbits - 2);
+			for (int i = 0; i < fbits; ++i) belowHalfUlp.setbit(static_cast<unsigned>(i));
+			nrOfFailedTests += VerifyRoundedCase(reportTestCases, "+", a, halfUlp, a + halfUlp, (a.test(0) ? next : a));
+			nrOfFailedTests += VerifyRoundedCase(reportTestCases, "+", a, belowHalfUlp, a + belowHalfUlp, a);
+			nrOfFailedTests += VerifyRoundedCase(reportTestCases, "+", a, aboveHalfUlp, a + aboveHalfUlp, next);
+			nrOfFailedTests += VerifyRoundedCase(reportTestCases, "-", -a, aboveHalfUlp, -a - aboveHalfUlp, -next);
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+
+		// 1/3 = 1.0101...b * 2^-2: the fraction bits alternate, and the rounded fraction ends in a 1
+		Cfloat one(1.0), three(3.0), third(0);
+		third.setexponent(-2);
+		for (int i = fbits - 2; i >= 0; i -= 2) third.setbit(static_cast<unsigned>(i));
+		third.setbit(0);
+		nrOfFailedTests += VerifyRoundedCase(reportTestCases, "/", one, three, one / three, third);
+		nrOfFailedTests += VerifyRoundedCase(reportTestCases, "/", -one, three, -one / three, -third);
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "cfloat block-oriented normalization and conversion";
+	std::string test_tag    = "block normalization";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	using Cfloat = cfloat<80, 15, uint32_t, true, false, false>;
+	Cfloat a(1), b(3);
+	std::cout << to_binary(a / b) << " : " << (a / b) << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockNormalization< cfloat< 80, 15, uint32_t, true, false, false> >(reportTestCases, 1000), "cfloat<80,15,uint32_t> tff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockNormalization< cfloat<128, 15, uint32_t, true, false, false> >(reportTestCases, 1000), "cfloat<128,15,uint32_t> tff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockRounding< cfloat< 80, 15, uint32_t, true, false, false> >(reportTestCases, 1000), "cfloat<80,15,uint32_t> tff", "rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockRounding< cfloat<128, 15, uint32_t, true, false, false> >(reportTestCases, 1000), "cfloat<128,15,uint32_t> tff", "rounding");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockNormalization< cfloat< 80, 15, uint8_t, true, false, false> >(reportTestCases, 1000), "cfloat<80,15,uint8_t> tff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockNormalization< cfloat< 80, 15, uint16_t, false, false, false> >(reportTestCases, 1000), "cfloat<80,15,uint16_t> fff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockNormalization< cfloat< 96, 11, uint16_t, true, false, false> >(reportTestCases, 1000), "cfloat<96,11,uint16_t> tff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockRounding< cfloat< 80, 15, uint8_t, true, false, false> >(reportTestCases, 1000), "cfloat<80,15,uint8_t> tff", "rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockRounding< cfloat< 96, 11, uint16_t, true, false, false> >(reportTestCases, 1000), "cfloat<96,11,uint16_t> tff", "rounding");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockNormalization< cfloat<128, 15, uint8_t, true, false, false> >(reportTestCases, 10000), "cfloat<128,15,uint8_t> tff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockRounding< cfloat<128, 15, uint16_t, true, false, false> >(reportTestCases, 10000), "cfloat<128,15,uint16_t> tff", "rounding");
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockNormalization< cfloat<256, 19, uint32_t, true, false, false> >(reportTestCases, 10000), "cfloat<256,19,uint32_t> tff", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockRounding< cfloat<256, 19, uint32_t, true, false, false> >(reportTestCases, 10000), "cfloat<256,19,uint32_t> tff", "rounding");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
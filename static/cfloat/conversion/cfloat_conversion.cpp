@@ -0,0 +1,250 @@
+// cfloat_conversion.cpp: test suite runner for conversions between cfloat configurations
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <random>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// the conversion and the reference agree when their encodings are identical, or when both are NaN
+	template<typename Cfloat>
+	bool SameConversion(const Cfloat& result, const Cfloat& reference) {
+		if (reference.isnan()) return result.isnan() && result.sign() == reference.sign();
+		return result == reference && result.sign() == reference.sign();
+	}
+
+	template<typename Source, typename Target>
+	void ReportConversionError(const std::string& label, const Source& a, const Target& result, const Target& reference) {
+		std::cerr << label << ' ' << to_binary(a) << " : " << a << " -> " << to_binary(result) << " : " << result
+			<< " != " << to_binary(reference) << " : " << reference << '\n';
+	}
+
+	/// <summary>
+	/// enumerate all encodings of the Source configuration and compare the direct conversion to the
+	/// rounding of the value through a double, which is exact for the Source configurations tested.
+	/// The converting constructor and the batched conversion must produce the same encodings.
+	/// </summary>
+	template<typename Source, typename Target>
+	int VerifyCfloatToCfloatConversion(bool reportTestCases) {
+		static_assert(Source::fbits < 53 && Source::es < 11, "the Source configuration is not exactly representable in a double");
+		constexpr size_t NR_ENCODINGS = (size_t(1) << Source::nbits);
+		int nrOfFailedTests = 0;
+		std::vector<Source> src(NR_ENCODINGS);
+		for (size_t i = 0; i < NR_ENCODINGS; ++i) src[i].setbits(i);
+		std::vector<Target> batch;
+		convert(src, batch);
+		for (size_t i = 0; i < NR_ENCODINGS; ++i) {
+			const Source& a = src[i];
+			Target reference;
+			if (a.isnan()) reference.setnan(a.sign() ? NAN_TYPE_SIGNALLING : NAN_TYPE_QUIET); else reference = double(a);
+			if (a.iszero()) reference.setsign(a.sign());
+			Target result;
+			convert(a, result);
+			Target constructed(a);
+			if (!SameConversion(result, reference) || !SameConversion(constructed, reference) || !SameConversion(batch[i], reference)) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportConversionError("FAIL", a, result, reference);
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// widening conversions are exact and round trip
+	template<typename Source, typename Target>
+	int VerifyCfloatWidening(bool reportTestCases) {
+		static_assert(Target::fbits >= Source::fbits && Target::es >= Source::es, "not a widening conversion");
+		constexpr size_t NR_ENCODINGS = (size_t(1) << Source::nbits);
+		int nrOfFailedTests = 0;
+		for (size_t i = 0; i < NR_ENCODINGS; ++i) {
+			Source a, roundtrip;
+			a.setbits(i);
+			Target b(a);
+			convert(b, roundtrip);
+			bool exact = (a.isnan() ? b.isnan() : (a.isinf() ? b.isinf() : double(b) == double(a)));
+			if (!exact || !SameConversion(roundtrip, a)) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportConversionError("FAIL", a, roundtrip, a);
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	/// <summary>
+	/// narrow sums of two doubles, which a wide Source configuration holds exactly, to a Target
+	/// configuration with the precision and range of a double: the single rounding of the exact sum
+	/// is the double sum. The second term is placed at the rounding position to exercise ties.
+	/// </summary>
+	template<typename Source, typename Target>
+	int VerifyWideNarrowing(bool reportTestCases, size_t nrOfRandoms) {
+		static_assert(Target::fbits == 52 && Target::es == 11, "the Target configuration does not round like a double");
+		static_assert(Source::fbits >= 52 + 60, "the Source configuration does not hold the sums exactly");
+		std::mt19937_64 engine(0xc0c0);
+		std::uniform_int_distribution<int> scales(-300, 300);
+		std::uniform_int_distribution<int> spread(50, 60);
+		int nrOfFailedTests = 0;
+		for (size_t n = 0; n < nrOfRandoms; ++n) {
+			double d1 = std::ldexp(double((engine() >> 11) | 0x10'0000'0000'0000ull), scales(engine) - 52);
+			int e = spread(engine);
+			double d2 = std::ldexp(double((engine() >> 11) | 0x10'0000'0000'0000ull), std::ilogb(d1) - e - 52);
+			if (n % 4 == 1) d2 = std::ldexp(1.0, std::ilogb(d1) - 53);   // a tie
+			if (n % 2) d2 = -d2;
+			if (n % 8 == 3) d1 = -d1;
+			Source a = Source(d1) + Source(d2);
+			Target result, reference(d1 + d2);
+			convert(a, result);
+			if (!SameConversion(result, reference)) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportConversionError("FAIL", a, result, reference);
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	/// <summary>
+	/// narrow values of a few significant bits, offset by the lsb of the Source configuration, to a
+	/// much narrower Target configuration: the offset only shows up in the sticky bit, and the single
+	/// rounding of the sum is the rounding of the neighbor of the value in the direction of the offset.
+	/// </summary>
+	template<typename Source, typename Target>
+	int VerifyStickyNarrowing(bool reportTestCases, size_t nrOfRandoms) {
+		static_assert(Source::fbits > 3 * Target::fbits + 4, "the Source bits do not reach past the rounding bits");
+		std::mt19937_64 engine(0x571c);
+		std::uniform_int_distribution<int> scales(Target::MIN_EXP_SUBNORMAL - 2, Target::MAX_EXP + 1);
+		int nrOfFailedTests = 0;
+		for (size_t n = 0; n < nrOfRandoms; ++n) {
+			double d = std::ldexp(double((engine() & 0x3FFull) | 0x400ull), scales(engine) - 10);
+			if (n % 2) d = -d;
+			double offset = std::ldexp((n % 4 < 2 ? 1.0 : -1.0), std::ilogb(d) - static_cast<int>(Source::fbits));
+			Source a = Source(d) + Source(offset);
+			Target result, reference(std::nextafter(d, offset * INFINITY));
+			convert(a, result);
+			if (!SameConversion(result, reference)) {
+				++nrOfFailedTests;
+				if (reportTestCases) ReportConversionError("FAIL", a, result, reference);
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "cfloat to cfloat conversion";
+	std::string test_tag    = "conversion";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	// fp8 (E4M3 and E5M2 layouts), half, bfloat16, and single precision
+	using fp8e4m3  = cfloat< 8, 4, uint8_t, true, false, false>;
+	using fp8e5m2  = cfloat< 8, 5, uint8_t, true, false, false>;
+	using fp16     = cfloat<16, 5, uint16_t, true, false, false>;
+	using bf16     = cfloat<16, 8, uint16_t, true, false, false>;
+	using fp32     = cfloat<32, 8, uint32_t, true, false, false>;
+
+#if MANUAL_TESTING
+
+	{
+		cfloat<8, 2, uint8_t> a(1.5);
+		cfloat<16, 5, uint8_t> b(a);
+		std::cout << to_binary(a) << " : " << a << " -> " << to_binary(b) << " : " << b << '\n';
+	}
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatToCfloatConversion< cfloat<8, 2, uint8_t>, cfloat<6, 2, uint8_t> >(true), "cfloat<8,2> to cfloat<6,2>", test_tag);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore errors
+#else
+
+#if REGRESSION_LEVEL_1
+	// widening
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatWidening< fp8e4m3, fp16 >(reportTestCases), "fp8e4m3 to fp16", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatWidening< fp8e5m2, fp16 >(reportTestCases), "fp8e5m2 to fp16", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatWidening< fp8e4m3, fp32 >(reportTestCases), "fp8e4m3 to fp32", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatWidening< fp16, fp32 >(reportTestCases), "fp16 to fp32", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatWidening< bf16, fp32 >(reportTestCases), "bf16 to fp32", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatWidening< fp16, cfloat<128, 15, uint32_t, true, false, false> >(reportTestCases), "fp16 to cfloat<128,15>", test_tag);
+
+	// narrowing with a single rounding, subnormals, and overflow
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatToCfloatConversion< cfloat<8, 2, uint8_t>, cfloat<6, 2, uint8_t> >(reportTestCases), "cfloat<8,2> to cfloat<6,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatToCfloatConversion< cfloat<10, 4, uint8_t>, cfloat<8, 3, uint8_t> >(reportTestCases), "cfloat<10,4> to cfloat<8,3>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatToCfloatConversion< fp16, fp8e4m3 >(reportTestCases), "fp16 to fp8e4m3", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatToCfloatConversion< fp16, fp8e5m2 >(reportTestCases), "fp16 to fp8e5m2", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatToCfloatConversion< bf16, fp16 >(reportTestCases), "bf16 to fp16", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatToCfloatConversion< fp16, bf16 >(reportTestCases), "fp16 to bf16", test_tag);
+
+	// configurations without subnormals, with supernormals, and saturating
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatToCfloatConversion< cfloat<10, 3, uint8_t, true, true, false>, cfloat<7, 3, uint8_t, false, false, false> >(reportTestCases), "cfloat<10,3,t,t,f> to cfloat<7,3,f,f,f>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatToCfloatConversion< cfloat<10, 3, uint8_t, false, false, false>, cfloat<8, 3, uint8_t, true, true, false> >(reportTestCases), "cfloat<10,3,f,f,f> to cfloat<8,3,t,t,f>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatToCfloatConversion< cfloat<12, 4, uint8_t, true, false, false>, cfloat<8, 2, uint8_t, true, false, true> >(reportTestCases), "cfloat<12,4> to cfloat<8,2,t,f,t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	// different block types
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatToCfloatConversion< cfloat<16, 5, uint8_t, true, false, false>, cfloat<12, 5, uint16_t, true, false, false> >(reportTestCases), "cfloat<16,5,uint8_t> to cfloat<12,5,uint16_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatToCfloatConversion< cfloat<12, 3, uint16_t>, cfloat<24, 6, uint8_t> >(reportTestCases), "cfloat<12,3,uint16_t> to cfloat<24,6,uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatToCfloatConversion< cfloat<14, 5, uint8_t>, cfloat<80, 11, uint32_t> >(reportTestCases), "cfloat<14,5,uint8_t> to cfloat<80,11,uint32_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	// wide to double precision
+	nrOfFailedTestCases += ReportTestResult(VerifyWideNarrowing< cfloat<128, 15, uint32_t, true, false, false>, cfloat<64, 11, uint32_t, true, false, false> >(reportTestCases, 10000), "cfloat<128,15> to cfloat<64,11>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyWideNarrowing< cfloat<128, 15, uint8_t, true, false, false>, cfloat<64, 11, uint16_t, true, true, false> >(reportTestCases, 10000), "cfloat<128,15,uint8_t> to cfloat<64,11,uint16_t,t,t,f>", test_tag);
+
+	// source bits beyond the rounding bits of the target
+	nrOfFailedTestCases += ReportTestResult(VerifyStickyNarrowing< cfloat<32, 8, uint8_t, true, true, false>, fp8e4m3 >(reportTestCases, 10000), "cfloat<32,8,t,t,f> to fp8e4m3", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyStickyNarrowing< cfloat<80, 11, uint16_t, true, false, false>, fp8e5m2 >(reportTestCases, 10000), "cfloat<80,11,uint16_t> to fp8e5m2", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyStickyNarrowing< cfloat<80, 11, uint8_t, true, false, false>, fp16 >(reportTestCases, 10000), "cfloat<80,11,uint8_t> to fp16", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatToCfloatConversion< cfloat<20, 8, uint8_t, true, false, false>, fp16 >(reportTestCases), "cfloat<20,8> to fp16", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
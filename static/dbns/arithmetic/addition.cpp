@@ -4,6 +4,7 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <universal/utility/directives.hpp>
+#include <random>
 #include <universal/number/dbns/dbns.hpp>
 //#include <universal/verification/test_suite.hpp>    // there is a generic VerifyAddition there: we need a trait to break template match
 // in the mean time: explicity bring in the dependencies to get the test running
@@ -56,6 +57,30 @@ namespace sw { namespace universal {
 		return nrOfFailedTestCases;
 	}
 
+	// configurations wider than 8 bits add in the logarithmic domain:
+	// verify against the double reference on random operand pairs
+	template<typename DbnsType>
+	int VerifyRandomAddition(bool reportTestCases, unsigned nrOfRandoms) {
+		std::mt19937_64 generator(DbnsType::nbits * 31 + DbnsType::fbbits);
+		int nrOfFailedTestCases = 0;
+
+		DbnsType a, b, c, cref;
+		for (unsigned i = 0; i < nrOfRandoms; ++i) {
+			a.setbits(generator());
+			b.setbits(generator());
+			double ref = double(a) + double(b);
+			c = a + b;
+			cref = ref;
+			if (c != cref) {
+				if (c.isnan() && cref.isnan()) continue; // NaN non-equivalence
+				++nrOfFailedTestCases;
+				if (reportTestCases) ReportBinaryArithmeticError("FAIL", "+", a, b, c, cref);
+			}
+			if (nrOfFailedTestCases > 24) return nrOfFailedTestCases;
+		}
+		return nrOfFailedTestCases;
+	}
+
 } }  // namespace sw::universal
 
 
@@ -122,6 +147,8 @@ try {
 	nrOfFailedTestCases += ReportTestResult(VerifyAddition<DBNS8_3_sat>(reportTestCases), "dbns<8,3,uint8_t>", test_tag);
 	nrOfFailedTestCases += ReportTestResult(VerifyAddition<DBNS8_4_sat>(reportTestCases), "dbns<8,4,uint8_t>", test_tag);
 
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomAddition<dbns<12, 4, std::uint16_t>>(reportTestCases, 10000), "dbns<12,4,uint16_t>", test_tag);
+
 	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
 	return EXIT_SUCCESS;
 #else
@@ -150,6 +177,12 @@ try {
 	nrOfFailedTestCases += ReportTestResult(VerifyAddition<DBNS8_3_sat>(reportTestCases), "dbns<8,3,uint8_t>", test_tag);
 	nrOfFailedTestCases += ReportTestResult(VerifyAddition<DBNS8_4_sat>(reportTestCases), "dbns<8,4,uint8_t>", test_tag);
 
+	using DBNS12_4_sat = dbns<12, 4, std::uint16_t, Behavior::Saturating>;
+	using DBNS16_8_sat = dbns<16, 8, std::uint16_t, Behavior::Saturating>;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomAddition<DBNS12_4_sat>(reportTestCases, 10000), "dbns<12,4,uint16_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomAddition<DBNS16_8_sat>(reportTestCases, 10000), "dbns<16,8,uint16_t>", test_tag);
+
 #endif
 
 #if REGRESSION_LEVEL_2
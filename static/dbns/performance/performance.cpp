@@ -0,0 +1,154 @@
+// performance.cpp : baseline performance benchmarking of arithmetic operators on the dbns arithmetic type
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include <universal/number/dbns/dbns.hpp>
+#include <universal/verification/test_status.hpp>
+#include <universal/verification/test_reporters.hpp>
+#include <universal/benchmark/performance_runner.hpp>
+
+namespace sw::universal::internal {
+
+	// Generic set of adds and subtracts for a given number system type
+	template<typename Scalar>
+	void AdditionSubtractionWorkload(size_t NR_OPS) {
+		std::vector<Scalar> data = { Scalar(0.75f), Scalar(-0.75f) };
+		Scalar a{ 0 }, b{ 1.0f };
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			a = data[i % 2];
+			b = b + a;
+		}
+		if (b == Scalar(0.1f)) std::cerr << "amazing\n";
+	}
+
+	// the reference implementation of dbns addition: a round trip through double
+	template<typename Scalar>
+	void DoubleRoundTripAdditionSubtractionWorkload(size_t NR_OPS) {
+		std::vector<Scalar> data = { Scalar(0.75f), Scalar(-0.75f) };
+		Scalar a{ 0 }, b{ 1.0f };
+		for (size_t i = 0; i < NR_OPS; ++i) {
+			a = data[i % 2];
+			b = double(b) + double(a);
+		}
+		if (b == Scalar(0.1f)) std::cerr << "amazing\n";
+	}
+
+	// the inner loop of a matrix-matrix multiply: a dot product of a row and a column
+	template<typename Scalar>
+	void DotProductWorkload(size_t NR_OPS) {
+		constexpr size_t N = 64;
+		std::vector<Scalar> row(N), column(N);
+		for (size_t i = 0; i < N; ++i) {
+			row[i] = Scalar(1.0f / float(1 + (i % 7)));
+			column[i] = Scalar(((i % 2) ? -1.0f : 1.0f) * float(1 + (i % 5)));
+		}
+		Scalar sum{ 0 };
+		for (size_t k = 0; k < NR_OPS; k += N) {
+			Scalar dot{ 0 };
+			for (size_t i = 0; i < N; ++i) {
+				dot += row[i] * column[i];
+			}
+			sum = dot;
+		}
+		if (sum == Scalar(0.1f)) std::cerr << "amazing\n";
+	}
+
+	/*
+	October 17th, 2026, 1 core of a Linux container, gcc 12 -O3
+
+	Arithmetic operator performance
+	dbns< 8, 3, uint8_t >   add/subtract       1048576 per      0.00586749sec -> 178 Mops/sec
+	dbns< 8, 3, uint8_t >   double add         1048576 per       0.0618718sec ->  16 Mops/sec
+	dbns<12, 4, uint16_t>   add/subtract       1048576 per       0.0976135sec ->  10 Mops/sec
+	dbns<12, 4, uint16_t>   double add         1048576 per       0.0726074sec ->  14 Mops/sec
+	dbns<16, 8, uint16_t>   add/subtract       1048576 per        0.465696sec ->   2 Mops/sec
+	dbns<16, 8, uint16_t>   double add         1048576 per        0.445544sec ->   2 Mops/sec
+	dbns< 8, 3, uint8_t >   dot product        1048576 per       0.0686588sec ->  15 Mops/sec
+	dbns<12, 4, uint16_t>   dot product        1048576 per        0.180702sec ->   5 Mops/sec
+
+	The tabulated adder of the small configurations is an order of magnitude faster than the
+	double round trip. The larger configurations are bound by the nearest-representation search,
+	which is shared with the conversion from double, and the dot product by the multiplier.
+	*/
+
+	void TestArithmeticOperatorPerformance() {
+		using namespace sw::universal;
+		std::cout << "\nArithmetic operator performance\n";
+
+		size_t NR_OPS = 1024ull * 1024ull;
+		PerformanceRunner("dbns< 8, 3, uint8_t >   add/subtract   ", AdditionSubtractionWorkload< dbns< 8, 3, uint8_t> >, NR_OPS);
+		PerformanceRunner("dbns< 8, 3, uint8_t >   double add     ", DoubleRoundTripAdditionSubtractionWorkload< dbns< 8, 3, uint8_t> >, NR_OPS);
+		PerformanceRunner("dbns<12, 4, uint16_t>   add/subtract   ", AdditionSubtractionWorkload< dbns<12, 4, uint16_t> >, NR_OPS);
+		PerformanceRunner("dbns<12, 4, uint16_t>   double add     ", DoubleRoundTripAdditionSubtractionWorkload< dbns<12, 4, uint16_t> >, NR_OPS);
+		PerformanceRunner("dbns<16, 8, uint16_t>   add/subtract   ", AdditionSubtractionWorkload< dbns<16, 8, uint16_t> >, NR_OPS);
+		PerformanceRunner("dbns<16, 8, uint16_t>   double add     ", DoubleRoundTripAdditionSubtractionWorkload< dbns<16, 8, uint16_t> >, NR_OPS);
+
+		PerformanceRunner("dbns< 8, 3, uint8_t >   dot product    ", DotProductWorkload< dbns< 8, 3, uint8_t> >, NR_OPS);
+		PerformanceRunner("dbns<12, 4, uint16_t>   dot product    ", DotProductWorkload< dbns<12, 4, uint16_t> >, NR_OPS);
+	}
+
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+	using namespace sw::universal::internal;
+
+	std::string test_suite  = "dbns operator performance benchmarking";
+	std::string test_tag    = "performance";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	TestArithmeticOperatorPerformance();
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	TestArithmeticOperatorPerformance();
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << '\n';
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
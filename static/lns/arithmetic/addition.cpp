@@ -4,6 +4,7 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <universal/utility/directives.hpp>
+#include <random>
 #include <universal/number/lns/lns.hpp>
 //#include <universal/verification/test_suite.hpp>    // there is a generic VerifyAddition there: we need a trait to break template match
 // in the mean time: explicity bring in the dependencies to get the test running
@@ -58,6 +59,32 @@ namespace sw { namespace universal {
 		return nrOfFailedTestCases;
 	}
 
+	// configurations with rbits > 8 interpolate or evaluate the Gaussian logarithms,
+	// so the sum is allowed to deviate one encoding from the correctly rounded reference.
+	// The dynamic range of the configuration must fit in a double for the reference to be valid.
+	template<typename LnsType>
+	int VerifyRandomAddition(bool reportTestCases, unsigned nrOfRandoms) {
+		std::mt19937_64 generator(LnsType::nbits * 31 + LnsType::rbits);
+		int nrOfFailedTestCases = 0;
+
+		LnsType a, b, c, cref, below, above;
+		for (unsigned i = 0; i < nrOfRandoms; ++i) {
+			a.setbits(generator());
+			b.setbits(generator());
+			double ref = double(a) + double(b);
+			c = a + b;
+			cref = ref;
+			if (c == cref || (c.isnan() && cref.isnan())) continue;
+			below = cref; --below;
+			above = cref; ++above;
+			if (c == below || c == above) continue;
+			++nrOfFailedTestCases;
+			if (reportTestCases) ReportBinaryArithmeticError("FAIL", "+", a, b, c, cref);
+			if (nrOfFailedTestCases > 24) return nrOfFailedTestCases;
+		}
+		return nrOfFailedTestCases;
+	}
+
 } }  // namespace sw::universal
 
 
@@ -119,6 +146,13 @@ try {
 	nrOfFailedTestCases += ReportTestResult(VerifyAddition<LNS5_2_sat>(reportTestCases), "lns<5,2,uint8_t>", test_tag);
 	nrOfFailedTestCases += ReportTestResult(VerifyAddition<LNS8_3_sat>(reportTestCases), "lns<8,3,uint8_t>", test_tag);
 
+	using LNS16_10_sat = lns<16, 10, std::uint16_t>;
+	using LNS20_12_sat = lns<20, 12, std::uint32_t>;
+	using LNS32_24_sat = lns<32, 24, std::uint32_t>;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomAddition<LNS16_10_sat>(reportTestCases, 10000), "lns<16,10,uint16_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomAddition<LNS20_12_sat>(reportTestCases, 10000), "lns<20,12,uint32_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomAddition<LNS32_24_sat>(reportTestCases, 10000), "lns<32,24,uint32_t>", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_2
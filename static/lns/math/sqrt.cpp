@@ -0,0 +1,105 @@
+// sqrt.cpp: test suite runner for the square root function
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/verification/lns_math_test_suite.hpp>
+
+// generate specific test case that you can trace with the trace conditions in lns.hpp
+// for most bugs they are traceable with _trace_conversion and _trace_add
+template<size_t nbits, size_t rbits, typename bt, typename Ty>
+void GenerateTestCase(Ty a) {
+	Ty ref;
+	sw::universal::lns<nbits, rbits, bt> pa{}, pref{}, psqrt{};
+	pa = a;
+	ref = std::sqrt(a);
+	pref = ref;
+	psqrt = sw::universal::sqrt(pa);
+	std::cout << std::setprecision(nbits - 2);
+	std::cout << std::setw(nbits) << a << " -> sqrt(" << a << ") = " << std::setw(nbits) << ref << std::endl;
+	std::cout << sw::universal::to_binary(pa) << " -> sqrt( " << pa << ") = " << sw::universal::to_binary(psqrt) << " (reference: " << sw::universal::to_binary(pref) << ")   ";
+	std::cout << (pref == psqrt ? "PASS" : "FAIL") << std::endl << std::endl;
+	std::cout << std::setprecision(5);
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "lns<> mathlib square root validation";
+	std::string test_tag    = "sqrt";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+	// generate individual testcases to hand trace/debug
+	GenerateTestCase<16, 5, uint16_t>(2.0f);
+
+	nrOfFailedTestCases += ReportTestResult(VerifySqrt< lns<8, 4, uint8_t> >(reportTestCases), "lns<8,4>", test_tag);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifySqrt< lns< 8, 2, uint8_t> >(reportTestCases), "lns<8,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifySqrt< lns< 8, 4, uint8_t> >(reportTestCases), "lns<8,4>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifySqrt< lns<10, 3, uint8_t> >(reportTestCases), "lns<10,3>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifySqrt< lns<12, 4, uint16_t> >(reportTestCases), "lns<12,4>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifySqrt< lns<16, 5, uint16_t> >(reportTestCases), "lns<16,5>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifySqrt< lns<16, 10, uint16_t> >(reportTestCases), "lns<16,10>", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
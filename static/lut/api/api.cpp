@@ -0,0 +1,161 @@
+// api.cpp: application programming interface tests for the lookup-table arithmetic adapter
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/number/lut/lut.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// the batch API must produce the same encodings as the scalar operators
+	template<typename Ty>
+	int VerifyBatchApi(bool reportTestCases) {
+		constexpr size_t N = 1024;
+		int nrOfFailedTests = 0;
+		std::vector< lut<Ty> > x(N), y(N), z;
+		for (size_t i = 0; i < N; ++i) {
+			x[i].setbits(i * 7u + 3u);
+			y[i].setbits(i * 13u + 1u);
+		}
+		LutOperator ops[] = { LutOperator::ADD, LutOperator::SUB, LutOperator::MUL, LutOperator::DIV };
+		for (LutOperator op : ops) {
+			lut_batch(op, x, y, z);
+			for (size_t i = 0; i < N; ++i) {
+				lut<Ty> ref;
+				switch (op) {
+				case LutOperator::ADD: ref = x[i] + y[i]; break;
+				case LutOperator::SUB: ref = x[i] - y[i]; break;
+				case LutOperator::MUL: ref = x[i] * y[i]; break;
+				case LutOperator::DIV: ref = x[i] / y[i]; break;
+				}
+				if (z[i].bits() != ref.bits()) {
+					++nrOfFailedTests;
+					if (reportTestCases) std::cerr << "FAIL batch operator " << unsigned(op) << " at " << i << '\n';
+				}
+			}
+		}
+
+		// scalar times vector through a single row of the table
+		std::vector<std::uint8_t> a(N), c(N);
+		for (size_t i = 0; i < N; ++i) a[i] = y[i].bits();
+		lut<Ty> alpha(0.5);
+		lut_batch<Ty>(LutOperator::MUL, alpha.bits(), a.data(), c.data(), N);
+		for (size_t i = 0; i < N; ++i) {
+			if (c[i] != (alpha * y[i]).bits()) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL scaled batch at " << i << '\n';
+			}
+		}
+
+		// dot product with the rounding of Ty after every step
+		lut<Ty> dot = lut_dot(x, y);
+		Ty sum(0);
+		for (size_t i = 0; i < N; ++i) sum += Ty(x[i]) * Ty(y[i]);
+		if (dot.bits() != lut_encoding(sum)) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL dot product " << dot << " reference " << sum << '\n';
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "lookup-table arithmetic API";
+	std::string test_tag    = "api";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	// construction, conversion, and arithmetic through the tables
+	{
+		using Scalar = lut< posit<8, 2> >;
+		Scalar a(1.5), b(0.5f), c;
+		c = a * b + Scalar(2);
+		std::cout << type_tag(c) << " : " << to_binary(c) << " : " << c << '\n';
+		if (double(c) != 2.75) ++nrOfFailedTestCases;
+		if (!(a > b) || a == b) ++nrOfFailedTestCases;
+		c = -c;
+		if (double(c) != -2.75) ++nrOfFailedTestCases;
+	}
+	{
+		using Scalar = lut< cfloat<8, 2, uint8_t, true, false, false> >;
+		Scalar a(SpecificValue::maxpos), b(1), c;
+		c = a + b;
+		std::cout << type_tag(c) << " : " << to_binary(c) << " : " << c << '\n';
+		if (double(c) != double(cfloat<8, 2, uint8_t, true, false, false>(SpecificValue::maxpos) + 1)) ++nrOfFailedTestCases;
+	}
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchApi< posit<8, 0> >(true), "lut<posit<8,0>>", "batch");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchApi< posit<8, 0> >(reportTestCases), "lut<posit<8,0>>", "batch");
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchApi< posit<8, 2> >(reportTestCases), "lut<posit<8,2>>", "batch");
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchApi< cfloat<8, 2, uint8_t, true, false, false> >(reportTestCases), "lut<cfloat<8,2>>", "batch");
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchApi< lns<8, 3, uint8_t> >(reportTestCases), "lut<lns<8,3>>", "batch");
+#endif
+
+#if REGRESSION_LEVEL_2
+#endif
+
+#if REGRESSION_LEVEL_3
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
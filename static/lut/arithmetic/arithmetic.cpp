@@ -0,0 +1,161 @@
+// arithmetic.cpp: exhaustive verification of lookup-table arithmetic against the arithmetic of the number system
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/number/lut/lut.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// enumerate all operand pairs and compare the encoding of the table lookup to the encoding computed by Ty
+	template<typename Ty>
+	int VerifyLookupArithmetic(LutOperator op, bool reportTestCases) {
+		constexpr unsigned NR_ENCODINGS = (1u << Ty::nbits);
+		int nrOfFailedTests = 0;
+		Ty a, b, ref;
+		lut<Ty> la{}, lb{}, lc{};
+		for (unsigned i = 0; i < NR_ENCODINGS; ++i) {
+			a.setbits(i);
+			la.setbits(i);
+			for (unsigned j = 0; j < NR_ENCODINGS; ++j) {
+				b.setbits(j);
+				lb.setbits(j);
+				switch (op) {
+				case LutOperator::ADD: ref = a + b; lc = la + lb; break;
+				case LutOperator::SUB: ref = a - b; lc = la - lb; break;
+				case LutOperator::MUL: ref = a * b; lc = la * lb; break;
+				case LutOperator::DIV: 
+					if (b.iszero()) continue;
+					ref = a / b; lc = la / lb; break;
+				}
+				if (lc.bits() != lut_encoding(ref)) {
+					++nrOfFailedTests;
+					if (reportTestCases) std::cerr << "FAIL " << to_binary(a) << " op " << to_binary(b) << " = " << to_binary(lc) << " reference " << to_binary(ref) << '\n';
+				}
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	template<typename Ty>
+	int VerifyLookupArithmetic(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		nrOfFailedTests += VerifyLookupArithmetic<Ty>(LutOperator::ADD, reportTestCases);
+		nrOfFailedTests += VerifyLookupArithmetic<Ty>(LutOperator::SUB, reportTestCases);
+		nrOfFailedTests += VerifyLookupArithmetic<Ty>(LutOperator::MUL, reportTestCases);
+		nrOfFailedTests += VerifyLookupArithmetic<Ty>(LutOperator::DIV, reportTestCases);
+		return nrOfFailedTests;
+	}
+
+	// negation and conversion to double of every encoding
+	template<typename Ty>
+	int VerifyLookupNegationAndConversion(bool reportTestCases) {
+		constexpr unsigned NR_ENCODINGS = (1u << Ty::nbits);
+		int nrOfFailedTests = 0;
+		Ty a;
+		lut<Ty> la;
+		for (unsigned i = 0; i < NR_ENCODINGS; ++i) {
+			a.setbits(i);
+			la.setbits(i);
+			if ((-la).bits() != lut_encoding(Ty(-a))) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL negation of " << to_binary(a) << '\n';
+			}
+			double da = double(a), dla = double(la);
+			if (da != dla && !(da != da && dla != dla)) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL conversion of " << to_binary(a) << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "lookup-table arithmetic validation";
+	std::string test_tag    = "arithmetic";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupArithmetic< posit<8, 0> >(LutOperator::ADD, true), "lut<posit<8,0>>", "add");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupArithmetic< posit<8, 0> >(reportTestCases), "lut<posit<8,0>>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupArithmetic< posit<8, 2> >(reportTestCases), "lut<posit<8,2>>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupArithmetic< cfloat<8, 2, uint8_t, true, false, false> >(reportTestCases), "lut<cfloat<8,2>>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupArithmetic< cfloat<8, 4, uint8_t, true, true, false> >(reportTestCases), "lut<cfloat<8,4>>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupArithmetic< lns<8, 3, uint8_t> >(reportTestCases), "lut<lns<8,3>>", test_tag);
+
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupNegationAndConversion< posit<8, 2> >(reportTestCases), "lut<posit<8,2>>", "negate/convert");
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupNegationAndConversion< cfloat<8, 2, uint8_t, true, false, false> >(reportTestCases), "lut<cfloat<8,2>>", "negate/convert");
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupNegationAndConversion< lns<8, 3, uint8_t> >(reportTestCases), "lut<lns<8,3>>", "negate/convert");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupArithmetic< posit<8, 1> >(reportTestCases), "lut<posit<8,1>>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupArithmetic< cfloat<6, 2, uint8_t, true, false, false> >(reportTestCases), "lut<cfloat<6,2>>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
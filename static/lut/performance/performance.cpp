@@ -0,0 +1,177 @@
+// performance.cpp : performance benchmarking of lookup-table arithmetic against the arithmetic of the number system
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/number/lut/lut.hpp>
+#include <universal/verification/test_status.hpp>
+#include <universal/verification/test_reporters.hpp>
+#include <universal/benchmark/performance_runner.hpp>
+
+namespace sw::universal::internal {
+
+	// the inner loop of a matrix-matrix multiply: multiply-add over a row and a column
+	template<typename Scalar>
+	void DotProductWorkload(size_t NR_OPS) {
+		constexpr size_t N = 64;
+		std::vector<Scalar> row(N), column(N);
+		for (size_t i = 0; i < N; ++i) {
+			row[i] = Scalar(1.0f / float(1 + (i % 7)));
+			column[i] = Scalar(((i % 2) ? -1.0f : 1.0f) * float(1 + (i % 5)));
+		}
+		Scalar sum{ 0 };
+		for (size_t k = 0; k < NR_OPS; k += N) {
+			Scalar dot{ 0 };
+			for (size_t i = 0; i < N; ++i) {
+				dot += row[i] * column[i];
+			}
+			sum = dot;
+		}
+		if (sum == Scalar(0.1f)) std::cerr << "amazing\n";
+	}
+
+	// the same inner loop through the batch API
+	template<typename Ty>
+	void BatchDotProductWorkload(size_t NR_OPS) {
+		constexpr size_t N = 64;
+		std::vector< lut<Ty> > row(N), column(N);
+		for (size_t i = 0; i < N; ++i) {
+			row[i] = 1.0f / float(1 + (i % 7));
+			column[i] = ((i % 2) ? -1.0f : 1.0f) * float(1 + (i % 5));
+		}
+		lut<Ty> sum{ 0 };
+		for (size_t k = 0; k < NR_OPS; k += N) {
+			sum = lut_dot(row, column);
+		}
+		if (sum == lut<Ty>(0.1f)) std::cerr << "amazing\n";
+	}
+
+	// elementwise products of two arrays
+	template<typename Ty>
+	void BatchMultiplicationWorkload(size_t NR_OPS) {
+		constexpr size_t N = 1024;
+		std::vector< lut<Ty> > x(N), y(N), z(N);
+		for (size_t i = 0; i < N; ++i) {
+			x[i].setbits(i * 7u + 3u);
+			y[i].setbits(i * 13u + 1u);
+		}
+		for (size_t k = 0; k < NR_OPS; k += N) {
+			lut_batch(LutOperator::MUL, x, y, z);
+			x.swap(z);
+		}
+		if (x[0] == lut<Ty>(0.1f)) std::cerr << "amazing\n";
+	}
+
+	/*
+	October 17th, 2026, 1 core of a Linux container, gcc 12 -O3
+
+	Lookup-table arithmetic performance
+	posit<8,2>        dot product        1048576 per        0.204444sec ->   5 Mops/sec
+	lut<posit<8,2>>   dot product        1048576 per       0.0020999sec -> 499 Mops/sec
+	lut<posit<8,2>>   batch dot          1048576 per      0.00168346sec -> 622 Mops/sec
+	lut<posit<8,2>>   batch multiply     1048576 per     0.000720496sec ->   1 Gops/sec
+	cfloat<8,2>       dot product        1048576 per        0.011694sec ->  89 Mops/sec
+	lut<cfloat<8,2>>  dot product        1048576 per      0.00204643sec -> 512 Mops/sec
+	lut<cfloat<8,2>>  batch multiply     1048576 per     0.000486074sec ->   2 Gops/sec
+	lns<8,3>          dot product        1048576 per      0.00560594sec -> 187 Mops/sec
+	lut<lns<8,3>>     dot product        1048576 per      0.00208283sec -> 503 Mops/sec
+	lut<lns<8,3>>     batch multiply     1048576 per     0.000489033sec ->   2 Gops/sec
+
+	A table lookup costs the same for every number system, so the speedup is largest for the
+	number systems with the most expensive decode and round pipeline. The tables of an 8-bit
+	number system take 4 x 64KB, and are generated on first use.
+	*/
+
+	void TestLookupArithmeticPerformance() {
+		using namespace sw::universal;
+		std::cout << "\nLookup-table arithmetic performance\n";
+
+		using Posit  = posit<8, 2>;
+		using Cfloat = cfloat<8, 2, uint8_t, true, false, false>;
+		using Lns    = lns<8, 3, uint8_t>;
+
+		// generate the tables up front so that the measurements do not include their construction
+		LutTables<Posit>::instance();
+		LutTables<Cfloat>::instance();
+		LutTables<Lns>::instance();
+
+		size_t NR_OPS = 1024ull * 1024ull;
+		PerformanceRunner("posit<8,2>        dot product    ", DotProductWorkload< Posit >, NR_OPS);
+		PerformanceRunner("lut<posit<8,2>>   dot product    ", DotProductWorkload< lut<Posit> >, NR_OPS);
+		PerformanceRunner("lut<posit<8,2>>   batch dot      ", BatchDotProductWorkload< Posit >, NR_OPS);
+		PerformanceRunner("lut<posit<8,2>>   batch multiply ", BatchMultiplicationWorkload< Posit >, NR_OPS);
+		PerformanceRunner("cfloat<8,2>       dot product    ", DotProductWorkload< Cfloat >, NR_OPS);
+		PerformanceRunner("lut<cfloat<8,2>>  dot product    ", DotProductWorkload< lut<Cfloat> >, NR_OPS);
+		PerformanceRunner("lut<cfloat<8,2>>  batch multiply ", BatchMultiplicationWorkload< Cfloat >, NR_OPS);
+		PerformanceRunner("lns<8,3>          dot product    ", DotProductWorkload< Lns >, NR_OPS);
+		PerformanceRunner("lut<lns<8,3>>     dot product    ", DotProductWorkload< lut<Lns> >, NR_OPS);
+		PerformanceRunner("lut<lns<8,3>>     batch multiply ", BatchMultiplicationWorkload< Lns >, NR_OPS);
+	}
+
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+	using namespace sw::universal::internal;
+
+	std::string test_suite  = "lookup-table arithmetic performance benchmarking";
+	std::string test_tag    = "performance";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	TestLookupArithmeticPerformance();
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	TestLookupArithmeticPerformance();
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << '\n';
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,168 @@
+// encoding.cpp: test suite runner for the decode and encode of the generic posit encodings
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <cmath>
+#include <random>
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/number/posit/posit.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// reference decode of a posit encoding that walks the bits one at a time
+	template<unsigned nbits, unsigned es>
+	double ReferenceDecode(uint64_t raw) {
+		constexpr uint64_t mask = (nbits == 64 ? ~0ull : (1ull << (nbits % 64)) - 1ull);
+		bool s = (raw >> (nbits - 1)) & 1u;
+		if (s) raw = (~raw + 1ull) & mask;
+		int bit = static_cast<int>(nbits) - 2;
+		bool r = (raw >> bit) & 1u;
+		int m = 0;
+		while (bit >= 0 && (((raw >> bit) & 1u) != 0) == r) { ++m; --bit; }
+		int k = (r ? m - 1 : -m);
+		--bit; // skip the regime termination bit
+		int e = 0;
+		for (unsigned i = 0; i < es; ++i) {
+			e <<= 1;
+			if (bit >= 0) e |= static_cast<int>((raw >> bit) & 1u);
+			--bit;
+		}
+		double f = 1.0;
+		for (double weight = 0.5; bit >= 0; --bit, weight /= 2.0) {
+			if ((raw >> bit) & 1u) f += weight;
+		}
+		double v = std::ldexp(f, k * (1 << es) + e);
+		return (s ? -v : v);
+	}
+
+	// decode a posit into (sign, scale, fraction), compare its value to the reference decode, and encode
+	// the triple back into a posit, which must reproduce the original encoding. Posits of up to 16 bits
+	// are enumerated, larger posits are sampled with random encodings.
+	template<unsigned nbits, unsigned es>
+	int VerifyDecodeEncode(bool reportTestCases, uint64_t nrRandoms = 0) {
+		using Posit = posit<nbits, es>;
+		constexpr uint64_t mask = (nbits == 64 ? ~0ull : (1ull << (nbits % 64)) - 1ull);
+		constexpr bool exhaustive = (nbits <= 16);
+		uint64_t nrTestCases = (exhaustive ? (1ull << (nbits % 64)) : nrRandoms);
+		std::mt19937_64 generator;
+		int nrOfFailedTestCases = 0;
+		for (uint64_t i = 0; i < nrTestCases; ++i) {
+			uint64_t raw = (exhaustive ? i : (generator() & mask));
+			Posit a, b;
+			a.setbits(raw);
+			if (a.iszero() || a.isnar()) continue;
+			internal::value<Posit::fbits> v = a.to_value();
+			convert(v, b);
+			bool fail = (a != b);
+			if constexpr (Posit::fbits < 53) {
+				fail = fail || (v.to_double() != ReferenceDecode<nbits, es>(raw));
+			}
+			if (fail) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: " << to_binary(a) << " decodes to " << v << " which encodes to " << to_binary(b) << '\n';
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "posit decode and encode verification";
+	std::string test_tag    = "decode/encode";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodeEncode<40, 2>(reportTestCases, 1000), "posit<40,2>", test_tag);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodeEncode< 2, 0>(reportTestCases), "posit< 2,0>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodeEncode< 3, 1>(reportTestCases), "posit< 3,1>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodeEncode< 5, 3>(reportTestCases), "posit< 5,3>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodeEncode< 8, 0>(reportTestCases), "posit< 8,0>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodeEncode<10, 3>(reportTestCases), "posit<10,3>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodeEncode<12, 1>(reportTestCases), "posit<12,1>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodeEncode<24, 1>(reportTestCases, 10000), "posit<24,1>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodeEncode<40, 2>(reportTestCases, 10000), "posit<40,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodeEncode<48, 2>(reportTestCases, 10000), "posit<48,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodeEncode<64, 3>(reportTestCases, 10000), "posit<64,3>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodeEncode<14, 2>(reportTestCases), "posit<14,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodeEncode<20, 1>(reportTestCases, 100000), "posit<20,1>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodeEncode<28, 2>(reportTestCases, 100000), "posit<28,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodeEncode<56, 3>(reportTestCases, 100000), "posit<56,3>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodeEncode<64, 0>(reportTestCases, 100000), "posit<64,0>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodeEncode<16, 5>(reportTestCases), "posit<16,5>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodeEncode<40, 2>(reportTestCases, 1000000), "posit<40,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodeEncode<48, 2>(reportTestCases, 1000000), "posit<48,2>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodeEncode<64, 3>(reportTestCases, 1000000), "posit<64,3>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyDecodeEncode<80, 2>(reportTestCases, 100000), "posit<80,2>", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
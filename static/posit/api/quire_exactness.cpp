@@ -0,0 +1,183 @@
+// quire_exactness.cpp: verify quire accumulation against an exact two's complement fixed-point reference
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <random>
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 1
+#include <universal/number/posit/posit.hpp>
+#include <universal/internal/blockbinary/blockbinary.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// place the significand of v at its scale in a fixed-point accumulator with the radix point of the quire
+	template<typename Quire, typename Reference, unsigned fbits>
+	Reference ReferenceFixedPoint(const internal::value<fbits>& v) {
+		Reference r(0);
+		if (v.iszero()) return r;
+		internal::bitblock<fbits + 1> fixed = v.get_fixed_point();
+		int lsb = int(Quire::radix_point) + v.scale() - int(fbits);
+		for (int f = 0; f <= int(fbits); ++f) {
+			// bits below the lsb of the quire are truncated
+			if (lsb + f >= 0 && fixed.test(unsigned(f))) r.setbit(unsigned(lsb + f));
+		}
+		return (v.sign() ? -r : r);
+	}
+
+	// compare sign and magnitude bits of the quire with the two's complement reference
+	template<typename Quire, typename Reference>
+	bool SameAccumulation(const Quire& q, const Reference& reference) {
+		Reference magnitude = reference.isneg() ? -reference : reference;
+		if (!reference.iszero() && q.sign() != reference.isneg()) return false;
+		for (int i = 0; i <= int(Quire::qbits); ++i) {
+			if (q[i] != magnitude.test(unsigned(i))) return false;
+		}
+		return true;
+	}
+
+	// accumulate random products, mixing in quire additions and subtractions,
+	// so that carries and borrows cross limb boundaries and the sign flips repeatedly
+	template<unsigned nbits, unsigned es, unsigned capacity>
+	int VerifyQuireAccumulation(unsigned nrOfRuns, unsigned nrOfTerms, bool reportTestCases) {
+		using Posit = posit<nbits, es>;
+		using Quire = quire<nbits, es, capacity>;
+		using Reference = blockbinary<Quire::qbits + 2, uint64_t>;
+		std::mt19937_64 generator(nbits * 7 + es);
+		int nrOfFailedTests = 0;
+		for (unsigned run = 0; run < nrOfRuns; ++run) {
+			Quire q, partial;
+			Reference reference(0), partialReference(0);
+			for (unsigned t = 0; t < nrOfTerms; ++t) {
+				Posit a, b;
+				a.setbits(generator());
+				b.setbits(generator());
+				if (a.isnar() || b.isnar()) continue;
+				auto product = quire_mul(a, b);
+				Reference term = ReferenceFixedPoint<Quire, Reference>(product);
+				switch (generator() % 4) {
+				case 0:
+				case 1:
+					q += product;
+					reference += term;
+					break;
+				case 2:
+					q -= product;
+					reference -= term;
+					break;
+				case 3:
+					partial += product;
+					partialReference += term;
+					if (generator() & 0x1) {
+						q += partial;
+						reference += partialReference;
+					}
+					else {
+						q -= partial;
+						reference -= partialReference;
+					}
+					break;
+				}
+				if (!SameAccumulation(q, reference)) {
+					++nrOfFailedTests;
+					if (reportTestCases) std::cerr << "FAIL: " << q << " after adding " << to_triple(product) << '\n';
+					break;
+				}
+				// the magnitude comparison is used to decide the direction of the subtraction
+				int cmp = q.CompareMagnitude(product);
+				Reference magnitude = reference.isneg() ? -reference : reference;
+				Reference termMagnitude = term.isneg() ? -term : term;
+				int refcmp = (magnitude < termMagnitude) ? -1 : (termMagnitude < magnitude ? 1 : 0);
+				if (cmp != refcmp) {
+					++nrOfFailedTests;
+					if (reportTestCases) std::cerr << "FAIL: magnitude comparison of " << q << " and " << to_triple(product) << '\n';
+					break;
+				}
+			}
+			// round trip through a normalized value
+			Quire roundtrip(q.to_value());
+			if (!q.iszero() && (roundtrip != q || roundtrip.scale() != q.scale())) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: round trip " << q << " != " << roundtrip << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "quire exact accumulation";
+	std::string test_tag    = "quire";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyQuireAccumulation<8, 0, 2>(10, 100, reportTestCases), "quire<8,0,2>", test_tag);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyQuireAccumulation< 8, 0,  2>(20, 200, reportTestCases), "quire< 8,0, 2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyQuireAccumulation< 8, 2,  5>(20, 200, reportTestCases), "quire< 8,2, 5>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyQuireAccumulation<16, 1, 30>(20, 200, reportTestCases), "quire<16,1,30>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyQuireAccumulation<32, 2, 30>(10, 200, reportTestCases), "quire<32,2,30>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyQuireAccumulation<24, 1, 10>(20, 500, reportTestCases), "quire<24,1,10>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyQuireAccumulation<64, 3, 30>(5, 200, reportTestCases), "quire<64,3,30>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyQuireAccumulation<32, 2, 30>(100, 1000, reportTestCases), "quire<32,2,30>", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::quire_exception& err) {
+	std::cerr << "Uncaught quire exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,234 @@
+// native_arithmetic.cpp: test suite runner for the native integer arithmetic of posits with nbits <= 32
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <iostream>
+#include <iomanip>
+#include <random>
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+// the operators of this test suite use the bitblock path, which is the reference for the native kernels
+#include <universal/number/posit/posit.hpp>
+#include <universal/verification/test_status.hpp>
+#include <universal/verification/test_reporters.hpp>
+
+namespace sw { namespace universal {
+
+	// compare one native kernel result with the bitblock path
+	template<typename Posit, typename Kernel>
+	int VerifyNativeCase(bool reportTestCases, const char* op, const Posit& a, const Posit& b, const Posit& reference, Kernel kernel) {
+		Posit result{};
+		kernel(a, b, result);
+		if (result == reference) return 0;
+		if (reportTestCases) {
+			std::cerr << "FAIL " << to_binary(a) << ' ' << op << ' ' << to_binary(b) << " = " << to_binary(result) << " : " << result
+				<< " != " << to_binary(reference) << " : " << reference << '\n';
+		}
+		return 1;
+	}
+
+	template<typename Posit>
+	int VerifyNativeOperands(bool reportTestCases, const Posit& a, const Posit& b) {
+		if (a.iszero() || a.isnar() || b.iszero() || b.isnar()) return 0;
+		int nrOfFailedTests = 0;
+		nrOfFailedTests += VerifyNativeCase(reportTestCases, "+", a, b, a + b, [](const Posit& x, const Posit& y, Posit& z) { posit_native_add(x, y, z); });
+		nrOfFailedTests += VerifyNativeCase(reportTestCases, "-", a, b, a - b, [](const Posit& x, const Posit& y, Posit& z) { posit_native_add(x, -y, z); });
+		nrOfFailedTests += VerifyNativeCase(reportTestCases, "*", a, b, a * b, [](const Posit& x, const Posit& y, Posit& z) { posit_native_mul(x, y, z); });
+		nrOfFailedTests += VerifyNativeCase(reportTestCases, "/", a, b, a / b, [](const Posit& x, const Posit& y, Posit& z) { posit_native_div(x, y, z); });
+		return nrOfFailedTests;
+	}
+
+	// enumerate all operand pairs of a small posit
+	template<unsigned nbits, unsigned es>
+	int VerifyNativeArithmetic(bool reportTestCases) {
+		using Posit = posit<nbits, es>;
+		constexpr uint64_t NR_VALUES = (uint64_t(1) << nbits);
+		int nrOfFailedTests = 0;
+		Posit a, b;
+		for (uint64_t i = 0; i < NR_VALUES; ++i) {
+			a.setbits(i);
+			for (uint64_t j = 0; j < NR_VALUES; ++j) {
+				b.setbits(j);
+				nrOfFailedTests += VerifyNativeOperands(reportTestCases, a, b);
+				if (nrOfFailedTests > 24) return nrOfFailedTests;
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// enumerate all operand pairs of a posit with nbits <= 16 against the rounded double results:
+	// the sum, product, and quotient of two such posits are exact in double, or inexact by too
+	// little to move the result onto a rounding tie of the posit
+	template<unsigned nbits, unsigned es>
+	int VerifyNativeArithmeticAgainstDouble(bool reportTestCases) {
+		static_assert(nbits <= 16, "double is not a correctly rounded reference beyond 16 bits");
+		using Posit = posit<nbits, es>;
+		constexpr uint64_t NR_VALUES = (uint64_t(1) << nbits);
+		int nrOfFailedTests = 0;
+		Posit a, b;
+		for (uint64_t i = 0; i < NR_VALUES; ++i) {
+			a.setbits(i);
+			if (a.iszero() || a.isnar()) continue;
+			double da = double(a);
+			for (uint64_t j = 0; j < NR_VALUES; ++j) {
+				b.setbits(j);
+				if (b.iszero() || b.isnar()) continue;
+				double db = double(b);
+				nrOfFailedTests += VerifyNativeCase(reportTestCases, "+", a, b, Posit(da + db), [](const Posit& x, const Posit& y, Posit& z) { posit_native_add(x, y, z); });
+				nrOfFailedTests += VerifyNativeCase(reportTestCases, "-", a, b, Posit(da - db), [](const Posit& x, const Posit& y, Posit& z) { posit_native_add(x, -y, z); });
+				nrOfFailedTests += VerifyNativeCase(reportTestCases, "*", a, b, Posit(da * db), [](const Posit& x, const Posit& y, Posit& z) { posit_native_mul(x, y, z); });
+				nrOfFailedTests += VerifyNativeCase(reportTestCases, "/", a, b, Posit(da / db), [](const Posit& x, const Posit& y, Posit& z) { posit_native_div(x, y, z); });
+				if (nrOfFailedTests > 24) return nrOfFailedTests;
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// sample random operand pairs of a large posit
+	template<unsigned nbits, unsigned es>
+	int VerifyNativeArithmeticThroughRandoms(bool reportTestCases, size_t nrOfRandoms) {
+		using Posit = posit<nbits, es>;
+		std::mt19937_64 engine(0x5eed);
+		constexpr uint64_t mask = (1ull << nbits) - 1ull;
+		int nrOfFailedTests = 0;
+		Posit a, b;
+		for (size_t n = 0; n < nrOfRandoms; ++n) {
+			a.setbits(engine() & mask);
+			b.setbits(engine() & mask);
+			nrOfFailedTests += VerifyNativeOperands(reportTestCases, a, b);
+			// operands of similar magnitude exercise cancellation and carries
+			b.setbits((a.bits() ^ (engine() & 0xFFull)) & mask);
+			nrOfFailedTests += VerifyNativeOperands(reportTestCases, a, b);
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+		return nrOfFailedTests;
+	}
+
+	// all exponent sizes of a small posit
+	template<unsigned nbits, unsigned es = 0>
+	int VerifyNativeArithmeticEncodings(bool reportTestCases, const std::string& test_tag) {
+		int nrOfFailedTestCases = 0;
+		std::stringstream s;
+		s << "posit<" << std::setw(2) << nbits << ',' << es << '>';
+		nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic<nbits, es>(reportTestCases), s.str(), test_tag);
+		if constexpr (es < 4 && es + 2 < nbits) {
+			nrOfFailedTestCases += VerifyNativeArithmeticEncodings<nbits, es + 1>(reportTestCases, test_tag);
+		}
+		return nrOfFailedTestCases;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "posit native integer arithmetic validation against the bitblock path";
+	std::string test_tag    = "native arithmetic";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	using Posit = posit<8, 1>;
+	Posit a, b, c;
+	a.setbits(0x13);
+	b.setbits(0x5a);
+	posit_native_div(a, b, c);
+	std::cout << to_binary(a / b) << " : " << (a / b) << '\n';
+	std::cout << to_binary(c) << " : " << c << '\n';
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += VerifyNativeArithmeticEncodings<2>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyNativeArithmeticEncodings<3>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyNativeArithmeticEncodings<4>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyNativeArithmeticEncodings<5>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyNativeArithmeticEncodings<6>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyNativeArithmeticEncodings<7>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyNativeArithmeticEncodings<8>(reportTestCases, test_tag);
+
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms<16, 1>(reportTestCases, 10000), "posit<16,1>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms<24, 2>(reportTestCases, 10000), "posit<24,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms<32, 2>(reportTestCases, 10000), "posit<32,2>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += VerifyNativeArithmeticEncodings<9>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyNativeArithmeticEncodings<10>(reportTestCases, test_tag);
+
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms<20, 1>(reportTestCases, 100000), "posit<20,1>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms<28, 3>(reportTestCases, 100000), "posit<28,3>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms<32, 5>(reportTestCases, 100000), "posit<32,5>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += VerifyNativeArithmeticEncodings<11>(reportTestCases, test_tag);
+	nrOfFailedTestCases += VerifyNativeArithmeticEncodings<12>(reportTestCases, test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	// the bitblock path is too slow to enumerate larger posits
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticAgainstDouble<13, 0>(reportTestCases), "posit<13,0>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticAgainstDouble<13, 1>(reportTestCases), "posit<13,1>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticAgainstDouble<13, 2>(reportTestCases), "posit<13,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticAgainstDouble<13, 3>(reportTestCases), "posit<13,3>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticAgainstDouble<14, 1>(reportTestCases), "posit<14,1>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticAgainstDouble<14, 2>(reportTestCases), "posit<14,2>", test_tag);
+
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms<15, 1>(reportTestCases, 1000000), "posit<15,1>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms<16, 1>(reportTestCases, 1000000), "posit<16,1>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms<16, 2>(reportTestCases, 1000000), "posit<16,2>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticThroughRandoms<32, 2>(reportTestCases, 1000000), "posit<32,2>", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
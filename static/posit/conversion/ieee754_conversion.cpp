@@ -0,0 +1,250 @@
+// ieee754_conversion.cpp: test suite runner for the direct conversions between IEEE-754 floating-point values, integers, and posits
+//
+// Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <cmath>
+#include <iomanip>
+#include <random>
+#include <vector>
+// Configure the posit template environment
+// first: enable general or specialized posit configurations
+//#define POSIT_FAST_SPECIALIZATION
+// second: enable/disable posit arithmetic exceptions
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/number/posit/posit.hpp>
+#include <universal/verification/test_status.hpp>
+#include <universal/verification/test_reporters.hpp>
+
+namespace sw { namespace universal {
+
+	// the value<> path is the reference for the conversion of a float, double, or integer to a posit
+	template<unsigned nbits, unsigned es, typename Ty>
+	posit<nbits, es> ReferenceConversion(Ty rhs) {
+		constexpr unsigned fbits = (std::numeric_limits<Ty>::is_exact ? 64 : std::numeric_limits<Ty>::digits - 1);
+		internal::value<fbits> v(rhs);
+		posit<nbits, es> p;
+		if (v.iszero()) p.setzero(); else convert(v, p);
+		return p;
+	}
+
+	template<unsigned nbits, unsigned es, typename Ty>
+	int VerifyAssignmentCase(bool reportTestCases, Ty rhs) {
+		posit<nbits, es> p, ref = ReferenceConversion<nbits, es>(rhs);
+		p = rhs;
+		if (p == ref) return 0;
+		if (reportTestCases) std::cerr << "FAIL: " << std::setprecision(17) << rhs << " assigns " << to_binary(p) << " reference " << to_binary(ref) << '\n';
+		return 1;
+	}
+
+	// a posit to float or double conversion must match the rounding of the exact long double value
+	template<unsigned nbits, unsigned es, typename Real>
+	int VerifyRoundingCase(bool reportTestCases, const posit<nbits, es>& p) {
+		Real ref = static_cast<Real>(static_cast<long double>(p));
+		Real result = static_cast<Real>(p);
+		if (result == ref || (std::isnan(result) && std::isnan(ref))) return 0;
+		if (reportTestCases) std::cerr << "FAIL: " << to_binary(p) << " converts to " << std::setprecision(17) << result << " reference " << ref << '\n';
+		return 1;
+	}
+
+	// posit -> float/double -> posit over the posit encodings, which also covers the conversion of the float/double
+	// values halfway between adjacent posits, where round to nearest, ties to even, decides
+	template<unsigned nbits, unsigned es, typename Real>
+	int VerifyIeee754Conversion(bool reportTestCases, uint64_t nrRandoms = 0) {
+		using Posit = posit<nbits, es>;
+		constexpr uint64_t mask = (nbits == 64 ? ~0ull : (1ull << (nbits % 64)) - 1ull);
+		constexpr bool exhaustive = (nbits <= 16);
+		uint64_t nrTestCases = (exhaustive ? (1ull << (nbits % 64)) : nrRandoms);
+		std::mt19937_64 generator(nbits * 16 + es);
+		int nrOfFailedTestCases = 0;
+		for (uint64_t i = 0; i < nrTestCases; ++i) {
+			Posit a, b;
+			a.setbits(exhaustive ? i : (generator() & mask));
+			nrOfFailedTestCases += VerifyRoundingCase<nbits, es, Real>(reportTestCases, a);
+			nrOfFailedTestCases += VerifyAssignmentCase<nbits, es>(reportTestCases, static_cast<Real>(a));
+			b = a; ++b;
+			if (a.isnar() || b.isnar()) continue;
+			Real midpoint = static_cast<Real>((static_cast<long double>(a) + static_cast<long double>(b)) / 2.0l);
+			nrOfFailedTestCases += VerifyAssignmentCase<nbits, es>(reportTestCases, midpoint);
+			nrOfFailedTestCases += VerifyAssignmentCase<nbits, es>(reportTestCases, std::nextafter(midpoint, Real(0)));
+			nrOfFailedTestCases += VerifyAssignmentCase<nbits, es>(reportTestCases, std::nextafter(midpoint, std::numeric_limits<Real>::infinity()));
+			if (nrOfFailedTestCases > 24) return nrOfFailedTestCases;
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// random floats or doubles over the full range of the IEEE-754 encoding, including subnormals, infinities, and NaNs
+	template<unsigned nbits, unsigned es, typename Real>
+	int VerifyIeee754Encodings(bool reportTestCases, uint64_t nrRandoms) {
+		using Word = std::conditional_t<sizeof(Real) == 4, uint32_t, uint64_t>;
+		std::mt19937_64 generator(nbits * 32 + es);
+		int nrOfFailedTestCases = 0;
+		const Real special[] = { Real(0), -Real(0), std::numeric_limits<Real>::denorm_min(), -std::numeric_limits<Real>::denorm_min(),
+			std::numeric_limits<Real>::min(), std::numeric_limits<Real>::max(), -std::numeric_limits<Real>::max(),
+			std::numeric_limits<Real>::infinity(), -std::numeric_limits<Real>::infinity(), std::numeric_limits<Real>::quiet_NaN() };
+		for (Real v : special) nrOfFailedTestCases += VerifyAssignmentCase<nbits, es>(reportTestCases, v);
+		for (uint64_t i = 0; i < nrRandoms; ++i) {
+			Real v = std::bit_cast<Real>(static_cast<Word>(generator()));
+			nrOfFailedTestCases += VerifyAssignmentCase<nbits, es>(reportTestCases, v);
+			if (nrOfFailedTestCases > 24) return nrOfFailedTestCases;
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// integers of all magnitudes, and the extremes of the native integer types
+	template<unsigned nbits, unsigned es>
+	int VerifyIntegerAssignment(bool reportTestCases, uint64_t nrRandoms) {
+		std::mt19937_64 generator(nbits * 64 + es);
+		int nrOfFailedTestCases = 0;
+		nrOfFailedTestCases += VerifyAssignmentCase<nbits, es>(reportTestCases, std::numeric_limits<long long>::min());
+		nrOfFailedTestCases += VerifyAssignmentCase<nbits, es>(reportTestCases, std::numeric_limits<long long>::max());
+		nrOfFailedTestCases += VerifyAssignmentCase<nbits, es>(reportTestCases, std::numeric_limits<unsigned long long>::max());
+		nrOfFailedTestCases += VerifyAssignmentCase<nbits, es>(reportTestCases, std::numeric_limits<int>::min());
+		nrOfFailedTestCases += VerifyAssignmentCase<nbits, es>(reportTestCases, std::numeric_limits<short>::min());
+		nrOfFailedTestCases += VerifyAssignmentCase<nbits, es>(reportTestCases, std::numeric_limits<signed char>::min());
+		for (int i = -1024; i <= 1024; ++i) nrOfFailedTestCases += VerifyAssignmentCase<nbits, es>(reportTestCases, i);
+		for (uint64_t i = 0; i < nrRandoms; ++i) {
+			uint64_t bits = generator() >> (generator() % 64);
+			nrOfFailedTestCases += VerifyAssignmentCase<nbits, es>(reportTestCases, static_cast<long long>(bits));
+			nrOfFailedTestCases += VerifyAssignmentCase<nbits, es>(reportTestCases, -static_cast<long long>(bits >> 1));
+			nrOfFailedTestCases += VerifyAssignmentCase<nbits, es>(reportTestCases, static_cast<unsigned long long>(bits));
+			nrOfFailedTestCases += VerifyAssignmentCase<nbits, es>(reportTestCases, static_cast<unsigned>(bits));
+			nrOfFailedTestCases += VerifyAssignmentCase<nbits, es>(reportTestCases, static_cast<short>(bits));
+			if (nrOfFailedTestCases > 24) return nrOfFailedTestCases;
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// the batched conversions must agree with the element-wise conversions
+	template<unsigned nbits, unsigned es, typename Real>
+	int VerifyArrayConversion(bool reportTestCases, std::size_t n) {
+		using Posit = posit<nbits, es>;
+		std::mt19937_64 generator(nbits);
+		std::lognormal_distribution<Real> distribution(Real(0), Real(4));
+		std::vector<Real> data(n), roundtrip;
+		for (auto& v : data) v = ((generator() & 1u) ? -distribution(generator) : distribution(generator));
+		std::vector<Posit> positData;
+		convert(data, positData);
+		convert(positData, roundtrip);
+		int nrOfFailedTestCases = 0;
+		for (std::size_t i = 0; i < n; ++i) {
+			Posit p(data[i]);
+			if (positData[i] != p || roundtrip[i] != Real(p)) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: batched conversion of " << data[i] << " yields " << positData[i] << " and " << roundtrip[i] << " instead of " << p << '\n';
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "posit IEEE-754 and integer conversion validation";
+	std::string test_tag    = "conversion";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += VerifyAssignmentCase<16, 1>(reportTestCases, 1.0e-30);
+	nrOfFailedTestCases += VerifyRoundingCase<64, 3, double>(reportTestCases, posit<64, 3>(1.0 / 3.0));
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Conversion< 2, 0, double>(reportTestCases), "posit< 2,0> double", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Conversion< 5, 3, float >(reportTestCases), "posit< 5,3> float", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Conversion< 8, 0, float >(reportTestCases), "posit< 8,0> float", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Conversion< 8, 2, double>(reportTestCases), "posit< 8,2> double", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Conversion<12, 1, double>(reportTestCases), "posit<12,1> double", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Conversion<16, 1, float >(reportTestCases), "posit<16,1> float", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Conversion<16, 2, double>(reportTestCases), "posit<16,2> double", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Conversion<32, 2, float >(reportTestCases, 10000), "posit<32,2> float", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Conversion<32, 2, double>(reportTestCases, 10000), "posit<32,2> double", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Conversion<64, 3, double>(reportTestCases, 10000), "posit<64,3> double", test_tag);
+
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Encodings< 8, 0, float >(reportTestCases, 10000), "posit< 8,0> float", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Encodings<16, 1, double>(reportTestCases, 10000), "posit<16,1> double", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Encodings<32, 2, float >(reportTestCases, 10000), "posit<32,2> float", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Encodings<32, 2, double>(reportTestCases, 10000), "posit<32,2> double", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Encodings<64, 3, double>(reportTestCases, 10000), "posit<64,3> double", test_tag);
+
+	nrOfFailedTestCases += ReportTestResult(VerifyIntegerAssignment< 8, 0>(reportTestCases, 1000), "posit< 8,0> integer", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIntegerAssignment<16, 1>(reportTestCases, 1000), "posit<16,1> integer", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIntegerAssignment<32, 2>(reportTestCases, 1000), "posit<32,2> integer", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIntegerAssignment<64, 3>(reportTestCases, 1000), "posit<64,3> integer", test_tag);
+
+	nrOfFailedTestCases += ReportTestResult(VerifyArrayConversion< 8, 0, float >(reportTestCases, 1000), "posit< 8,0> array", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyArrayConversion<16, 1, float >(reportTestCases, 1000), "posit<16,1> array", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyArrayConversion<32, 2, double>(reportTestCases, 1000), "posit<32,2> array", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyArrayConversion<80, 2, double>(reportTestCases, 100), "posit<80,2> array", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Conversion<24, 1, float >(reportTestCases, 100000), "posit<24,1> float", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Conversion<40, 2, double>(reportTestCases, 100000), "posit<40,2> double", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Conversion<56, 3, double>(reportTestCases, 100000), "posit<56,3> double", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Conversion<64, 5, double>(reportTestCases, 100000), "posit<64,5> double", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Encodings<64, 5, double>(reportTestCases, 100000), "posit<64,5> double", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Encodings<16, 1, float >(reportTestCases, 1000000), "posit<16,1> float", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Encodings<32, 2, double>(reportTestCases, 1000000), "posit<32,2> double", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIntegerAssignment<48, 2>(reportTestCases, 100000), "posit<48,2> integer", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Conversion<32, 2, double>(reportTestCases, 1000000), "posit<32,2> double", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyIeee754Conversion<64, 3, double>(reportTestCases, 1000000), "posit<64,3> double", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::posit_arithmetic_exception& err) {
+	std::cerr << "Uncaught posit arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::posit_internal_exception& err) {
+	std::cerr << "Uncaught posit internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -35,6 +35,7 @@ namespace sw { namespace universal {
 		posit<nbits, es> p;
 		for (size_t i = 0; i < NR_VALUES; ++i) {
 			p.setbits(i);
+			if (p.isnar()) continue;  // NaR has no integer value, and the conversion of NaN to long is undefined
 			long l1 = long(sw::universal::floor(p));
 			// generate the reference
 			float f = float(p);
@@ -58,6 +59,7 @@ namespace sw { namespace universal {
 		posit<nbits, es> p;
 		for (size_t i = 0; i < NR_VALUES; ++i) {
 			p.setbits(i);
+			if (p.isnar()) continue;  // NaR has no integer value, and the conversion of NaN to long is undefined
 			long l1 = long(sw::universal::ceil(p));
 			// generate the reference
 			float f = float(p);
@@ -81,6 +83,7 @@ namespace sw { namespace universal {
 		posit<nbits, es> p;
 		for (size_t i = 0; i < NR_VALUES; ++i) {
 			p.setbits(i);
+			if (p.isnar()) continue;  // NaR has no integer value, and the conversion of NaN to long is undefined
 			long l1 = long(sw::universal::trunc(p));
 			// generate the reference
 			float f = float(p);
@@ -104,6 +107,7 @@ namespace sw { namespace universal {
 		posit<nbits, es> p;
 		for (size_t i = 0; i < NR_VALUES; ++i) {
 			p.setbits(i);
+			if (p.isnar()) continue;  // NaR has no integer value, and the conversion of NaN to long is undefined
 			long l1 = long(sw::universal::round(p));
 			// generate the reference
 			float f = float(p);